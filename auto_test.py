@@ -16,6 +16,7 @@ WORKLOAD_TYPE = [
     # 'ReadMostly',
     # 'WriteIntensive',
     # 'WriteMostly',
+    # 'VariableLength',
     # 'TPCC',
     'TPCC_Light'
 ]
@@ -38,13 +39,16 @@ CONCURRENT_CONTROL_TYPE = [
 
 TRANSACTION_MANAGER_TYPE = [
     'StdTransactionManager',
-    # 'PreloadStdTransactionManager'
+    # 'PreloadStdTransactionManager',
+    # 'RouteStdTransactionManager',
+    # 'DeterministicStdTransactionManager',
 ]
 
 STORAGE_MANAGER_TYPE = [
     # 'Random_DRAM',
     # 'Simple_PMEMDATA_DRAMLOG',
     'Simple_PMEMDATA_PMEMLOG',
+    # 'Tiered_PMEMDATA_PMEMLOG',
 ]
 
 THREAD_BIND_TYPE = [
@@ -61,7 +65,8 @@ THREAD_AMOUNT = [
 PWB_TYPE = [
     'CLWB',
     # 'CLFLUSH',
-    # 'CLFLUSHOPT'
+    # 'CLFLUSHOPT',
+    # 'EMULATE'
 ]
 
 exe_status_table = pd.DataFrame(columns=['Workload', 'Index',
@@ -6,54 +6,220 @@
 #pragma once
 
 #include <atomic>
+#include <array>
+#include <algorithm>
 
-#include <util/latency_counter.h>
+#include <util/latency_histogram.h>
+#include <util/tsc_clock.h>
+#include <memory/persist_counter.h>
+#include <listener/papi_counter.h>
+#include <util/event_tracer.h>
 
 namespace cc {
 
-	constexpr uint32_t RECORD_GRANULARITY = 8;
+	/// Time 1 in N transactions, so that always-on recording stays cheap
+	constexpr uint32_t RECORD_SAMPLE_RATE = 16;
+
+	/// The maximal number of transaction types recorded separately, larger tags share the last one
+	constexpr uint32_t MAX_TRANSACTION_TYPE_NUM = 8;
 
 	enum class RecordEvent : uint32_t {
-		running      = 0,
-		commit       = 1,
-		index        = 2,
-		validate     = 3,
-		persist_log  = 4,
-		persist_data = 5,
-		total        = 6
+		running        = 0,
+		commit         = 1,
+		index          = 2,
+		validate       = 3,
+		persist_log    = 4,
+		persist_data   = 5,
+		total          = 6,
+		early_validate = 7
 	};
 	constexpr bool GlobalRecordSwitch[] = {
-			[(uint32_t)RecordEvent::running]      = true,
-			[(uint32_t)RecordEvent::commit]       = true,
-			[(uint32_t)RecordEvent::index]        = true,
-			[(uint32_t)RecordEvent::validate]     = true,
-			[(uint32_t)RecordEvent::persist_log]  = true,
-			[(uint32_t)RecordEvent::persist_data] = true,
-			[(uint32_t)RecordEvent::total]        = true
+			[(uint32_t)RecordEvent::running]        = true,
+			[(uint32_t)RecordEvent::commit]         = true,
+			[(uint32_t)RecordEvent::index]          = true,
+			[(uint32_t)RecordEvent::validate]       = true,
+			[(uint32_t)RecordEvent::persist_log]    = true,
+			[(uint32_t)RecordEvent::persist_data]   = true,
+			[(uint32_t)RecordEvent::total]          = true,
+			[(uint32_t)RecordEvent::early_validate] = true
+	};
+	constexpr const char *RecordEventName[] = {
+			[(uint32_t)RecordEvent::running]        = "running",
+			[(uint32_t)RecordEvent::commit]         = "commit",
+			[(uint32_t)RecordEvent::index]          = "index",
+			[(uint32_t)RecordEvent::validate]       = "validate",
+			[(uint32_t)RecordEvent::persist_log]    = "persist_log",
+			[(uint32_t)RecordEvent::persist_data]   = "persist_data",
+			[(uint32_t)RecordEvent::total]          = "total",
+			[(uint32_t)RecordEvent::early_validate] = "early_validate"
+	};
+	constexpr uint32_t RECORD_EVENT_NUM = std::size(GlobalRecordSwitch);
+	static_assert(RECORD_EVENT_NUM < PersistCounter::NO_PHASE);
+	static_assert(RECORD_EVENT_NUM < util::listener::PAPICounter::NO_PHASE);
+
+	//! @brief Reason of abortion, recorded by concurrent controls where they decide to abort.
+	enum class AbortReason : uint32_t {
+		/// Not classified by the concurrent control
+		Unknown          = 0,
+		/// Timestamp of a tuple changed since it was accessed
+		TimestampChanged = 1,
+		/// A tuple accessed is locked by another transaction
+		Locked           = 2,
+		/// Failed to acquire a lock within the retry limit
+		LockRetryLimit   = 3,
+		/// Validation ahead of commit in running phase failed
+		EarlyValidate    = 4,
+		/// Read, update or remove a key not existing
+		KeyNotFound      = 5,
+		/// Insert a key existing
+		KeyExists        = 6,
+		/// No space for log of the transaction
+		LogSpace         = 7,
+		/// Transaction logic gave up for other reasons
+		Execution        = 8,
+		/// Accessed a tuple out of the access set scheduled in advance
+		AccessSetChanged = 9
+	};
+	constexpr const char *AbortReasonName[] = {
+			[(uint32_t)AbortReason::Unknown]          = "unknown",
+			[(uint32_t)AbortReason::TimestampChanged] = "timestamp_changed",
+			[(uint32_t)AbortReason::Locked]           = "locked",
+			[(uint32_t)AbortReason::LockRetryLimit]   = "lock_retry_limit",
+			[(uint32_t)AbortReason::EarlyValidate]    = "early_validate",
+			[(uint32_t)AbortReason::KeyNotFound]      = "key_not_found",
+			[(uint32_t)AbortReason::KeyExists]        = "key_exists",
+			[(uint32_t)AbortReason::LogSpace]         = "log_space",
+			[(uint32_t)AbortReason::Execution]        = "execution",
+			[(uint32_t)AbortReason::AccessSetChanged] = "access_set_changed"
 	};
+	constexpr uint32_t ABORT_REASON_NUM = std::size(AbortReasonName);
+
+	/// Whether phases are tracked for counters attributed to them, or for events traced
+	constexpr bool ENABLE_PHASE_COUNTER = ENABLE_PERSIST_COUNTER || util::listener::ENABLE_PAPI_COUNTER || util::ENABLE_EVENT_TRACE;
 
 
 	//! @brief Message recorder for every transaction
 	//! Once a transaction ends, this struct need to be combined with thread-local
 	//! message recorder (ConcurrentControlMessage).
+	//! Durations are kept in TSC cycles, and only sampled transactions are timed.
+	//! Persistence instructions and hardware events(of sampled ones only) are attributed to
+	//! the innermost phase started but not ended.
+	//! If event tracing is enabled, every phase is traced regardless of sampling.
 	struct ConcurrentControlPortableMessage {
+	private:
+		/// Whether this transaction is timed
+		bool sampled_;
+		/// The number of phases started but not ended
+		uint32_t open_phase_num_;
+		/// Phases started but not ended, the innermost at the end
+		std::array<RecordEvent, RECORD_EVENT_NUM> open_phase_;
+		/// Start time(cycle) of each phase
+		std::array<uint64_t, RECORD_EVENT_NUM> start_time_;
+
+	public:
+		ConcurrentControlPortableMessage(): sampled_(next_sampled()), open_phase_num_(0), start_time_{} {}
+
+		bool is_sampled() const {
+			return sampled_;
+		}
+
+		//! @brief Trace phases left open by abortion, as if they ended now.
+		void trace_open_phase() const {
+			if constexpr (util::ENABLE_EVENT_TRACE) {
+				const uint64_t end_time = util::EventTracer::now();
+				for (uint32_t i = 0; i < open_phase_num_; ++i) {
+					const auto phase = static_cast<uint32_t>(open_phase_[i]);
+					util::EventTracer::record(RecordEventName[phase], start_time_[phase], end_time);
+				}
+			}
+		}
+
+		//! @brief Close phases left open by an aborted attempt, before the next attempt restarts them.
+		void abort_open_phase() {
+			if constexpr (ENABLE_PHASE_COUNTER) {
+				trace_open_phase();
+				open_phase_num_ = 0;
+				switch_phase(PersistCounter::NO_PHASE);
+			}
+		}
+
+		//! @brief Whether the transaction latest started by this thread is timed,
+		//! so that other recorders can time the same transactions.
+		static bool is_thread_sampled() {
+			return thread_sampled();
+		}
+
+	private:
+		static bool &thread_sampled() {
+			static thread_local bool sampled = false;
+			return sampled;
+		}
+
+		static bool next_sampled() {
+			if constexpr (RECORD_SAMPLE_RATE <= 1) {
+				return thread_sampled() = true;
+			}
+			else {
+				static thread_local uint32_t counter = 0;
+				if (++counter < RECORD_SAMPLE_RATE) { return thread_sampled() = false; }
+				counter = 0;
+				return thread_sampled() = true;
+			}
+		}
+
+		void enter_phase(RecordEvent event) {
+			if constexpr (ENABLE_PHASE_COUNTER) {
+				auto end_iter = std::remove(open_phase_.begin(), open_phase_.begin() + open_phase_num_, event);
+				open_phase_num_ = end_iter - open_phase_.begin();
+				open_phase_[open_phase_num_++] = event;
+				switch_phase(static_cast<uint32_t>(event));
+			}
+		}
+
+		void leave_phase(RecordEvent event) {
+			if constexpr (ENABLE_PHASE_COUNTER) {
+				auto end_iter = std::remove(open_phase_.begin(), open_phase_.begin() + open_phase_num_, event);
+				open_phase_num_ = end_iter - open_phase_.begin();
+				switch_phase(open_phase_num_ == 0 ? PersistCounter::NO_PHASE : static_cast<uint32_t>(open_phase_[open_phase_num_ - 1]));
+			}
+		}
+
+		void switch_phase(uint32_t phase) {
+			if constexpr (ENABLE_PERSIST_COUNTER) {
+				PersistCounter::set_phase(phase);
+			}
+			if constexpr (util::listener::ENABLE_PAPI_COUNTER) {
+				// Reading hardware counters is not cheap, so only sampled transactions are counted.
+				if (sampled_) {
+					util::listener::PAPICounter::set_phase(phase < RECORD_EVENT_NUM ? phase : util::listener::PAPICounter::NO_PHASE);
+				}
+			}
+		}
 
 		#define MESSAGE_RECORDER(message_type) \
 		private: \
-			std::chrono::time_point<std::chrono::steady_clock> message_type##_time; \
-            std::chrono::nanoseconds message_type##_duration{0}; \
+            uint64_t message_type##_duration{0}; \
 		public: \
 			void start_##message_type() { \
-                if constexpr(GlobalRecordSwitch[static_cast<uint32_t>(RecordEvent::message_type)]) { \
-					message_type##_time = std::chrono::steady_clock::now(); \
+                if constexpr(GlobalRecordSwitch[static_cast<uint32_t>(RecordEvent::message_type)] || util::ENABLE_EVENT_TRACE) { \
+					if (sampled_ || util::ENABLE_EVENT_TRACE) { \
+						start_time_[static_cast<uint32_t>(RecordEvent::message_type)] = util::TSCClock::now(); \
+					} \
 				} \
+				enter_phase(RecordEvent::message_type); \
             } \
 			void end_##message_type() { \
-				if constexpr(GlobalRecordSwitch[static_cast<uint32_t>(RecordEvent::message_type)]) { \
-					message_type##_duration += std::chrono::steady_clock::now() - message_type##_time; \
+				if constexpr(GlobalRecordSwitch[static_cast<uint32_t>(RecordEvent::message_type)] || util::ENABLE_EVENT_TRACE) { \
+					const uint64_t start_time = start_time_[static_cast<uint32_t>(RecordEvent::message_type)]; \
+					const uint64_t end_time   = (sampled_ || util::ENABLE_EVENT_TRACE) ? util::TSCClock::now() : 0; \
+					if (GlobalRecordSwitch[static_cast<uint32_t>(RecordEvent::message_type)] && sampled_) { \
+						message_type##_duration += end_time - start_time; \
+					} \
+					util::EventTracer::record(#message_type, start_time, end_time); \
                 } \
+				leave_phase(RecordEvent::message_type); \
 			} \
-			auto get_##message_type##_duration() const { \
+			uint64_t get_##message_type##_duration() const { \
 				return message_type##_duration;\
 			}
 
@@ -71,29 +237,39 @@ namespace cc {
 
 		MESSAGE_RECORDER(total)
 
+		MESSAGE_RECORDER(early_validate)
+
 		#undef MESSAGE_RECORDER
 	};
 
 	//! @brief Global message recorder.
 	//! Each thread keep a recorder. All message about transaction need to be combined once it ends,
 	//! which is optimised as thread local to accelerate procession.
+	//! Latency is recorded in TSC cycles and converted into nanoseconds on query,
+	//! while time summaries are scaled by the sample rate.
 	//! Once the thread ends, this struct will be released,
 	//! and relative information will be combined with global message recorder, which
 	//! need locks to make sure consistence.
 	struct ConcurrentControlMessage {
 		#define LATENCY_RECORDER(message_type) \
 			private:                              \
-				util::LatencyCounter<RECORD_GRANULARITY> message_type##_latency; \
+				util::LatencyHistogram<> message_type##_latency; \
 			public: \
-				uint64_t get_total_##message_type##_latency(uint32_t alpha) {    \
+				uint64_t get_total_##message_type##_latency(double percentile) { \
 					if constexpr(GlobalRecordSwitch[static_cast<uint32_t>(RecordEvent::message_type)]) { \
-                        return message_type##_latency.get_latency_summary(alpha);         \
+                        return util::TSCClock::to_ns(message_type##_latency.get_latency_summary(percentile)); \
+                    }                    \
+                    return 0;            \
+				}                        \
+				uint64_t get_max_##message_type##_latency() { \
+					if constexpr(GlobalRecordSwitch[static_cast<uint32_t>(RecordEvent::message_type)]) { \
+                        return util::TSCClock::to_ns(message_type##_latency.get_max()); \
                     }                    \
                     return 0;            \
 				}                        \
 				uint64_t get_total_##message_type##_time() {                     \
                     if constexpr(GlobalRecordSwitch[static_cast<uint32_t>(RecordEvent::message_type)]) { \
-						return message_type##_latency.get_time_summary();              \
+						return util::TSCClock::to_ns(message_type##_latency.get_time_summary()) * RECORD_SAMPLE_RATE; \
                     }                    \
 					return 0; \
 				}
@@ -112,6 +288,8 @@ namespace cc {
 
 		LATENCY_RECORDER(total)
 
+		LATENCY_RECORDER(early_validate)
+
 		#undef LATENCY_RECORDER
 
 	public:
@@ -122,9 +300,55 @@ namespace cc {
 		uint64_t abort_tx;
 		/// The number of transaction in total.
 		uint64_t total_tx;
+		/// The number of retries after abort.
+		uint64_t retry_tx;
+		/// The number of transactions deferred behind fresh ones.
+		uint64_t defer_tx;
+		/// The number of deferred transactions left unfinished when workers stop.
+		uint64_t unfinished_defer_tx;
+		/// Time spent on aborted attempts(ns).
+		uint64_t wasted_time;
+		/// Time spent on backoff before retry(ns).
+		uint64_t backoff_time;
+		/// The number of transactions aborted by validation in running phase.
+		uint64_t early_abort_tx;
+		/// Bytes of log written.
+		uint64_t log_size;
+		/// Bytes of log if updates were logged without delta encoding.
+		uint64_t raw_log_size;
+
+	private:
+		/// Type tag of the transaction being executed.
+		uint32_t tx_type_;
+		/// The number of transaction in total of each type.
+		std::array<uint64_t, MAX_TRANSACTION_TYPE_NUM> type_total_tx_;
+		/// The number of transaction aborted of each type.
+		std::array<uint64_t, MAX_TRANSACTION_TYPE_NUM> type_abort_tx_;
+		/// Latency of committed transactions of each type.
+		std::array<util::LatencyHistogram<>, MAX_TRANSACTION_TYPE_NUM> type_latency_;
+		/// Latency from intended start to commit in open-loop mode.
+		util::LatencyHistogram<> response_latency_;
+		/// Reason of abortion recorded during the current attempt.
+		AbortReason abort_reason_;
+		/// Reason of the latest abortion, to which the wasted time of the attempt is attributed.
+		AbortReason last_abort_reason_;
+		/// The number of transaction aborted of each reason.
+		std::array<uint64_t, ABORT_REASON_NUM> reason_abort_tx_;
+		/// Time(ns) spent on aborted attempts of each reason.
+		std::array<util::LatencyHistogram<>, ABORT_REASON_NUM> reason_wasted_time_;
+		/// Persistence instructions of each phase, collected from thread-local counters.
+		PersistCounter::Counter persist_counter_;
+		/// Hardware events of each phase during sampled transactions, collected from thread-local counters.
+		util::listener::PAPICounter::Counter papi_counter_;
+		/// Whether this thread runs work which is not a real attempt (e.g. reconnaissance), and records nothing
+		bool muted_;
 
 	public:
-		ConcurrentControlMessage(): abort_tx{0}, total_tx{0} { }
+		ConcurrentControlMessage(): abort_tx{0}, total_tx{0},
+			retry_tx{0}, defer_tx{0}, unfinished_defer_tx{0}, wasted_time{0}, backoff_time{0}, early_abort_tx{0},
+			log_size{0}, raw_log_size{0}, tx_type_{0}, type_total_tx_{}, type_abort_tx_{},
+			abort_reason_{AbortReason::Unknown}, last_abort_reason_{AbortReason::Unknown}, reason_abort_tx_{},
+			persist_counter_{}, papi_counter_{}, muted_{false} { }
 
 		//! @brief Once be released, accumulate data and combine it with global message recorder.
 		~ConcurrentControlMessage() {
@@ -155,17 +379,171 @@ namespace cc {
 			std::atomic_ref{record}.store(false);
 		}
 
+		//! @brief Whether recording is on.
+		static bool is_recording() {
+			return record;
+		}
+
+		//! @brief Stop recording of this thread for the scope, for work which is not a real attempt.
+		//! It should cover the executor of such work, whose message is submitted on destruction.
+		class MuteScope {
+		private:
+			ConcurrentControlMessage &message_;
+
+		public:
+			explicit MuteScope(ConcurrentControlMessage &message): message_(message) { message_.muted_ = true; }
+
+			~MuteScope() { message_.muted_ = false; }
+
+			MuteScope(const MuteScope &) = delete;
+
+			MuteScope &operator= (const MuteScope &) = delete;
+		};
+
 
 	public:
+		//! @brief Whether recording is on and not muted for this thread.
+		bool is_thread_recording() const {
+			return record && !muted_;
+		}
+
+		//! @brief Set the type tag of transactions executed afterward.
+		void set_transaction_type(uint32_t type_tag) {
+			tx_type_ = std::min(type_tag, MAX_TRANSACTION_TYPE_NUM - 1);
+		}
+
+		uint64_t get_type_total_tx(uint32_t type_tag) const {
+			return type_total_tx_[type_tag];
+		}
+
+		uint64_t get_type_abort_tx(uint32_t type_tag) const {
+			return type_abort_tx_[type_tag];
+		}
+
+		//! @brief Record the reason why the current attempt is going to abort, overwriting former ones.
+		void set_abort_reason(AbortReason reason) {
+			abort_reason_ = reason;
+		}
+
+		//! @brief Record the reason if no one is recorded by the concurrent control.
+		void set_default_abort_reason(AbortReason reason) {
+			if (abort_reason_ == AbortReason::Unknown) { abort_reason_ = reason; }
+		}
+
+		uint64_t get_reason_abort_tx(uint32_t reason) const {
+			return reason_abort_tx_[reason];
+		}
+
+		//! @brief Get wasted time(ns) of an aborted attempt of a reason, including its backoff, by percentile.
+		uint64_t get_reason_wasted_time(uint32_t reason, double percentile) const {
+			return reason_wasted_time_[reason].get_latency_summary(percentile);
+		}
+
+		//! @brief Get total wasted time(ns) of aborted attempts of a reason, including their backoff.
+		uint64_t get_reason_total_wasted_time(uint32_t reason) const {
+			return reason_wasted_time_[reason].get_time_summary();
+		}
+
+		//! @brief Get latency(ns) of committed transactions of a type by percentile.
+		uint64_t get_type_latency(uint32_t type_tag, double percentile) const {
+			return util::TSCClock::to_ns(type_latency_[type_tag].get_latency_summary(percentile));
+		}
+
+		uint64_t get_type_max_latency(uint32_t type_tag) const {
+			return util::TSCClock::to_ns(type_latency_[type_tag].get_max());
+		}
+
+		//! @brief Record latency of a committed transaction from its intended start in open-loop mode.
+		//! @param latency_cycles Latency in TSC cycles
+		void record_response(uint64_t latency_cycles) {
+			if (is_thread_recording()) {
+				response_latency_.add_latency(latency_cycles);
+			}
+		}
+
+		//! @brief Get latency(ns) from intended start by percentile.
+		uint64_t get_response_latency(double percentile) const {
+			return util::TSCClock::to_ns(response_latency_.get_latency_summary(percentile));
+		}
+
+		uint64_t get_max_response_latency() const {
+			return util::TSCClock::to_ns(response_latency_.get_max());
+		}
+
+		//! @brief Get the number of cache lines flushed in a phase.
+		//! @param phase RecordEvent, or PersistCounter::NO_PHASE for instructions out of any phase
+		uint64_t get_persist_flush_line_num(uint32_t phase) const {
+			return persist_counter_.flush_line_num[phase];
+		}
+
+		uint64_t get_persist_fence_num(uint32_t phase) const {
+			return persist_counter_.fence_num[phase];
+		}
+
+		//! @brief Get the number of a hardware event in a phase, scaled by the sample rate.
+		//! @param phase RecordEvent
+		//! @param event Index of event in PAPICounter::EVENT_CODE
+		uint64_t get_papi_event_num(uint32_t phase, uint32_t event) const {
+			return papi_counter_[phase][event] * RECORD_SAMPLE_RATE;
+		}
+
 		void start_transaction() {
-			if (record) {
+			abort_reason_ = AbortReason::Unknown;
+			if (is_thread_recording()) {
 				++total_tx;
+				++type_total_tx_[tx_type_];
 			}
 		}
 
-		void abort_transaction() {
-			if (record) {
+		//! @brief Record an aborted attempt.
+		//! @param message Message of the aborted attempt, whose open phases are closed
+		void abort_transaction(ConcurrentControlPortableMessage &message) {
+			message.abort_open_phase();
+			last_abort_reason_ = abort_reason_;
+			abort_reason_      = AbortReason::Unknown;
+			if (is_thread_recording()) {
 				++abort_tx;
+				++type_abort_tx_[tx_type_];
+				++reason_abort_tx_[static_cast<uint32_t>(last_abort_reason_)];
+			}
+		}
+
+		//! @brief Record the number of deferred transactions waiting in the queue of this thread,
+		//! which are left unfinished if the thread stops now.
+		void set_deferred_transaction_num(uint64_t num) {
+			if (is_thread_recording()) {
+				unfinished_defer_tx = num;
+			}
+		}
+
+		void early_abort_transaction() {
+			if (is_thread_recording()) {
+				++early_abort_tx;
+			}
+		}
+
+		//! @brief Record log written by a committed transaction.
+		//! @param raw_size Size of log without delta encoding
+		//! @param written_size Size of log written actually
+		void record_log(uint64_t raw_size, uint64_t written_size) {
+			if (is_thread_recording()) {
+				raw_log_size += raw_size;
+				log_size     += written_size;
+			}
+		}
+
+		//! @brief Record work wasted by an aborted attempt.
+		//! @param wasted_ns Time spent on the aborted attempt
+		//! @param backoff_ns Time spent on backoff before next attempt
+		//! @param deferred Whether the transaction is deferred instead of retried at once
+		void retry_transaction(uint64_t wasted_ns, uint64_t backoff_ns, bool deferred) {
+			if (is_thread_recording()) {
+				++retry_tx;
+				defer_tx     += deferred;
+				wasted_time  += wasted_ns;
+				backoff_time += backoff_ns;
+				// The backoff is paid because of the abort as well
+				reason_wasted_time_[static_cast<uint32_t>(last_abort_reason_)].add_latency(wasted_ns + backoff_ns);
 			}
 		}
 
@@ -175,10 +553,42 @@ namespace cc {
 		void submit_time(const ConcurrentControlPortableMessage &message) {
 			#define SUBMIT_RECORD(message_type) \
                 if constexpr(GlobalRecordSwitch[static_cast<uint32_t>(RecordEvent::message_type)]) { \
-                    message_type##_latency.add_latency(message.get_##message_type##_duration().count());            \
+                    message_type##_latency.add_latency(message.get_##message_type##_duration()); \
                 }
 
-			if (record) {
+			// Phases abandoned by abortion are never ended by concurrent controls
+			if constexpr (util::ENABLE_EVENT_TRACE) {
+				message.trace_open_phase();
+			}
+			// Collect persistence instructions of this thread since the last submission
+			if constexpr (ENABLE_PERSIST_COUNTER) {
+				if (is_thread_recording()) {
+					const auto &thread_counter = PersistCounter::get_thread_counter();
+					for (uint32_t phase = 0; phase < PersistCounter::MAX_PHASE_NUM; ++phase) {
+						persist_counter_.flush_line_num[phase] += thread_counter.flush_line_num[phase];
+						persist_counter_.fence_num[phase]      += thread_counter.fence_num[phase];
+					}
+				}
+				PersistCounter::clear_thread_counter();
+				PersistCounter::set_phase(PersistCounter::NO_PHASE);
+			}
+			// Collect hardware events of this thread, including those of phases left open by abortion
+			if constexpr (util::listener::ENABLE_PAPI_COUNTER) {
+				if (message.is_sampled()) {
+					util::listener::PAPICounter::set_phase(util::listener::PAPICounter::NO_PHASE);
+				}
+				if (is_thread_recording()) {
+					const auto &thread_counter = util::listener::PAPICounter::get_thread_counter();
+					for (uint32_t phase = 0; phase < util::listener::PAPICounter::MAX_PHASE_NUM; ++phase) {
+						for (uint32_t event = 0; event < util::listener::PAPICounter::EVENT_NUM; ++event) {
+							papi_counter_[phase][event] += thread_counter[phase][event];
+						}
+					}
+				}
+				util::listener::PAPICounter::clear_thread_counter();
+			}
+
+			if (is_thread_recording() && message.is_sampled()) {
 				SUBMIT_RECORD(running)
 				SUBMIT_RECORD(commit)
 				SUBMIT_RECORD(index)
@@ -186,6 +596,11 @@ namespace cc {
 				SUBMIT_RECORD(persist_log)
 				SUBMIT_RECORD(persist_data)
 				SUBMIT_RECORD(total)
+				SUBMIT_RECORD(early_validate)
+				// Aborted attempts never end the total phase
+				if (message.get_total_duration() != 0) {
+					type_latency_[tx_type_].add_latency(message.get_total_duration());
+				}
 			}
 
 			#undef SUBMIT_RECORD
@@ -226,10 +641,38 @@ namespace cc {
 				COMBINE_RECORD(persist_log)
 				COMBINE_RECORD(persist_data)
 				COMBINE_RECORD(total)
+				COMBINE_RECORD(early_validate)
 			}
 
-			total_tx += other.total_tx;
-			abort_tx += other.abort_tx;
+			total_tx     += other.total_tx;
+			abort_tx     += other.abort_tx;
+			retry_tx     += other.retry_tx;
+			defer_tx     += other.defer_tx;
+			unfinished_defer_tx += other.unfinished_defer_tx;
+			wasted_time  += other.wasted_time;
+			backoff_time += other.backoff_time;
+			early_abort_tx += other.early_abort_tx;
+			log_size     += other.log_size;
+			raw_log_size += other.raw_log_size;
+			for (uint32_t type_tag = 0; type_tag < MAX_TRANSACTION_TYPE_NUM; ++type_tag) {
+				type_total_tx_[type_tag] += other.type_total_tx_[type_tag];
+				type_abort_tx_[type_tag] += other.type_abort_tx_[type_tag];
+				type_latency_[type_tag].combine(other.type_latency_[type_tag]);
+			}
+			response_latency_.combine(other.response_latency_);
+			for (uint32_t reason = 0; reason < ABORT_REASON_NUM; ++reason) {
+				reason_abort_tx_[reason] += other.reason_abort_tx_[reason];
+				reason_wasted_time_[reason].combine(other.reason_wasted_time_[reason]);
+			}
+			for (uint32_t phase = 0; phase < PersistCounter::MAX_PHASE_NUM; ++phase) {
+				persist_counter_.flush_line_num[phase] += other.persist_counter_.flush_line_num[phase];
+				persist_counter_.fence_num[phase]      += other.persist_counter_.fence_num[phase];
+			}
+			for (uint32_t phase = 0; phase < util::listener::PAPICounter::MAX_PHASE_NUM; ++phase) {
+				for (uint32_t event = 0; event < util::listener::PAPICounter::EVENT_NUM; ++event) {
+					papi_counter_[phase][event] += other.papi_counter_[phase][event];
+				}
+			}
 			lock_.unlock();
 
 			#undef COMBINE_RECORD
@@ -246,6 +689,19 @@ namespace cc {
 				}
 
 			total_tx = abort_tx = 0;
+			retry_tx = defer_tx = unfinished_defer_tx = 0;
+			wasted_time = backoff_time = 0;
+			early_abort_tx = 0;
+			log_size = raw_log_size = 0;
+			type_total_tx_.fill(0);
+			type_abort_tx_.fill(0);
+			for (auto &latency: type_latency_) { latency.clear(); }
+			response_latency_.clear();
+			reason_abort_tx_.fill(0);
+			for (auto &wasted_time_histogram: reason_wasted_time_) { wasted_time_histogram.clear(); }
+			persist_counter_.flush_line_num.fill(0);
+			persist_counter_.fence_num.fill(0);
+			for (auto &phase_counter: papi_counter_) { phase_counter.fill(0); }
 			CLEAR_RECORD(running)
 			CLEAR_RECORD(commit)
 			CLEAR_RECORD(index)
@@ -253,6 +709,7 @@ namespace cc {
 			CLEAR_RECORD(persist_log)
 			CLEAR_RECORD(persist_data)
 			CLEAR_RECORD(total)
+			CLEAR_RECORD(early_validate)
 
 			#undef CLEAR_RECORD
 		}
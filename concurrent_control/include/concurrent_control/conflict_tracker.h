@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <limits>
+#include <mutex>
+#include <algorithm>
+#include <format>
+
+#include <util/simple_hash.h>
+#include <util/log_table.h>
+#include <concurrent_control/config.h>
+
+namespace cc {
+
+	//! @brief Switch about whether tracking keys incurring validation failure.
+	constexpr bool ENABLE_CONFLICT_TRACKER = true;
+
+	//! @brief Sampled tracker of keys incurring validation failure.
+	//! Each thread keeps a count-min sketch and a small list of the hottest keys.
+	//! Like ConcurrentControlMessage, once the thread ends, the tracker will be combined with the global one.
+	class ConflictTracker {
+	public:
+		/// Rows of count-min sketch
+		static constexpr uint32_t SKETCH_DEPTH    = 4;
+		/// Counters per row, which should be power of 2
+		static constexpr uint32_t SKETCH_WIDTH    = 4096;
+		/// Only one in SAMPLE_INTERVAL conflicts will be recorded into sketch
+		static constexpr uint32_t SAMPLE_INTERVAL = 4;
+		/// The number of hottest keys kept
+		static constexpr uint32_t TOP_K           = 8;
+		/// Sampled conflicts of a key to be regarded as hot
+		static constexpr uint32_t HOT_THRESHOLD   = 8;
+
+		static_assert((SKETCH_WIDTH & (SKETCH_WIDTH - 1)) == 0);
+
+		//! @brief Description of a conflicting key
+		struct ConflictKey {
+			/// Hash of the key, 0 for invalid
+			uint64_t hash     = 0;
+			/// Type(table) of the key
+			uint32_t type     = 0;
+			/// Main key
+			uint64_t main_key = 0;
+			/// Estimated number of sampled conflicts
+			uint32_t count    = 0;
+		};
+
+	private:
+		std::array<std::array<uint32_t, SKETCH_WIDTH>, SKETCH_DEPTH> sketch_;
+
+		std::array<ConflictKey, TOP_K> top_keys_;
+
+		/// The key incurring the latest validation failure
+		ConflictKey last_conflict_;
+
+		uint32_t sample_counter_;
+
+		/// The number of conflicts in total (including those not sampled)
+		uint64_t total_conflict_;
+
+	public:
+		ConflictTracker(): sketch_{}, top_keys_{}, last_conflict_{}, sample_counter_(0), total_conflict_(0) {}
+
+		~ConflictTracker() {
+			if (ConcurrentControlMessage::record) {
+				get_summary_tracker().combine(*this);
+			}
+		}
+
+	public:
+		static ConflictTracker &get_summary_tracker() {
+			static ConflictTracker summary_tracker;
+			return summary_tracker;
+		}
+
+		static ConflictTracker &get_thread_tracker() {
+			static thread_local ConflictTracker thread_tracker;
+			return thread_tracker;
+		}
+
+	public:
+		/*!
+		 * @brief Record a key incurring validation failure.
+		 * @param key Abstract key of the data tuple
+		 */
+		template<class AbKey>
+		void record_conflict(const AbKey &key) {
+			if constexpr (ENABLE_CONFLICT_TRACKER) {
+				last_conflict_ = {
+					.hash     = get_key_hash(key.get_type_ino(), static_cast<uint64_t>(key.get_main_key())),
+					.type     = key.get_type_ino(),
+					.main_key = static_cast<uint64_t>(key.get_main_key()),
+					.count    = 0
+				};
+
+				if (!ConcurrentControlMessage::record) { return; }
+				++total_conflict_;
+				if (++sample_counter_ != SAMPLE_INTERVAL) { return; }
+				sample_counter_ = 0;
+
+				last_conflict_.count = add_to_sketch(last_conflict_.hash);
+				update_top_keys(last_conflict_);
+			}
+		}
+
+		//! @brief Forget the last conflict, which should be called before each attempt.
+		void clear_last_conflict() {
+			last_conflict_.hash = 0;
+		}
+
+		//! @brief Get the key incurring the latest validation failure.
+		const ConflictKey &get_last_conflict() const {
+			return last_conflict_;
+		}
+
+		//! @brief Whether the key incurring the latest validation failure is hot for this thread.
+		bool is_last_conflict_hot() const {
+			return last_conflict_.hash != 0 && estimate(last_conflict_.hash) >= HOT_THRESHOLD;
+		}
+
+		//! @brief Get estimated number of sampled conflicts of a key
+		uint32_t estimate(uint64_t hash) const {
+			uint32_t res = std::numeric_limits<uint32_t>::max();
+			for (uint32_t i = 0; i < SKETCH_DEPTH; ++i) {
+				res = std::min(res, sketch_[i][get_slot(hash, i)]);
+			}
+			return res;
+		}
+
+		uint64_t get_total_conflict() const { return total_conflict_; }
+
+		const std::array<ConflictKey, TOP_K> &get_top_keys() const { return top_keys_; }
+
+	public:
+		//! @brief Combine with another tracker
+		void combine(const ConflictTracker &other) {
+			static std::mutex lock_;
+			std::lock_guard<std::mutex> guard(lock_);
+
+			for (uint32_t i = 0; i < SKETCH_DEPTH; ++i) {
+				for (uint32_t j = 0; j < SKETCH_WIDTH; ++j) {
+					sketch_[i][j] += other.sketch_[i][j];
+				}
+			}
+			total_conflict_ += other.total_conflict_;
+
+			for (ConflictKey &entry: top_keys_) {
+				if (entry.hash != 0) { entry.count = estimate(entry.hash); }
+			}
+			for (ConflictKey entry: other.top_keys_) {
+				if (entry.hash == 0) { continue; }
+				entry.count = estimate(entry.hash);
+				update_top_keys(entry);
+			}
+		}
+
+		//! @brief Clear all records.
+		void clear_up() {
+			for (auto &row: sketch_) { row.fill(0); }
+			top_keys_.fill({});
+			last_conflict_  = {};
+			sample_counter_ = 0;
+			total_conflict_ = 0;
+		}
+
+		//! @brief Print the hottest keys
+		void print_summary() const {
+			if constexpr (ENABLE_CONFLICT_TRACKER) {
+				auto sorted_keys = top_keys_;
+				std::sort(sorted_keys.begin(), sorted_keys.end(),
+				          [](const ConflictKey &a, const ConflictKey &b) { return a.count > b.count; });
+
+				util::print_property_header("Hot Conflict Keys");
+				std::cout << "\e[32m";
+				util::print_kv_pair(std::make_tuple("Total conflicts", total_conflict_, ""));
+				for (const ConflictKey &entry: sorted_keys) {
+					if (entry.hash == 0) { continue; }
+					util::print_kv_pair(std::make_tuple(
+							std::format("Table {} Key {}", entry.type, entry.main_key),
+							static_cast<uint64_t>(entry.count) * SAMPLE_INTERVAL,
+							"conflicts(estimated)"));
+				}
+				std::cout << "\e[0m" << std::endl;
+			}
+		}
+
+	private:
+		static uint64_t get_key_hash(uint32_t type, uint64_t main_key) {
+			// Keep 0 as invalid hash, without biasing any bit which may be used to spread keys
+			const uint64_t hash = util::fnvhash(main_key ^ (static_cast<uint64_t>(type) << 48));
+			return hash != 0 ? hash : 1;
+		}
+
+		static uint32_t get_slot(uint64_t hash, uint32_t row) {
+			return static_cast<uint32_t>((hash >> (row * 16)) ^ (hash >> 32) * (row + 1)) & (SKETCH_WIDTH - 1);
+		}
+
+		uint32_t add_to_sketch(uint64_t hash) {
+			uint32_t res = std::numeric_limits<uint32_t>::max();
+			for (uint32_t i = 0; i < SKETCH_DEPTH; ++i) {
+				uint32_t &counter = sketch_[i][get_slot(hash, i)];
+				res = std::min(res, ++counter);
+			}
+			return res;
+		}
+
+		void update_top_keys(const ConflictKey &key) {
+			ConflictKey *min_entry = &top_keys_[0];
+			for (ConflictKey &entry: top_keys_) {
+				if (entry.hash == key.hash) {
+					entry.count = std::max(entry.count, key.count);
+					return;
+				}
+				if (entry.count < min_entry->count) { min_entry = &entry; }
+			}
+			if (min_entry->count < key.count) { *min_entry = key; }
+		}
+	};
+
+}
@@ -5,11 +5,12 @@
 
 #pragma once
 
-#include <util/latency_counter.h>
+#include <util/latency_histogram.h>
 #include <spdlog/spdlog.h>
 #include <thread/thread.h>
 
 #include <concurrent_control/abstract_concurrent_control.h>
+#include <concurrent_control/conflict_tracker.h>
 
 #include <concurrent_control/courier/data_tuple.h>
 #include <concurrent_control/courier/tx_context.h>
@@ -63,6 +64,16 @@ namespace cc::courier {
 		static constexpr bool LOCK_RETRY_LIMIT          = true;
 		static constexpr uint32_t LOCK_RETRY_LIMIT_NUM  = 2;
 
+		/// Validate read set in running phase to abort doomed transactions early, off to keep the original protocol
+		static constexpr bool INCREMENTAL_VALIDATE                   = false;
+		/// Validate once after such number of reads
+		static constexpr uint32_t INCREMENTAL_VALIDATE_READ_INTERVAL = 16;
+		/// Validate before each write if there are reads not validated
+		static constexpr bool INCREMENTAL_VALIDATE_BEFORE_WRITE      = true;
+
+		/// Log only bytes changed by updates, off to keep the original full-tuple log
+		static constexpr bool DELTA_UPDATE_LOG = false;
+
 	public:
 		StorageManager *storage_manager_ptr_;
 
@@ -76,7 +87,7 @@ namespace cc::courier {
 		explicit Courier(StorageManager *storage_manager_ptr):
 				storage_manager_ptr_(storage_manager_ptr),
 				data_persist_(storage_manager_ptr, &log_persist_),
-				log_persist_(storage_manager_ptr->get_log_space_range()) {
+				log_persist_(storage_manager_ptr->get_log_space_range(), storage_manager_ptr->get_log_space_stripe_num()) {
 			spdlog::warn("Experiment can't make sure that data read is integral when running transaction, "
 						"but this inconsistency will be detected when validating.");
 
@@ -192,11 +203,21 @@ namespace cc::courier {
 			if (data_ptr == nullptr) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return nullptr;
+				}
 				// Read timestamp before copying data.
 				// Correspondingly, we will write data before write timestamp in write phase.
 				// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
 				data_ptr = tx_context.access_read(key, temp_index_tuple);
+
+				if constexpr (INCREMENTAL_VALIDATE) {
+					if (tx_context.get_unvalidated_read_num() >= INCREMENTAL_VALIDATE_READ_INTERVAL
+					        && !incremental_validate(tx_context)) [[unlikely]] {
+						return nullptr;
+					}
+				}
 			}
 			return data_ptr;
 		}
@@ -209,9 +230,13 @@ namespace cc::courier {
 		 * @return Whether the tuple exists
 		 */
 		void *update(Context &tx_context, const AbKeyType &key) {
+			if (!validate_before_write(tx_context)) [[unlikely]] { return nullptr; }
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 			// Read timestamp before copying data.
 			// Correspondingly, we will write data before write timestamp in write phase.
 			// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -228,9 +253,13 @@ namespace cc::courier {
 		 * @return Whether the tuple exists
 		 */
 		void *update(Context &tx_context, const AbKeyType &key, uint32_t size, uint32_t offset) {
+			if (!validate_before_write(tx_context)) [[unlikely]] { return nullptr; }
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 			// Read timestamp before copying data.
 			// Correspondingly, we will write data before write timestamp in write phase.
 			// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -249,7 +278,10 @@ namespace cc::courier {
 		bool insert(Context &tx_context, const AbKeyType &key, const void *row, uint32_t size) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (read_index(tx_context, key, temp_index_tuple)) [[unlikely]] { return false; }
+			if (read_index(tx_context, key, temp_index_tuple)) [[unlikely]] {
+				get_thread_message().set_abort_reason(AbortReason::KeyExists);
+				return false;
+			}
 			// There is no such tuple reference to get from index
 			return tx_context.access_insert(key, row, size);
 		}
@@ -263,7 +295,10 @@ namespace cc::courier {
 		bool remove(Context &tx_context, const AbKeyType &key) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] { return false; }
+			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return false;
+			}
 			// There is no such tuple reference to get from index
 			return tx_context.access_delete(key, temp_index_tuple);
 		}
@@ -331,32 +366,36 @@ namespace cc::courier {
 
 			// Validate write set
 			for (auto &entry: write_set) {
-				if (entry.type == TxType::Insert) [[unlikely]] { continue; }
+				if (entry.type == TxType::Insert) [[unlikely]] { ++lock_num; continue; }
 
 				IndexTupleType &origin_tuple = entry.tuple;
 
-				if constexpr (LOCK_RETRY_LIMIT) {
-					uint32_t retry_times = 0;
-					while (origin_tuple.try_lock_write() && ++retry_times != LOCK_RETRY_LIMIT_NUM) {
-						thread::pause();
-					}
+				// Avoid locking the same tuple repeatedly
+				if (own_lock(write_set, lock_num)) {
+					if constexpr (LOCK_RETRY_LIMIT) {
+						uint32_t retry_times = 0;
+						while (!origin_tuple.try_lock_write() && ++retry_times != LOCK_RETRY_LIMIT_NUM) {
+							thread::pause();
+						}
 
-					if (retry_times == LOCK_RETRY_LIMIT_NUM) {
-						success_validate = false;
-						break;
+						if (retry_times == LOCK_RETRY_LIMIT_NUM) {
+							ConflictTracker::get_thread_tracker().record_conflict(entry.key);
+							get_thread_message().set_abort_reason(AbortReason::LockRetryLimit);
+							success_validate = false;
+							break;
+						}
 					}
-				}
-				else {
-					while (origin_tuple.try_lock_write() ) {
-						thread::pause();
+					else {
+						while (!origin_tuple.try_lock_write()) {
+							thread::pause();
+						}
 					}
 				}
-
-
-				// Avoid locking the same tuple repeatedly
 				++lock_num;
 
 				if (entry.wts != origin_tuple.get_wts()) {
+					ConflictTracker::get_thread_tracker().record_conflict(entry.key);
+					get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 					success_validate = false;
 					break;
 				}
@@ -372,12 +411,16 @@ namespace cc::courier {
 					if (origin_tuple.is_locked_write()) [[unlikely]] {
 						// Avoid repeated tuple in a read set and write set
 						if (!tx_context.look_up_write_set(entry.key)) {
+							ConflictTracker::get_thread_tracker().record_conflict(entry.key);
+							get_thread_message().set_abort_reason(AbortReason::Locked);
 							success_validate = false;
 							break;
 						}
 					}
 					uint64_t wts = origin_tuple.get_wts();
 					if (entry.wts != wts) {
+						ConflictTracker::get_thread_tracker().record_conflict(entry.key);
+						get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 						success_validate = false;
 						break;
 					}
@@ -394,7 +437,9 @@ namespace cc::courier {
 				update_index(tx_context);
 			}
 			// Unlock all locked tuples.
-			for (int i = 0; i < lock_num; ++i) { write_set[i].tuple.unlock_write(); }
+			for (int i = 0; i < lock_num; ++i) {
+				if (own_lock(write_set, i)) { write_set[i].tuple.unlock_write(); }
+			}
 
 			// Delay update event and insert event
 			if (success_validate) {
@@ -416,7 +461,7 @@ namespace cc::courier {
 		 * @return Always true
 		 */
 		bool abort(Context &tx_context) {
-			get_thread_message().abort_transaction();
+			get_thread_message().abort_transaction(tx_context.message_);
 			return clean_up(tx_context);
 		}
 
@@ -433,6 +478,54 @@ namespace cc::courier {
 
 	private: // Assist Function
 
+		/*!
+		 * @brief Whether an entry of the sorted write set holds the lock of its tuple during commit.
+		 * Inserted tuples are not locked, and a tuple updated repeatedly is locked by its first entry.
+		 */
+		static bool own_lock(const auto &write_set, size_t idx) {
+			if (write_set[idx].type == TxType::Insert) { return false; }
+			return idx == 0 || !(write_set[idx - 1].key == write_set[idx].key);
+		}
+
+		/*!
+		 * @brief Validate reads since the last incremental validation in running phase,
+		 * so that a doomed transaction aborts before doing more expensive work.
+		 * Earlier reads are left to the validation at commit.
+		 * @param tx_context Context of transaction
+		 * @return Whether the new reads are still valid
+		 */
+		bool incremental_validate(Context &tx_context) {
+			tx_context.message_.start_early_validate();
+			bool success_validate = true;
+			auto &read_set = tx_context.read_set_;
+			for (size_t idx = tx_context.validated_read_num_; idx < read_set.size(); ++idx) {
+				auto &entry = read_set[idx];
+				IndexTupleType &origin_tuple = entry.tuple;
+				if (entry.wts != origin_tuple.get_wts()) {
+					ConflictTracker::get_thread_tracker().record_conflict(entry.key);
+					get_thread_message().set_abort_reason(AbortReason::EarlyValidate);
+					success_validate = false;
+					break;
+				}
+			}
+			tx_context.validated_read_num_ = static_cast<uint32_t>(read_set.size());
+			tx_context.message_.end_early_validate();
+
+			if (!success_validate) {
+				get_thread_message().early_abort_transaction();
+			}
+			return success_validate;
+		}
+
+		bool validate_before_write(Context &tx_context) {
+			if constexpr (INCREMENTAL_VALIDATE && INCREMENTAL_VALIDATE_BEFORE_WRITE) {
+				if (tx_context.get_unvalidated_read_num() != 0) {
+					return incremental_validate(tx_context);
+				}
+			}
+			return true;
+		}
+
 		/*!
 		 * @brief Write log
 		 * @param tx_context Context of transaction
@@ -444,15 +537,29 @@ namespace cc::courier {
 
 			LogSpace &log_space = thread_local_context.log_space.value();
 			uint8_t *start_ptr = log_space.cur_ptr;
+			// Bytes saved by delta encoding
+			uint64_t saved_size = 0;
 			// ---- Write log
 			// Write
 			for (const WriteEntryType &entry: write_set) {
 				if (entry.type == TxType::Write) [[likely]] {
-					log_persist_.add_update_log(log_space, entry.wts,
-					                            entry.key,
-					                            static_cast<uint8_t *>(entry.data_ptr),
-					                            entry.size,
-					                            entry.offset);
+					if constexpr (DELTA_UPDATE_LOG) {
+						// The tuple is locked, so the pre-image is the same as the one read.
+						const uint32_t log_size = log_persist_.add_delta_update_log(log_space, entry.wts,
+						                            entry.key,
+						                            static_cast<uint8_t *>(entry.data_ptr),
+						                            entry.tuple.get_virtual_data_ptr(),
+						                            entry.size,
+						                            entry.offset);
+						saved_size += sizeof(LogTuple<LogLabel::Update, AbKeyType>) + entry.size - log_size;
+					}
+					else {
+						log_persist_.add_update_log(log_space, entry.wts,
+						                            entry.key,
+						                            static_cast<uint8_t *>(entry.data_ptr),
+						                            entry.size,
+						                            entry.offset);
+					}
 				}
 				else if (entry.type == TxType::Insert) {
 					log_persist_.add_insert_log(log_space, entry.wts,
@@ -471,6 +578,9 @@ namespace cc::courier {
 			util_mem::clflushopt_range(start_ptr, log_space.cur_ptr - start_ptr);
 			storage_manager_ptr_->fence();
 
+			const uint64_t log_size = log_space.cur_ptr - start_ptr;
+			get_thread_message().record_log(log_size + saved_size, log_size);
+
 			tx_context.message_.end_persist_log();
 		}
 
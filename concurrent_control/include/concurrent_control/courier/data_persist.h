@@ -145,7 +145,10 @@ namespace cc::courier {
 		void aid(uint32_t tid) {
 			if (tid == 0) { persist_thread_work(); }
 			// Try to aid processing tasks.
-			if (need_aid(tid)) [[unlikely]] { do_batch(); }
+			if (need_aid(tid)) [[unlikely]] {
+				util::TraceScope trace_scope("aid");
+				do_batch();
+			}
 		}
 
 		/*!
@@ -166,6 +169,8 @@ namespace cc::courier {
 			* @param batch_ptr The pointer to the batch
 			*/
 		void process_batch(ThreadBuffer *batch_ptr) {
+			util::TraceScope trace_scope("process_batch");
+
 			auto &entry_map       = batch_ptr->entry_map;
 			auto &log_space       = batch_ptr->log_space;
 
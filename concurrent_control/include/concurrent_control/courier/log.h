@@ -13,7 +13,9 @@ namespace cc::courier {
 		Insert,
 		Update,
 		Delete,
-		Commit
+		Commit,
+		/// Update with runs of changed bytes only, see delta_log.h
+		DeltaUpdate
 	};
 
 	template<LogLabel Label, class AbKey>
@@ -10,10 +10,15 @@
 #include <atomic>
 #include <span>
 #include <optional>
+#include <vector>
+#include <utility>
+#include <algorithm>
 
 #include <util/utility_macro.h>
+#include <thread/thread.h>
 #include <memory/cache_config.h>
 
+#include <concurrent_control/delta_log.h>
 #include <concurrent_control/courier/log.h>
 #include <concurrent_control/courier/thread_context.h>
 
@@ -37,13 +42,37 @@ namespace cc::courier {
 
 		LogMetadata log_metadata_;
 
+		/// The number of stripes(PMEM namespaces) the log space consists of
+		uint32_t stripe_num_;
+
+		/// Pages within each stripe, in form of [begin, end)
+		std::vector<std::pair<size_t, size_t>> stripe_page_range_;
+
 	public:
-		LogPersist(std::span<uint8_t> log_space_range) {
+		/*!
+		 * @param log_space_range Log space
+		 * @param stripe_num The number of equal-sized stripes of log space, each on its own NUMA node
+		 */
+		LogPersist(std::span<uint8_t> log_space_range, uint32_t stripe_num = 1): stripe_num_(std::max(stripe_num, 1U)) {
 			size_t page_num    = log_space_range.size() / LOG_PAGE_SIZE;
 			size_t bitmap_size = align_to_cache_line((page_num + 7) / 8);
 			log_space_available_           = new std::atomic<uint8_t>[bitmap_size]{0};
 			log_metadata_.allocate_bitmap_ = log_space_range.data();
 			log_space_range_               = log_space_range.subspan(bitmap_size);
+
+			// Pages wholly inside a stripe belong to it
+			const size_t stripe_size = log_space_range.size() / stripe_num_;
+			for (uint32_t i = 0; i < stripe_num_; ++i) {
+				const size_t stripe_begin = std::max(i * stripe_size, bitmap_size) - bitmap_size;
+				const size_t stripe_end   = std::max((i + 1) * stripe_size, bitmap_size) - bitmap_size;
+				size_t page_begin = (stripe_begin + LOG_PAGE_SIZE - 1) / LOG_PAGE_SIZE;
+				size_t page_end   = std::min(stripe_end / LOG_PAGE_SIZE, get_page_num());
+				if (page_begin >= page_end) {
+					page_begin = 0;
+					page_end   = get_page_num();
+				}
+				stripe_page_range_.emplace_back(page_begin, page_end);
+			}
 		}
 
 		~LogPersist() {
@@ -56,8 +85,11 @@ namespace cc::courier {
 
 	public:
 		std::optional<LogSpace> allocate_log_space() {
-			thread_local_context.page_idx = (thread_local_context.page_idx + 1) % get_page_num();
-			uint32_t page_idx = thread_local_context.page_idx;
+			// Rotate among pages on the local stripe
+			const auto [page_begin, page_end] = get_local_page_range();
+			size_t &page_idx = thread_local_context.page_idx;
+			page_idx = page_idx + 1;
+			if (page_idx < page_begin || page_idx >= page_end) { page_idx = page_begin + page_idx % (page_end - page_begin); }
 
 			size_t bit_mask_idx       = page_idx / 8;
 			size_t bit_mask_inner_idx = page_idx % 8;
@@ -79,6 +111,12 @@ namespace cc::courier {
 			return std::nullopt;
 		}
 
+		//! @brief Get pages on the stripe local to the calling thread.
+		std::pair<size_t, size_t> get_local_page_range() const {
+			if (stripe_num_ == 1 || !thread::is_registered()) { return { 0, get_page_num() }; }
+			return stripe_page_range_[static_cast<uint32_t>(thread::get_cpu_numa_id()) % stripe_num_];
+		}
+
 		void deallocate_log_space(LogSpace log_space) {
 			size_t page_idx = (log_space.start_ptr - log_space_range_.data()) / LOG_PAGE_SIZE;
 
@@ -126,6 +164,35 @@ namespace cc::courier {
 			log_space_assert(log_space);
 		}
 
+		/*!
+		 * @brief Log only runs of bytes differing from the pre-image, or the whole content if it is not smaller.
+		 * @param src New content, which should have been moved by corresponding offset
+		 * @param origin_src Pre-image, which should have been moved by corresponding offset
+		 * @return Size of log tuple written
+		 */
+		uint32_t add_delta_update_log(LogSpace &log_space, uint64_t ts, AbKey key, const void *src, const void *origin_src, uint32_t size, uint32_t offset) {
+			auto *log_tuple_ptr = reinterpret_cast<LogTuple<LogLabel::DeltaUpdate, AbKeyType> *>(log_space.cur_ptr);
+			// Space for the maximal delta has been reserved
+			const uint32_t delta_size = encode_delta(log_tuple_ptr->extra_info_,
+			                                         static_cast<const uint8_t *>(src) + offset,
+			                                         static_cast<const uint8_t *>(origin_src) + offset,
+			                                         size);
+			if (delta_size >= size) {
+				add_update_log(log_space, ts, key, src, size, offset);
+				return sizeof(LogTuple<LogLabel::Update, AbKeyType>) + size;
+			}
+			new (log_tuple_ptr) LogTuple<LogLabel::DeltaUpdate, AbKeyType>{
+					.label_ = LogLabel::DeltaUpdate,
+					.ts_ = ts,
+					.key_ = key,
+					.size_ = delta_size,
+					.offset_ = offset
+			};
+			log_space.cur_ptr += sizeof(LogTuple<LogLabel::DeltaUpdate, AbKeyType>) + delta_size;
+			log_space_assert(log_space);
+			return sizeof(LogTuple<LogLabel::DeltaUpdate, AbKeyType>) + delta_size;
+		}
+
 		void add_insert_log(LogSpace &log_space, uint64_t ts, AbKey key, const void *src, uint32_t size) {
 			auto *log_tuple_ptr = reinterpret_cast<LogTuple<LogLabel::Insert, AbKeyType> *>(log_space.cur_ptr);
 			log_space_assert(log_space);
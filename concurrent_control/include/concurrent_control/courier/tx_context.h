@@ -8,11 +8,13 @@
 #include <cstdint>
 #include <mutex>
 #include <vector>
+#include <algorithm>
 #include <queue>
 #include <utility>
 
 #include <concurrent_control/abstract_concurrent_control.h>
 #include <concurrent_control/config.h>
+#include <concurrent_control/delta_log.h>
 #include <concurrent_control/courier/data_tuple.h>
 #include <concurrent_control/courier/log.h>
 
@@ -98,6 +100,8 @@ namespace cc::courier {
 		ConcurrentControlPortableMessage message_;
 		/// The total size of log info
 		uint32_t log_info_size_;
+		/// The number of reads at the front of read set validated incrementally, all of which are validated again at commit
+		uint32_t validated_read_num_;
 		/// For all read elements
 		std::vector<ReadEntry> read_set_;
 		/// For all update/insert/delete elements
@@ -106,7 +110,7 @@ namespace cc::courier {
 		std::vector<std::unique_lock<std::shared_mutex>> lock_stack;
 
 	public:
-		TxContext(): log_info_size_(0) {}
+		TxContext(): log_info_size_(0), validated_read_num_(0) {}
 
 		TxContext(TxContext &&other) noexcept = default;
 
@@ -133,6 +137,10 @@ namespace cc::courier {
 			delete[] static_cast<uint8_t *>(ptr);
 		}
 
+		uint32_t get_unvalidated_read_num() const {
+			return static_cast<uint32_t>(read_set_.size()) - validated_read_num_;
+		}
+
 		void clear_abort() {
 			for (auto &write_event: write_set_) {
 				deallocate_data_buffer(write_event.data_ptr);
@@ -141,7 +149,8 @@ namespace cc::courier {
 			write_set_.clear();
 			lock_stack.clear();
 
-			log_info_size_ = 0;
+			log_info_size_      = 0;
+			validated_read_num_ = 0;
 		}
 
 	public:
@@ -169,6 +178,11 @@ namespace cc::courier {
 		}
 
 		void *access_write(const AbKeyType &key, IndexTupleType &tuple, uint32_t size, uint32_t offset) {
+			// A tuple written repeatedly keeps one entry, so that its log is diffed against the pre-image once
+			if (WriteEntry *entry_ptr = find_write_entry(key); entry_ptr != nullptr) {
+				merge_write_range(*entry_ptr, size, offset);
+				return entry_ptr->data_ptr;
+			}
 			// Allocate a temp space storing data
 			uint8_t *data_buffer = allocate_data_buffer(tuple.data_size_);
 			// Get wts from the header of data tuple, read timestamp before data pointer
@@ -194,8 +208,8 @@ namespace cc::courier {
 					.tuple    = tuple
 				}
 			);
-			// Register log
-			log_info_size_ += sizeof(LogTuple<LogLabel::Delete, AbKeyType>) + size;
+			// Register log, reserving space for the maximal delta
+			log_info_size_ += sizeof(LogTuple<LogLabel::DeltaUpdate, AbKeyType>) + get_max_delta_size(size);
 
 			return data_buffer;
 		}
@@ -239,6 +253,23 @@ namespace cc::courier {
 		uint32_t get_log_amount_size() const {
 			return log_info_size_;
 		}
+
+	private:
+		WriteEntry *find_write_entry(const AbKeyType &key) {
+			for (WriteEntry &entry: write_set_) {
+				if (entry.type == TxType::Write && entry.key == key) { return &entry; }
+			}
+			return nullptr;
+		}
+
+		//! @brief Extend the range of an update to cover another write, bytes in between are the same as the pre-image.
+		void merge_write_range(WriteEntry &entry, uint32_t size, uint32_t offset) {
+			const uint32_t end = std::max(entry.offset + entry.size, offset + size);
+			log_info_size_ -= get_max_delta_size(entry.size);
+			entry.offset    = std::min(entry.offset, offset);
+			entry.size      = end - entry.offset;
+			log_info_size_ += get_max_delta_size(entry.size);
+		}
 	};
 
 }
@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include <util/latency_counter.h>
+#include <util/latency_histogram.h>
 #include <spdlog/spdlog.h>
 #include <thread/thread.h>
 #include <oneapi/tbb.h>
@@ -19,6 +19,7 @@
 #include <concurrent_control/courier_save/log_persist.h>
 #include <concurrent_control/courier_save/vheader_cache.h>
 #include <concurrent_control/courier_save/recovery.h>
+#include <recovery/abstract_recovery.h>
 
 namespace cc::courier_save {
 
@@ -70,6 +71,9 @@ namespace cc::courier_save {
 		static constexpr bool REMOTE_LOCK_RETRY_LIMIT         = true;
 		static constexpr uint32_t REMOTE_LOCK_RETRY_LIMIT_NUM = 2;
 
+		/// Log only bytes changed by updates, off to keep the original full-tuple log
+		static constexpr bool DELTA_UPDATE_LOG = false;
+
 	public:
 		StorageManager *storage_manager_ptr_;
 
@@ -80,12 +84,14 @@ namespace cc::courier_save {
 
 		std::array<VHeaderCache, thread::get_max_tid()> cache_array_;
 
+		recovery::RecoveryStatistics recovery_statistics_;
+
 	public: // Class Property
 
 		explicit CourierSave(StorageManager *storage_manager_ptr):
 				storage_manager_ptr_(storage_manager_ptr),
 				data_persist_(storage_manager_ptr, &log_persist_),
-				log_persist_(storage_manager_ptr->get_log_space_range()) {
+				log_persist_(storage_manager_ptr->get_log_space_range(), storage_manager_ptr->get_log_space_stripe_num()) {
 			spdlog::warn("Experiment can't make sure that data read is integral when running transaction, "
 						"but this inconsistency will be detected when validating.");
 
@@ -107,25 +113,35 @@ namespace cc::courier_save {
 			storage_manager_ptr_->fence();
 		}
 
+		/*!
+		 * @brief Rebuild index from valid data tuples, and collect updates of committed transactions in log.
+		 * @return Updates to be replayed in order of timestamp
+		 */
 		std::vector<RecoveryTransactionType> recovery() {
 			auto size_array = storage_manager_ptr_->get_table_size_info();
+			recovery_statistics_ = {};
+			std::atomic<uint64_t> data_tuple_num{0}, data_size{0};
 
 			auto start_time = std::chrono::steady_clock::now();
 			for (uint32_t i = 0; i < size_array.size(); ++i) {
 				const auto size = size_array[i];
 
-				std::function<bool(void *)> func([this, size](void *ptr){
+				std::function<bool(void *)> func([this, size, &data_tuple_num, &data_size](void *ptr){
 					const auto *tuple_header_ptr = static_cast<DataTupleHeaderType *>(ptr);
 					if (!tuple_header_ptr->valid_) { return false; }
+					data_tuple_num.fetch_add(1, std::memory_order::relaxed);
+					data_size.fetch_add(size, std::memory_order::relaxed);
 					// Forward pointer
 					void *header_ptr = ptr;
 					void *data_ptr = static_cast<DataTupleHeaderType *>(ptr) + 1;
 					auto key = tuple_header_ptr->key_;
+					// Write timestamp of data persisted, which is kept so that stale logs are skipped
+					auto wts = tuple_header_ptr->wts_;
 
 					// Set the data pointer of header as entry in an insert set.
-					new(header_ptr) DataTupleHeaderType(key);
+					new(header_ptr) DataTupleHeaderType(key, wts);
 					// Allocate new header for data
-					auto *virtual_header_ptr = new DataTupleVirtualHeaderType(0, data_ptr, data_ptr, size, key.type_);
+					auto *virtual_header_ptr = new DataTupleVirtualHeaderType(wts, data_ptr, data_ptr, size, key.type_);
 					// Make index tuple of data and connect it with data header.
 					IndexTupleType index_tuple(key.type_, size, virtual_header_ptr, data_ptr);
 					// Insert index tuple
@@ -140,6 +156,9 @@ namespace cc::courier_save {
 			auto end_time = std::chrono::steady_clock::now();
 			auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
 			spdlog::info("Recovery - Data Iteration Time: {} ms", duration.count());
+			recovery_statistics_.data_iteration_time = duration.count();
+			recovery_statistics_.data_tuple_num      = data_tuple_num.load();
+			recovery_statistics_.data_size           = data_size.load();
 
 
 			std::vector<RecoveryTransactionType> res_tx_array;
@@ -147,6 +166,12 @@ namespace cc::courier_save {
 			start_time = std::chrono::steady_clock::now();
 			RecoveryManager<AbKeyType> recovery_manager(
 					[this, &res_tx_array](uint64_t ts, AbKeyType key, uint32_t size, uint32_t offset, const void *ptr){
+						// Updates before the write timestamp of data persisted have been applied already
+						IndexTupleType index_tuple;
+						if (storage_manager_ptr_->read_data_index_tuple(key.type_, key.logic_key_, index_tuple)
+						        && ts < index_tuple.get_wts()) {
+							return;
+						}
 				        res_tx_array.emplace_back(key, size, offset, ts, (uint8_t *)ptr);
 					},
 					[](uint64_t ts, AbKeyType key, uint32_t size, const void *ptr) {
@@ -165,10 +190,21 @@ namespace cc::courier_save {
 			end_time = std::chrono::steady_clock::now();
 			duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
 			spdlog::info("Recovery - Log Iteration Time: {} ms", duration.count());
+			recovery_statistics_.log_iteration_time = duration.count();
+			recovery_statistics_.log_size           = recovery_manager.get_log_size();
 
+			// Updates of a tuple may lie in log pages of different threads
+			std::stable_sort(res_tx_array.begin(), res_tx_array.end(),
+			                 [](const RecoveryTransactionType &lhs, const RecoveryTransactionType &rhs) {
+				return lhs.get_ts() < rhs.get_ts();
+			});
 			return res_tx_array;
 		}
 
+		const recovery::RecoveryStatistics &get_recovery_statistics() const {
+			return recovery_statistics_;
+		}
+
 		/*!
 		 * @brief Get summary of all threads, requesting no threads participating in transaction execution having exited.
 		 * @return
@@ -252,7 +288,10 @@ namespace cc::courier_save {
 			if (data_ptr == nullptr) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return nullptr;
+				}
 				// Read timestamp before copying data.
 				// Correspondingly, we will write data before write timestamp in write phase.
 				// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -271,7 +310,10 @@ namespace cc::courier_save {
 		void *update(Context &tx_context, const AbKeyType &key) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 			// Read timestamp before copying data.
 			// Correspondingly, we will write data before write timestamp in write phase.
 			// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -290,7 +332,10 @@ namespace cc::courier_save {
 		void *update(Context &tx_context, const AbKeyType &key, uint32_t size, uint32_t offset) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 			// Read timestamp before copying data.
 			// Correspondingly, we will write data before write timestamp in write phase.
 			// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -309,7 +354,10 @@ namespace cc::courier_save {
 		bool insert(Context &tx_context, const AbKeyType &key, const void *row, uint32_t size) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (read_index(tx_context, key, temp_index_tuple)) [[unlikely]] { return false; }
+			if (read_index(tx_context, key, temp_index_tuple)) [[unlikely]] {
+				get_thread_message().set_abort_reason(AbortReason::KeyExists);
+				return false;
+			}
 			// There is no such tuple reference to get from index
 			return tx_context.access_insert(key, row, size);
 		}
@@ -323,7 +371,10 @@ namespace cc::courier_save {
 		bool remove(Context &tx_context, const AbKeyType &key) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] { return false; }
+			if (!read_index(tx_context, key, temp_index_tuple)) [[unlikely]] {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return false;
+			}
 			// There is no such tuple reference to get from index
 			return tx_context.access_delete(key, temp_index_tuple);
 		}
@@ -400,32 +451,34 @@ namespace cc::courier_save {
 
 			// Validate write set
 			for (auto &entry: write_set) {
-				if (entry.type == TxType::Insert) [[unlikely]] { continue; }
+				if (entry.type == TxType::Insert) [[unlikely]] { ++lock_num; continue; }
 
 				IndexTupleType &origin_tuple = entry.tuple;
 
-				if constexpr (LOCAL_LOCK_RETRY_LIMIT) {
-					uint32_t retry_times = 0;
-					while (origin_tuple.try_lock_write() && ++retry_times != LOCAL_LOCK_RETRY_LIMIT_NUM) {
-						thread::pause();
-					}
+				// Avoid locking the same tuple repeatedly
+				if (own_lock(write_set, lock_num)) {
+					if constexpr (LOCAL_LOCK_RETRY_LIMIT) {
+						uint32_t retry_times = 0;
+						while (!origin_tuple.try_lock_write() && ++retry_times != LOCAL_LOCK_RETRY_LIMIT_NUM) {
+							thread::pause();
+						}
 
-					if (retry_times == LOCAL_LOCK_RETRY_LIMIT_NUM) {
-						success_validate = false;
-						break;
+						if (retry_times == LOCAL_LOCK_RETRY_LIMIT_NUM) {
+							get_thread_message().set_abort_reason(AbortReason::LockRetryLimit);
+							success_validate = false;
+							break;
+						}
 					}
-				}
-				else {
-					while (origin_tuple.try_lock_write()) {
-						thread::pause();
+					else {
+						while (!origin_tuple.try_lock_write()) {
+							thread::pause();
+						}
 					}
 				}
-
-
-				// Avoid locking the same tuple repeatedly
 				++lock_num;
 
 				if (entry.wts != origin_tuple.get_wts()) {
+					get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 					success_validate = false;
 					break;
 				}
@@ -441,12 +494,14 @@ namespace cc::courier_save {
 					if (origin_tuple.is_locked_write()) [[unlikely]] {
 						// Avoid repeated tuple in a read set and write set
 						if (!tx_context.look_up_write_set(entry.key)) {
+							get_thread_message().set_abort_reason(AbortReason::Locked);
 							success_validate = false;
 							break;
 						}
 					}
 					uint64_t wts = origin_tuple.get_wts();
 					if (entry.wts != wts) {
+						get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 						success_validate = false;
 						break;
 					}
@@ -463,7 +518,9 @@ namespace cc::courier_save {
 				update_index(tx_context);
 			}
 			// Unlock all locked tuples.
-			for (int i = 0; i < lock_num; ++i) { write_set[i].tuple.unlock_write(); }
+			for (int i = 0; i < lock_num; ++i) {
+				if (own_lock(write_set, i)) { write_set[i].tuple.unlock_write(); }
+			}
 
 			// Delay update event and insert event
 			if (success_validate) {
@@ -485,7 +542,7 @@ namespace cc::courier_save {
 		 * @return Always true
 		 */
 		bool abort(Context &tx_context) {
-			get_thread_message().abort_transaction();
+			get_thread_message().abort_transaction(tx_context.message_);
 			return clean_up(tx_context);
 		}
 
@@ -502,6 +559,15 @@ namespace cc::courier_save {
 
 	private: // Assist Function
 
+		/*!
+		 * @brief Whether an entry of the sorted write set holds the lock of its tuple during commit.
+		 * Inserted tuples are not locked, and a tuple updated repeatedly is locked by its first entry.
+		 */
+		static bool own_lock(const auto &write_set, size_t idx) {
+			if (write_set[idx].type == TxType::Insert) { return false; }
+			return idx == 0 || !(write_set[idx - 1].key == write_set[idx].key);
+		}
+
 		/*!
 		 * @brief Write log
 		 * @param tx_context Context of transaction
@@ -513,15 +579,29 @@ namespace cc::courier_save {
 
 			LogSpace &log_space = thread_local_context.log_space.value();
 			uint8_t *start_ptr = log_space.cur_ptr;
+			// Bytes saved by delta encoding
+			uint64_t saved_size = 0;
 			// ---- Write log
 			// Write
 			for (const WriteEntryType &entry: write_set) {
 				if (entry.type == TxType::Write) [[likely]] {
-					log_persist_.add_update_log(log_space, entry.wts,
-					                            entry.key,
-					                            static_cast<uint8_t *>(entry.data_ptr),
-					                            entry.size,
-					                            entry.offset);
+					if constexpr (DELTA_UPDATE_LOG) {
+						// The tuple is locked, so the pre-image is the same as the one read.
+						const uint32_t log_size = log_persist_.add_delta_update_log(log_space, entry.wts,
+						                            entry.key,
+						                            static_cast<uint8_t *>(entry.data_ptr),
+						                            entry.tuple.get_virtual_data_ptr(),
+						                            entry.size,
+						                            entry.offset);
+						saved_size += sizeof(LogTuple<LogLabel::Update, AbKeyType>) + entry.size - log_size;
+					}
+					else {
+						log_persist_.add_update_log(log_space, entry.wts,
+						                            entry.key,
+						                            static_cast<uint8_t *>(entry.data_ptr),
+						                            entry.size,
+						                            entry.offset);
+					}
 				}
 				else if (entry.type == TxType::Insert) {
 					log_persist_.add_insert_log(log_space, entry.wts,
@@ -534,12 +614,16 @@ namespace cc::courier_save {
 					                            entry.key);
 				}
 			}
+			util::CrashInjector::hit("write_log");
 			// Commit
-			log_persist_.add_commit_log(log_space, 0);
+			log_persist_.add_commit_log(log_space);
 
 			util_mem::clflushopt_range(start_ptr, log_space.cur_ptr - start_ptr);
 			sfence();
 
+			const uint64_t log_size = log_space.cur_ptr - start_ptr;
+			get_thread_message().record_log(log_size + saved_size, log_size);
+
 			tx_context.message_.end_persist_log();
 		}
 
@@ -588,11 +672,17 @@ namespace cc::courier_save {
 						// It is atomic because this function locates in the commit phase with mutex lock.
 						if (cache_data_ptr != nullptr) {
 							VHeaderCacheTuple *cache_tuple_ptr = VHeaderCache::construct_data_cache_link(cache_data_ptr, header_ptr);
-							std::memcpy(cache_tuple_ptr->data_, entry.data_ptr, size);
+							// The buffer holds the whole tuple, while the update may cover only part of it
+							std::memcpy(cache_tuple_ptr->data_, entry.data_ptr, origin_tuple.data_size_);
 							// Assign shared handler of the cache tuple to write set for delay persist
 							entry.shared_handler_ptr = &(cache_tuple_ptr->shared_handler_);
 						}
 					}
+					else {
+						// Updates on an existing cache tuple have to be persisted by delay persist as well.
+						// The cache tuple cannot be released, since its data object is locked.
+						entry.shared_handler_ptr = &(VHeaderCache::get_cache_tuple_from_data_ptr(target_ptr)->shared_handler_);
+					}
 
 					if (entry.shared_handler_ptr != nullptr) {
 						// If the data object has had a cache tuple or allocated a cache tuple, make read lock
@@ -604,6 +694,16 @@ namespace cc::courier_save {
 
 					storage_manager_ptr_->fence();
 					origin_tuple.set_wts(origin_tuple.get_wts() + 1);
+
+					if (entry.shared_handler_ptr == nullptr) {
+						// Data is updated in place, then stamped so that recovery skips logs before it.
+						auto *data_ptr = static_cast<uint8_t *>(origin_tuple.get_origin_data_ptr());
+						storage_manager_ptr_->pwb_range(data_ptr + offset, size);
+						storage_manager_ptr_->fence();
+						auto *data_header_ptr = reinterpret_cast<DataTupleHeaderType *>(data_ptr) - 1;
+						data_header_ptr->wts_ = origin_tuple.get_wts();
+						storage_manager_ptr_->pwb_range(data_header_ptr, sizeof(DataTupleHeaderType));
+					}
 				}
 				else if (entry.type == TxType::Insert) {
 					auto key           = entry.key;
@@ -10,6 +10,7 @@
 #include <utility>
 #include <unordered_map>
 #include <concurrentqueue/concurrentqueue.h>
+#include <util/crash_injector.h>
 
 #include <concurrent_control/abstract_concurrent_control.h>
 #include <concurrent_control/courier_save/data_tuple.h>
@@ -29,6 +30,7 @@ namespace cc::courier_save {
 		using AbKeyType       = AbKey;
 		using KeyType         = AbKeyType::MainKeyType;
 
+		using DataTupleHeaderType = DataTupleHeader<AbKeyType>;
 		using IndexTupleType  = IndexTuple;
 		using Context         = TxContext<AbKeyType>;
 
@@ -163,7 +165,10 @@ namespace cc::courier_save {
 		void aid(uint32_t tid) {
 			// Try to aid processing tasks.
 			if (tid == 0) { persist_thread_work(); }
-			if (need_aid(tid)) { do_batch(); }
+			if (need_aid(tid)) {
+				util::TraceScope trace_scope("aid");
+				do_batch();
+			}
 		}
 
 		/*!
@@ -184,12 +189,15 @@ namespace cc::courier_save {
 			* @param batch_ptr The pointer to the batch
 			*/
 		void process_batch(ThreadBuffer *batch_ptr) {
+			util::TraceScope trace_scope("process_batch");
+
 			auto &entry_map       = batch_ptr->entry_map_;
 			auto &log_space       = batch_ptr->log_space_;
 
 			// Process all entries in the batch
 			for (auto &item: entry_map) {
 				process_event(item.first, item.second);
+				util::CrashInjector::hit("process_batch");
 			}
 			// Make sure log space is freed after all corresponding data is written
 			sfence();
@@ -202,15 +210,11 @@ namespace cc::courier_save {
 			* @param event The task to process
 			*/
 		void process_event(DataTupleVirtualHeader *vheader_ptr, const DelayUpdateEvent &event) {
-			size_t size = event.end_idx_ - event.start_idx_;
-			const void *origin_data_ptr = vheader_ptr->get_origin_data_ptr();
+			void *origin_data_ptr = vheader_ptr->get_origin_data_ptr();
 			void *virtual_data_ptr = vheader_ptr->get_virtual_data_ptr();
 
 			if (origin_data_ptr != virtual_data_ptr) [[likely]] { // Write only when there is cache corresponding to this data tuple
-				const void *source_ptr = event.start_idx_ + static_cast<uint8_t *>(virtual_data_ptr);
-				// Copy the content from DRAM pointed by vHeader to PM
-				std::memcpy(event.target_ptr_, source_ptr, size);
-				clflushopt_range(event.target_ptr_, size);
+				persist_tuple(vheader_ptr, origin_data_ptr, virtual_data_ptr);
 
 				event.shared_handler_ptr_->unlock_shared();
 
@@ -228,6 +232,33 @@ namespace cc::courier_save {
 		}
 
 	private:
+		/*!
+			* @brief Copy the whole tuple from cache to PM, stamped with its write timestamp.
+			* Log of this batch is freed afterward, while logs of the same tuple in other batches may be not,
+			* so recovery replays only logs after the stamp. Copying a part of tuple is not enough, since
+			* other parts changed by logs before the stamp would be lost.
+			* @param vheader_ptr Virtual header of the tuple
+			* @param origin_data_ptr Data in PM
+			* @param virtual_data_ptr Data in cache
+			*/
+		void persist_tuple(DataTupleVirtualHeader *vheader_ptr, void *origin_data_ptr, const void *virtual_data_ptr) {
+			auto *header_ptr  = static_cast<DataTupleHeaderType *>(origin_data_ptr) - 1;
+			const size_t size = vheader_ptr->get_data_size();
+
+			// Committing transactions update cache and timestamp under the write lock
+			vheader_ptr->lock_write();
+			const uint64_t wts = vheader_ptr->get_wts();
+			if (header_ptr->wts_ < wts) {
+				std::memcpy(origin_data_ptr, virtual_data_ptr, size);
+				clflushopt_range(origin_data_ptr, size);
+				// Data should be persisted before the stamp telling logs before it are stale
+				sfence();
+				header_ptr->wts_ = wts;
+				clflushopt_range(header_ptr, sizeof(DataTupleHeaderType));
+			}
+			vheader_ptr->unlock_write();
+		}
+
 		/*!
 			* @brief Generate a new event according to the entry in context
 			* @param entry the entry in context(write set / insert set)
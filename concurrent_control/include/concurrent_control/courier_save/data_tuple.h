@@ -89,10 +89,12 @@ namespace cc::courier_save {
 		AbKey key_;
 		/// Indicating whether this tuple is valid
 		bool valid_;
+		/// Write timestamp of data persisted, before which logs have been applied
+		uint64_t wts_;
 
 	public:
-		DataTupleHeader(): key_(), valid_(false) {}
-		explicit DataTupleHeader(AbKey key): key_(key), valid_(true) {}
+		DataTupleHeader(): key_(), valid_(false), wts_(0) {}
+		explicit DataTupleHeader(AbKey key, uint64_t wts = 0): key_(key), valid_(true), wts_(wts) {}
 	};
 
 	/*!
@@ -14,7 +14,9 @@ namespace cc::courier_save {
 		Insert,
 		Update,
 		Delete,
-		Commit
+		Commit,
+		/// Update with runs of changed bytes only, see delta_log.h
+		DeltaUpdate
 	};
 
 	template<LogLabel Label, class AbKey>
@@ -42,6 +44,22 @@ namespace cc::courier_save {
 		uint8_t extra_info_[];
 	};
 
+	template<class AbKey>
+	struct LogTuple<LogLabel::DeltaUpdate, AbKey> {
+	public:
+		/// The type of operation
+		LogLabel label_;
+		/// The timestamp of transaction
+		uint64_t ts_;
+		/// The key of target
+		AbKey    key_;
+		/// The length of delta
+		uint32_t size_;
+		uint32_t offset_;
+		/// Runs of changed bytes
+		uint8_t extra_info_[];
+	};
+
 	template<class AbKey>
 	struct LogTuple<LogLabel::Commit, AbKey> {
 		/// The type of operation
@@ -10,11 +10,17 @@
 #include <atomic>
 #include <span>
 #include <optional>
+#include <vector>
+#include <utility>
+#include <algorithm>
 #include <spdlog/spdlog.h>
 
 #include <util/utility_macro.h>
+#include <util/crash_injector.h>
+#include <thread/thread.h>
 #include <memory/cache_config.h>
 
+#include <concurrent_control/delta_log.h>
 #include <concurrent_control/courier_save/log.h>
 #include <concurrent_control/courier_save/thread_context.h>
 
@@ -27,21 +33,56 @@ namespace cc::courier_save {
 
 		static constexpr size_t LOG_PAGE_SIZE = MEM_PAGE_SIZE * 32;
 
+		//! @brief Header at the start of each log page, occupying a cache line.
+		struct LogPageHeader {
+			/// Increased each time the page is allocated, and never cleared
+			uint64_t generation_;
+		};
+
+		static constexpr size_t LOG_PAGE_HEADER_SIZE = align_to_cache_line(sizeof(LogPageHeader));
+
 	private:
 		std::span<uint8_t> log_space_range_;
 
 		std::span<uint8_t> log_space_available_;
 
+		/// The number of stripes(PMEM namespaces) the log space consists of
+		uint32_t stripe_num_;
+
+		/// Pages within each stripe, in form of [begin, end)
+		std::vector<std::pair<size_t, size_t>> stripe_page_range_;
+
 	public:
-		LogPersist(std::span<uint8_t> log_space_range) {
+		/*!
+		 * @param log_space_range Log space
+		 * @param stripe_num The number of equal-sized stripes of log space, each on its own NUMA node
+		 */
+		LogPersist(std::span<uint8_t> log_space_range, uint32_t stripe_num = 1): stripe_num_(std::max(stripe_num, 1U)) {
 			size_t page_num    = log_space_range.size() / LOG_PAGE_SIZE;
 			size_t bitmap_size = align_to_cache_line((page_num + 7) / 8);
 			log_space_available_           = log_space_range.subspan(0, bitmap_size);
 			log_space_range_               = log_space_range.subspan(bitmap_size);
 
-			std::memset(log_space_available_.data(), 0, bitmap_size);
-			clwb_range(log_space_available_.data(), bitmap_size);
-			sfence();
+			// Pages wholly inside a stripe belong to it
+			const size_t stripe_size = log_space_range.size() / stripe_num_;
+			for (uint32_t i = 0; i < stripe_num_; ++i) {
+				const size_t stripe_begin = std::max(i * stripe_size, bitmap_size) - bitmap_size;
+				const size_t stripe_end   = std::max((i + 1) * stripe_size, bitmap_size) - bitmap_size;
+				size_t page_begin = (stripe_begin + LOG_PAGE_SIZE - 1) / LOG_PAGE_SIZE;
+				size_t page_end   = std::min(stripe_end / LOG_PAGE_SIZE, get_page_num());
+				if (page_begin >= page_end) {
+					page_begin = 0;
+					page_end   = get_page_num();
+				}
+				stripe_page_range_.emplace_back(page_begin, page_end);
+			}
+
+			// Keep log left by the crashed process for recovery
+			if (!util::CrashInjector::is_restarted()) {
+				std::memset(log_space_available_.data(), 0, bitmap_size);
+				clwb_range(log_space_available_.data(), bitmap_size);
+				sfence();
+			}
 
 			spdlog::info("Log range: 0x{} - 0x{}",
 			             static_cast<void *>(log_space_range.data()), static_cast<void *>(log_space_range.data() + log_space_range.size()));
@@ -65,9 +106,11 @@ namespace cc::courier_save {
 
 	public:
 		std::optional<LogSpace> allocate_log_space() {
+			// Rotate among pages on the local stripe
+			const auto [page_begin, page_end] = get_local_page_range();
 			auto &page_idx = thread_local_context.page_idx;
-
-			page_idx = (page_idx + 1) % get_page_num();
+			page_idx = page_idx + 1;
+			if (page_idx < page_begin || page_idx >= page_end) { page_idx = page_begin + page_idx % (page_end - page_begin); }
 
 			const size_t bit_mask_idx       = page_idx / 8;
 			const size_t bit_mask_inner_idx = page_idx % 8;
@@ -78,18 +121,30 @@ namespace cc::courier_save {
 			const uint8_t bit_and = bit_mask | (1 << bit_mask_inner_idx);
 
 			if (bit_mask != bit_and && log_pool_mask.compare_exchange_strong(bit_mask, bit_and)) {
-
-				LogSpace res_space {
-					.start_ptr = log_space_range_.data() + page_idx * LOG_PAGE_SIZE
+				uint8_t *start_ptr = log_space_range_.data() + page_idx * LOG_PAGE_SIZE;
+
+				// Log left by former uses of the page is not cleared, but told by generation.
+				auto *page_header_ptr = reinterpret_cast<LogPageHeader *>(start_ptr);
+				const uint64_t generation = ++page_header_ptr->generation_;
+				clwb_range(page_header_ptr, sizeof(LogPageHeader));
+				sfence();
+
+				return LogSpace {
+					.start_ptr  = start_ptr,
+					.cur_ptr    = start_ptr + LOG_PAGE_HEADER_SIZE,
+					.end_ptr    = start_ptr + LOG_PAGE_SIZE,
+					.generation = generation
 				};
-				res_space.cur_ptr = res_space.start_ptr;
-				res_space.end_ptr = res_space.start_ptr + LOG_PAGE_SIZE;
-
-				return res_space;
 			}
 			return std::nullopt;
 		}
 
+		//! @brief Get pages on the stripe local to the calling thread.
+		std::pair<size_t, size_t> get_local_page_range() const {
+			if (stripe_num_ == 1 || !thread::is_registered()) { return { 0, get_page_num() }; }
+			return stripe_page_range_[static_cast<uint32_t>(thread::get_cpu_numa_id()) % stripe_num_];
+		}
+
 		void deallocate_log_space(LogSpace log_space) {
 			size_t page_idx = (log_space.start_ptr - log_space_range_.data()) / LOG_PAGE_SIZE;
 
@@ -102,10 +157,11 @@ namespace cc::courier_save {
 		}
 
 	public:
-		void add_commit_log(LogSpace &log_space, uint64_t ts) {
+		//! @brief Add commit log, stamped with the generation of the page.
+		void add_commit_log(LogSpace &log_space) {
 			new (log_space.cur_ptr) LogTuple<LogLabel::Commit, AbKeyType>{
 					.label_ = LogLabel::Commit,
-					.ts_ = ts
+					.ts_ = log_space.generation
 			};
 			log_space.cur_ptr += sizeof(LogTuple<LogLabel::Commit, AbKeyType>);
 			log_space_assert(log_space);
@@ -135,6 +191,35 @@ namespace cc::courier_save {
 			log_space_assert(log_space);
 		}
 
+		/*!
+		 * @brief Log only runs of bytes differing from the pre-image, or the whole content if it is not smaller.
+		 * @param src New content, which should have been moved by corresponding offset
+		 * @param origin_src Pre-image, which should have been moved by corresponding offset
+		 * @return Size of log tuple written
+		 */
+		uint32_t add_delta_update_log(LogSpace &log_space, uint64_t ts, AbKey key, const void *src, const void *origin_src, uint32_t size, uint32_t offset) {
+			auto *log_tuple_ptr = reinterpret_cast<LogTuple<LogLabel::DeltaUpdate, AbKeyType> *>(log_space.cur_ptr);
+			// Space for the maximal delta has been reserved
+			const uint32_t delta_size = encode_delta(log_tuple_ptr->extra_info_,
+			                                         static_cast<const uint8_t *>(src) + offset,
+			                                         static_cast<const uint8_t *>(origin_src) + offset,
+			                                         size);
+			if (delta_size >= size) {
+				add_update_log(log_space, ts, key, src, size, offset);
+				return sizeof(LogTuple<LogLabel::Update, AbKeyType>) + size;
+			}
+			new (log_tuple_ptr) LogTuple<LogLabel::DeltaUpdate, AbKeyType>{
+					.label_ = LogLabel::DeltaUpdate,
+					.ts_ = ts,
+					.key_ = key,
+					.size_ = delta_size,
+					.offset_ = offset
+			};
+			log_space.cur_ptr += sizeof(LogTuple<LogLabel::DeltaUpdate, AbKeyType>) + delta_size;
+			log_space_assert(log_space);
+			return sizeof(LogTuple<LogLabel::DeltaUpdate, AbKeyType>) + delta_size;
+		}
+
 		void add_insert_log(LogSpace &log_space, uint64_t ts, AbKey key, const void *src, uint32_t size) {
 			auto *log_tuple_ptr = reinterpret_cast<LogTuple<LogLabel::Insert, AbKeyType> *>(log_space.cur_ptr);
 			new (log_tuple_ptr) LogTuple<LogLabel::Insert, AbKeyType>{
@@ -151,7 +236,7 @@ namespace cc::courier_save {
 	public:
 		static bool log_space_enough(const LogSpace &log_space, const size_t log_size) {
 			const uint32_t total_size = log_size + sizeof(LogTuple<LogLabel::Commit, AbKeyType>);
-			if (total_size > LOG_PAGE_SIZE) [[unlikely]] {
+			if (total_size > LOG_PAGE_SIZE - LOG_PAGE_HEADER_SIZE) [[unlikely]] {
 				spdlog::error("The size of log for one transaction is larger than log page, require: {}", total_size);
 				exit(-1);
 			}
@@ -9,6 +9,7 @@
 #include <queue>
 #include <functional>
 
+#include <concurrent_control/delta_log.h>
 #include <concurrent_control/courier_save/log_persist.h>
 
 namespace cc::courier_save {
@@ -24,10 +25,13 @@ namespace cc::courier_save {
 		std::function<void(uint64_t, AbKey, uint32_t, uint32_t, const void *)> update_func_;
 		std::function<void(uint64_t, AbKey, uint32_t, const void *)> insert_func_;
 
+		/// Bytes of log scanned
+		uint64_t log_size_;
+
 	public:
 		RecoveryManager(std::function<void(uint64_t , AbKey, uint32_t, uint32_t, const void *)> update_func,
 				std::function<void(uint64_t, AbKey, uint32_t, const void *)> insert_func):
-			update_func_(update_func), insert_func_(insert_func) {}
+			update_func_(update_func), insert_func_(insert_func), log_size_(0) {}
 
 	public:
 		void recovery(uint64_t page_num, std::span<uint8_t> log_bitmap, std::span<uint8_t> log_pool) {
@@ -40,11 +44,20 @@ namespace cc::courier_save {
 			}
 		}
 
+		uint64_t get_log_size() const {
+			return log_size_;
+		}
+
 	private:
 		void recovery_page_iteration(const void *start_ptr) {
 			const void *end_ptr = static_cast<const uint8_t *>(start_ptr) + LOG_PAGE_SIZE;
 
-			const void *iter = start_ptr;
+			using LogPageHeader = typename LogPersistType::LogPageHeader;
+			const uint64_t generation = static_cast<const LogPageHeader *>(start_ptr)->generation_;
+
+			const void *iter = static_cast<const uint8_t *>(start_ptr) + LogPersistType::LOG_PAGE_HEADER_SIZE;
+			// The end of valid log in this page
+			const void *scan_end_ptr = end_ptr;
 
 			std::queue<std::function<void()>> recovery_queue;
 
@@ -53,6 +66,12 @@ namespace cc::courier_save {
 
 				switch (abstract_log_tuple_ptr->label_) {
 					case LogLabel::Commit:
+						// Stale log left by a former use of the page
+						if (static_cast<const LogTuple<LogLabel::Commit, AbKey> *>(iter)->ts_ != generation) {
+							scan_end_ptr = iter;
+							iter = end_ptr;
+							break;
+						}
 						while (!recovery_queue.empty()) {
 							recovery_queue.front()();
 							recovery_queue.pop();
@@ -71,6 +90,21 @@ namespace cc::courier_save {
 						iter = static_cast<const uint8_t *>(iter) + size;
 						break;
 					}
+					case LogLabel::DeltaUpdate: {
+						auto log_tuple_ptr = static_cast<const LogTuple<LogLabel::DeltaUpdate, AbKey> *>(iter);
+						auto size = log_tuple_ptr->size_ + sizeof(LogTuple<LogLabel::DeltaUpdate, AbKey>);
+
+						// Replay each run of changed bytes as a partial update
+						recovery_queue.push([=, this]{
+							for_each_delta_run(log_tuple_ptr->extra_info_, log_tuple_ptr->size_,
+							                   [&](uint32_t run_offset, uint32_t run_size, const uint8_t *run_ptr) {
+								update_func_(log_tuple_ptr->ts_, log_tuple_ptr->key_, run_size, log_tuple_ptr->offset_ + run_offset, run_ptr);
+							});
+						});
+
+						iter = static_cast<const uint8_t *>(iter) + size;
+						break;
+					}
 					case LogLabel::Insert: {
 						auto log_tuple_ptr = static_cast<const LogTuple<LogLabel::Insert, AbKey> *>(iter);
 						auto size = log_tuple_ptr->size_ + sizeof(LogTuple<LogLabel::Insert, AbKey>);
@@ -84,9 +118,11 @@ namespace cc::courier_save {
 					}
 
 					default: // Unrecognized Label
+						scan_end_ptr = iter;
 						iter = end_ptr;
 				}
 			}
+			log_size_ += static_cast<const uint8_t *>(scan_end_ptr) - static_cast<const uint8_t *>(start_ptr);
 
 		}
 
@@ -104,7 +140,7 @@ namespace cc::courier_save {
 	public:
 		RecoveryTransaction(): size_(0), offset_(0), ts_(0), data_ptr_(nullptr) {}
 
-		RecoveryTransaction(AbKey key, uint32_t size, uint32_t offset, uint32_t ts, uint8_t *data_ptr):
+		RecoveryTransaction(AbKey key, uint32_t size, uint32_t offset, uint64_t ts, uint8_t *data_ptr):
 			key_(key), size_(size), offset_(offset), ts_(ts), data_ptr_(data_ptr) {}
 
 		RecoveryTransaction(const RecoveryTransaction &other) noexcept :
@@ -121,6 +157,10 @@ namespace cc::courier_save {
 		}
 
 	public:
+		uint64_t get_ts() const {
+			return ts_;
+		}
+
 		template<class Executor>
 		bool run(Executor &executor) {
 			return executor.update(key_, data_ptr_ - offset_, size_, offset_);
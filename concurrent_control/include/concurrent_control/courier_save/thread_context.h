@@ -13,9 +13,11 @@
 namespace cc::courier_save {
 
 	struct LogSpace {
-		uint8_t *start_ptr;
-		uint8_t *cur_ptr;
-		uint8_t *end_ptr;
+		uint8_t *start_ptr{nullptr};
+		uint8_t *cur_ptr{nullptr};
+		uint8_t *end_ptr{nullptr};
+		/// Generation of the page, stamped on commit logs to tell them from stale ones of former uses
+		uint64_t generation{0};
 	};
 
 	//! @brief Information about delayed data persisting.
@@ -7,10 +7,12 @@
 
 #include <cstdint>
 #include <vector>
+#include <algorithm>
 #include <utility>
 
 #include <concurrent_control/abstract_concurrent_control.h>
 #include <concurrent_control/config.h>
+#include <concurrent_control/delta_log.h>
 #include <concurrent_control/courier_save/data_tuple.h>
 #include <concurrent_control/courier_save/vheader_cache.h>
 #include <concurrent_control/courier_save/log.h>
@@ -163,6 +165,11 @@ namespace cc::courier_save {
 		}
 
 		void *access_write(const AbKeyType &key, IndexTupleType &tuple, uint32_t size, uint32_t offset) {
+			// A tuple written repeatedly keeps one entry, so that its log is diffed against the pre-image once
+			if (WriteEntry *entry_ptr = find_write_entry(key); entry_ptr != nullptr) {
+				merge_write_range(*entry_ptr, size, offset);
+				return entry_ptr->data_ptr;
+			}
 			uint32_t data_size = tuple.get_data_size();
 			// Allocate a temp space storing data
 			uint8_t *data_buffer = new uint8_t[data_size];
@@ -188,8 +195,8 @@ namespace cc::courier_save {
 					.tuple    = tuple
 				}
 			);
-			// Register log
-			log_info_size_ += sizeof(LogTuple<LogLabel::Update, AbKeyType>) + size;
+			// Register log, reserving space for the maximal delta
+			log_info_size_ += sizeof(LogTuple<LogLabel::DeltaUpdate, AbKeyType>) + get_max_delta_size(size);
 
 			return data_buffer;
 		}
@@ -232,6 +239,23 @@ namespace cc::courier_save {
 		uint32_t get_log_amount_size() const {
 			return log_info_size_;
 		}
+
+	private:
+		WriteEntry *find_write_entry(const AbKeyType &key) {
+			for (WriteEntry &entry: write_set_) {
+				if (entry.type == TxType::Write && entry.key == key) { return &entry; }
+			}
+			return nullptr;
+		}
+
+		//! @brief Extend the range of an update to cover another write, bytes in between are the same as the pre-image.
+		void merge_write_range(WriteEntry &entry, uint32_t size, uint32_t offset) {
+			const uint32_t end = std::max(entry.offset + entry.size, offset + size);
+			log_info_size_ -= get_max_delta_size(entry.size);
+			entry.offset    = std::min(entry.offset, offset);
+			entry.size      = end - entry.offset;
+			log_info_size_ += get_max_delta_size(entry.size);
+		}
 	};
 
 }
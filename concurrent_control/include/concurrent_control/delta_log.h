@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace cc {
+
+	/*!
+	 * @brief Header of a run of changed bytes in a delta-encoded update log.
+	 * A delta consists of runs placed one after another, each followed by its new content.
+	 * Runs hold new bytes rather than xor with the pre-image, so that replaying a delta is idempotent
+	 * and independent of whether the data tuple has been persisted.
+	 */
+	struct DeltaRunHeader {
+		/// Offset of run relative to the start of update
+		uint32_t offset_;
+		/// The length of run
+		uint32_t size_;
+	};
+
+	/*!
+	 * @brief Runs with unchanged bytes fewer than a run header in between are merged,
+	 * so that the encoded size never exceeds the raw size plus one run header.
+	 */
+	inline constexpr uint32_t DELTA_MERGE_GAP = sizeof(DeltaRunHeader);
+
+	//! @brief The maximum size of delta encoding an update of such size.
+	inline constexpr uint32_t get_max_delta_size(uint32_t size) {
+		return size + sizeof(DeltaRunHeader);
+	}
+
+	/*!
+	 * @brief Encode changed bytes between the new content and the pre-image.
+	 * @param dst Space for delta, which should be no smaller than get_max_delta_size(size)
+	 * @param new_ptr New content of update
+	 * @param old_ptr Pre-image of update
+	 * @param size Size of update
+	 * @return Size of delta
+	 */
+	inline uint32_t encode_delta(void *dst, const void *new_ptr, const void *old_ptr, uint32_t size) {
+		auto *dst_ptr       = static_cast<uint8_t *>(dst);
+		auto *new_bytes     = static_cast<const uint8_t *>(new_ptr);
+		auto *old_bytes     = static_cast<const uint8_t *>(old_ptr);
+		uint32_t delta_size = 0;
+
+		uint32_t idx = 0;
+		while (idx < size) {
+			// Skip unchanged bytes
+			while (idx < size && new_bytes[idx] == old_bytes[idx]) { ++idx; }
+			if (idx == size) { break; }
+
+			// Extend the run until enough unchanged bytes are met
+			const uint32_t run_start = idx;
+			uint32_t run_end = idx + 1, gap = 0;
+			for (++idx; idx < size && gap < DELTA_MERGE_GAP; ++idx) {
+				if (new_bytes[idx] != old_bytes[idx]) {
+					run_end = idx + 1;
+					gap     = 0;
+				}
+				else {
+					++gap;
+				}
+			}
+
+			const DeltaRunHeader run_header { .offset_ = run_start, .size_ = run_end - run_start };
+			std::memcpy(dst_ptr + delta_size, &run_header, sizeof(DeltaRunHeader));
+			std::memcpy(dst_ptr + delta_size + sizeof(DeltaRunHeader), new_bytes + run_start, run_header.size_);
+			delta_size += sizeof(DeltaRunHeader) + run_header.size_;
+		}
+		return delta_size;
+	}
+
+	/*!
+	 * @brief Iterate runs of a delta.
+	 * @param delta_ptr Start of delta
+	 * @param delta_size Size of delta
+	 * @param func Callback with the offset, size and content of each run
+	 */
+	template<class Func>
+	inline void for_each_delta_run(const void *delta_ptr, uint32_t delta_size, Func &&func) {
+		auto *delta_bytes = static_cast<const uint8_t *>(delta_ptr);
+		uint32_t idx = 0;
+		while (idx + sizeof(DeltaRunHeader) <= delta_size) {
+			DeltaRunHeader run_header;
+			std::memcpy(&run_header, delta_bytes + idx, sizeof(DeltaRunHeader));
+			func(run_header.offset_, run_header.size_, delta_bytes + idx + sizeof(DeltaRunHeader));
+			idx += sizeof(DeltaRunHeader) + run_header.size_;
+		}
+	}
+
+	//! @brief Apply a delta to the content of update.
+	inline void apply_delta(void *dst, const void *delta_ptr, uint32_t delta_size) {
+		for_each_delta_run(delta_ptr, delta_size, [dst](uint32_t offset, uint32_t size, const uint8_t *run_ptr) {
+			std::memcpy(static_cast<uint8_t *>(dst) + offset, run_ptr, size);
+		});
+	}
+
+}
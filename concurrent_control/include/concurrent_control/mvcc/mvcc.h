@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include <util/latency_counter.h>
+#include <util/latency_histogram.h>
 #include <spdlog/spdlog.h>
 #include <thread/thread.h>
 
@@ -189,7 +189,10 @@ namespace cc {
 				if (data_ptr != nullptr) { return data_ptr; }
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return nullptr;
+				}
 				// Read timestamp before copying data.
 				// Correspondingly, we will write data before write timestamp in write phase.
 				// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -209,7 +212,10 @@ namespace cc {
 			void *update(Context &tx_context, const AbKeyType &key) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return nullptr;
+				}
 				// Read timestamp before copying data.
 				// Correspondingly, we will write data before write timestamp in write phase.
 				// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -228,7 +234,10 @@ namespace cc {
 			void *update(Context &tx_context, const AbKeyType &key, uint32_t size, uint32_t offset) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return nullptr;
+				}
 				// Read timestamp before copying data.
 				// Correspondingly, we will write data before write timestamp in write phase.
 				// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -247,7 +256,10 @@ namespace cc {
 			bool insert(Context &tx_context, const AbKeyType &key, const void *row, uint32_t size) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (read_index(tx_context, key, temp_index_tuple)) { return false; }
+				if (read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyExists);
+					return false;
+				}
 				// There is no such tuple reference to get from index
 				return tx_context.access_insert(key, row, size);
 			}
@@ -261,7 +273,10 @@ namespace cc {
 			bool remove(Context &tx_context, const AbKeyType &key) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return false; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return false;
+				}
 				// There is no such tuple reference to get from index
 				return tx_context.access_delete(key, temp_index_tuple);
 			}
@@ -298,6 +313,7 @@ namespace cc {
 						DataTupleHeaderType *data_header_ptr = origin_tuple.get_data_header_ptr();
 
 						if (!data_header_ptr->validate_update(tx_context.start_ts_)) {
+							get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 							success_validate = false;
 							break;
 						}
@@ -306,6 +322,7 @@ namespace cc {
 						++lock_num;
 
 						if (!data_header_ptr->validate_update(tx_context.start_ts_)) {
+							get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 							success_validate = false;
 							break;
 						}
@@ -350,7 +367,7 @@ namespace cc {
 			 * @return Always true
 			 */
 			bool abort(Context &tx_context) {
-				get_thread_message().abort_transaction();
+				get_thread_message().abort_transaction(tx_context.message_);
 				return clean_up(tx_context);
 			}
 
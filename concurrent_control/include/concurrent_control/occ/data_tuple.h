@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <shared_mutex>
 
 #include <thread/rwlock.h>
@@ -17,6 +18,10 @@ namespace cc::occ {
 	private:
 		using Self = DataTupleHeader;
 
+	public:
+		/// Timestamp of a tuple moved to another block, which never matches any timestamp read before
+		static constexpr uint64_t MIGRATED_WTS = std::numeric_limits<uint64_t>::max();
+
 	public:
 		std::atomic<uint64_t> wts_;
 
@@ -59,11 +64,20 @@ namespace cc::occ {
 
 		void *data_ptr_;
 
+		/// Durable copy of a tuple cached in volatile memory, which receives every write as well
+		void *home_data_ptr_;
+
+	public:
+		/// Readers validate timestamps on commit, so that tuples can be moved under them
+		static constexpr bool VALIDATE_ON_COMMIT = true;
+
 	public:
-		IndexTuple(): data_type_(-1), data_size_(0), data_header_ptr_(nullptr), data_ptr_(nullptr) {}
+		IndexTuple(): data_type_(-1), data_size_(0), data_header_ptr_(nullptr), data_ptr_(nullptr), home_data_ptr_(nullptr) {}
 
-		IndexTuple(uint32_t data_type, uint32_t data_size, DataTupleHeaderType *data_header_ptr, void *data_ptr) :
-				data_type_(data_type), data_size_(data_size), data_header_ptr_(data_header_ptr), data_ptr_(data_ptr) {}
+		IndexTuple(uint32_t data_type, uint32_t data_size, DataTupleHeaderType *data_header_ptr, void *data_ptr,
+		           void *home_data_ptr = nullptr) :
+				data_type_(data_type), data_size_(data_size), data_header_ptr_(data_header_ptr), data_ptr_(data_ptr),
+				home_data_ptr_(home_data_ptr) {}
 
 		IndexTuple(const Self &other) = default;
 
@@ -95,11 +109,48 @@ namespace cc::occ {
 	public:
 		void *get_data_ptr() const { return data_ptr_; }
 
+		void *get_home_data_ptr() const { return home_data_ptr_; }
+
+		//! @brief Get the copy which should be written back for durability.
+		void *get_persist_data_ptr() const { return home_data_ptr_ == nullptr ? data_ptr_ : home_data_ptr_; }
+
+	public:
+		/*!
+		 * @brief Copy the tuple into a cache block, keeping the origin as its home.
+		 * It should be called with the write lock held.
+		 */
+		Self make_cached(DataTupleHeaderType *new_header_ptr, void *new_data_ptr) const {
+			new (new_header_ptr) DataTupleHeaderType(get_wts_ref().load(std::memory_order::acquire));
+			std::memcpy(new_data_ptr, data_ptr_, data_size_);
+			return { data_type_, data_size_, new_header_ptr, new_data_ptr, data_ptr_ };
+		}
+
+		//! @brief Get the tuple over the home of a cached tuple, whose header is given by data manager.
+		Self get_home_tuple(DataTupleHeaderType *home_header_ptr) const {
+			return { data_type_, data_size_, home_header_ptr, home_data_ptr_ };
+		}
+
+		//! @brief Hand the timestamp of a cached tuple to its home, with write locks of both held.
+		void write_back_version(const Self &home_tuple) const {
+			home_tuple.get_wts_ref().store(get_wts_ref().load(std::memory_order::acquire), std::memory_order::release);
+		}
+
+		//! @brief Invalidate the origin after migration, so that transactions having read it will abort.
+		void invalidate_migrated() const {
+			get_wts_ref().store(DataTupleHeaderType::MIGRATED_WTS, std::memory_order::release);
+		}
+
 	public:
 		void set_data(void *new_data_ptr, uint32_t size, uint32_t offset) const {
 			std::memcpy(static_cast<uint8_t *>(data_ptr_) + offset,
 						static_cast<uint8_t *>(new_data_ptr) + offset,
 						size);
+			// Write through to the home of a cached tuple
+			if (home_data_ptr_ != nullptr) {
+				std::memcpy(static_cast<uint8_t *>(home_data_ptr_) + offset,
+				            static_cast<uint8_t *>(new_data_ptr) + offset,
+				            size);
+			}
 		}
 	};
 
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <concurrent_control/abstract_concurrent_control.h>
 #include <concurrent_control/occ/tx_context.h>
 
@@ -67,9 +69,20 @@ namespace cc::occ {
 		 * @return Whether reading is successful
 		 */
 		bool read(const AbKeyType &key, void *output_ptr, size_t size, size_t offset) {
-			const uint8_t *data_ptr = (const uint8_t *)cc_ptr_->read(context_, key);
-			if (data_ptr == nullptr) { return false; }
-			std::memcpy(output_ptr, data_ptr + offset, size);
+			if constexpr (CCType::VARIABLE_LENGTH) {
+				// Copy no more than the payload of a variable-length tuple
+				uint32_t payload_size;
+				const uint8_t *data_ptr = (const uint8_t *)cc_ptr_->read(context_, key, payload_size);
+				if (data_ptr == nullptr) { return false; }
+				if (offset < payload_size) {
+					std::memcpy(output_ptr, data_ptr + offset, std::min<size_t>(size, payload_size - offset));
+				}
+			}
+			else {
+				const uint8_t *data_ptr = (const uint8_t *)cc_ptr_->read(context_, key);
+				if (data_ptr == nullptr) { return false; }
+				std::memcpy(output_ptr, data_ptr + offset, size);
+			}
 			return true;
 		}
 
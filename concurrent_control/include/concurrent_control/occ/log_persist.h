@@ -10,8 +10,15 @@
 #include <atomic>
 #include <span>
 #include <optional>
+#include <vector>
+#include <memory>
+#include <algorithm>
 
+#include <thread/thread.h>
 #include <memory/flush.h>
+#include <memory/cache_config.h>
+
+#include <concurrent_control/delta_log.h>
 
 namespace cc::occ {
 
@@ -20,7 +27,9 @@ namespace cc::occ {
 		Insert,
 		Update,
 		Delete,
-		Commit
+		Commit,
+		/// Update with runs of changed bytes only, see delta_log.h
+		DeltaUpdate
 	};
 
 	template<LogLabel Label, class AbKey>
@@ -85,26 +94,58 @@ namespace cc::occ {
 	public:
 		using AbKeyType = AbKey;
 
+	private:
+		/// Bump allocator over one stripe of log space
+		struct alignas(CACHE_LINE_SIZE) StripeCursor {
+			uint8_t *begin_;
+			uint8_t *end_;
+			std::atomic<uint8_t *> cur_bound_;
+		};
+
 	private:
 		// Assume the space is large enough to contain all logs.
 		std::span<uint8_t> log_space_range_;
 
-		std::atomic<uint8_t *> cur_bound_;
+		/// The number of stripes(PMEM namespaces) the log space consists of
+		uint32_t stripe_num_;
+
+		std::unique_ptr<StripeCursor[]> stripe_cursor_;
 
 	public:
-		LogPersist(std::span<uint8_t> log_space_range): log_space_range_(log_space_range), cur_bound_(log_space_range.data()) {}
+		/*!
+		 * @param log_space_range Log space
+		 * @param stripe_num The number of equal-sized stripes of log space, each on its own NUMA node
+		 */
+		LogPersist(std::span<uint8_t> log_space_range, uint32_t stripe_num = 1):
+				log_space_range_(log_space_range),
+				stripe_num_(std::max(stripe_num, 1U)),
+				stripe_cursor_(std::make_unique<StripeCursor[]>(stripe_num_)) {
+			const size_t stripe_size = log_space_range.size() / stripe_num_;
+			for (uint32_t i = 0; i < stripe_num_; ++i) {
+				StripeCursor &cursor = stripe_cursor_[i];
+				cursor.begin_ = log_space_range.data() + i * stripe_size;
+				cursor.end_   = (i + 1 == stripe_num_) ? log_space_range.data() + log_space_range.size() : cursor.begin_ + stripe_size;
+				cursor.cur_bound_.store(cursor.begin_, std::memory_order::relaxed);
+			}
+		}
 
 		~LogPersist() = default;
 
 	private:
+		//! @brief Get the stripe local to the calling thread.
+		StripeCursor &get_local_stripe() {
+			if (stripe_num_ == 1 || !thread::is_registered()) { return stripe_cursor_[0]; }
+			return stripe_cursor_[static_cast<uint32_t>(thread::get_cpu_numa_id()) % stripe_num_];
+		}
+
 		uint8_t *allocate_log_space(size_t expected_size) {
-			uint8_t *start_ptr = log_space_range_.data();
+			// Wrap to the beginning of the local stripe when it is full
+			StripeCursor &cursor = get_local_stripe();
+			uint8_t *start_ptr;
 			while (true) {
-				uint8_t *log_ptr = cur_bound_.load(std::memory_order::relaxed);
-				if (log_ptr + expected_size < std::addressof(log_space_range_.back())) {
-					start_ptr = log_ptr;
-				}
-				if (cur_bound_.compare_exchange_weak(log_ptr, start_ptr + expected_size)) { break; }
+				uint8_t *log_ptr = cursor.cur_bound_.load(std::memory_order::relaxed);
+				start_ptr = (log_ptr + expected_size < cursor.end_) ? log_ptr : cursor.begin_;
+				if (cursor.cur_bound_.compare_exchange_weak(log_ptr, start_ptr + expected_size)) { break; }
 			}
 			return start_ptr;
 		}
@@ -150,11 +191,46 @@ namespace cc::occ {
 					.size_ = size,
 					.offset_ = offset
 			};
-			std::memcpy(log_tuple_ptr->extra_info_ + offset, static_cast<const uint8_t *>(src) + offset, size);
+			std::memcpy(log_tuple_ptr->extra_info_, static_cast<const uint8_t *>(src) + offset, size);
 			clflushopt_range(log_tuple_ptr, sizeof(LogTuple<LogLabel::Update, AbKeyType>) + size);
 			sfence();
 		}
 
+		/*!
+		 * @brief Log only runs of bytes differing from the pre-image, or the whole content if it is not smaller.
+		 * @param src New content, which should have been moved by corresponding offset
+		 * @param origin_src Pre-image, which should have been moved by corresponding offset
+		 * @return Size of log tuple written
+		 */
+		uint32_t add_delta_update_log(uint64_t ts, AbKey key, const void *src, const void *origin_src, uint32_t size, uint32_t offset) {
+			// Encode in a local buffer first, so that no more log space than needed is taken
+			thread_local std::vector<uint8_t> delta_buffer;
+			delta_buffer.resize(std::max<size_t>(delta_buffer.size(), get_max_delta_size(size)));
+
+			const uint32_t delta_size = encode_delta(delta_buffer.data(),
+			                                         static_cast<const uint8_t *>(src) + offset,
+			                                         static_cast<const uint8_t *>(origin_src) + offset,
+			                                         size);
+			if (delta_size >= size) {
+				add_update_log(ts, key, src, size, offset);
+				return sizeof(LogTuple<LogLabel::Update, AbKeyType>) + size;
+			}
+
+			const uint32_t log_size = sizeof(LogTuple<LogLabel::DeltaUpdate, AbKeyType>) + delta_size;
+			auto *log_tuple_ptr = (LogTuple<LogLabel::DeltaUpdate, AbKeyType> *)allocate_log_space(log_size);
+			new (log_tuple_ptr) LogTuple<LogLabel::DeltaUpdate, AbKeyType>{
+					.label_ = LogLabel::DeltaUpdate,
+					.ts_ = ts,
+					.key_ = key,
+					.size_ = delta_size,
+					.offset_ = offset
+			};
+			std::memcpy(log_tuple_ptr->extra_info_, delta_buffer.data(), delta_size);
+			clflushopt_range(log_tuple_ptr, log_size);
+			sfence();
+			return log_size;
+		}
+
 		void add_insert_log(uint64_t ts, AbKey key, const void *src, uint32_t size) {
 			auto *log_tuple_ptr = (LogTuple<LogLabel::Insert, AbKeyType> *)allocate_log_space(sizeof(LogTuple<LogLabel::Insert, AbKeyType>) + size);
 			new (log_tuple_ptr) LogTuple<LogLabel::Insert, AbKeyType>{
@@ -5,11 +5,17 @@
 
 #pragma once
 
-#include <util/latency_counter.h>
+#include <array>
+#include <mutex>
+
+#include <util/latency_histogram.h>
 #include <spdlog/spdlog.h>
+#include <memory/cache_config.h>
 #include <thread/thread.h>
+#include <thread/epoch_manager.h>
 
 #include <concurrent_control/abstract_concurrent_control.h>
+#include <concurrent_control/conflict_tracker.h>
 
 #include <concurrent_control/occ/data_tuple.h>
 #include <concurrent_control/occ/tx_context.h>
@@ -50,6 +56,17 @@ namespace cc::occ {
 
 		using ExecutorType        = Executor<Self, AbKeyType>;
 
+		/// Whether tuples are stored by the actual length of payload
+		static constexpr bool VARIABLE_LENGTH = []() {
+			if constexpr (requires { WorkloadType::VARIABLE_LENGTH_TUPLE; }) { return WorkloadType::VARIABLE_LENGTH_TUPLE; }
+			else { return false; }
+		}();
+
+		static constexpr bool SUPPORT_VARIABLE_LENGTH_TUPLE = true;
+
+		/// Log only bytes changed by updates, off to keep the original full-tuple log
+		static constexpr bool DELTA_UPDATE_LOG = false;
+
 		static_assert(AbstractKeyConcept<AbKeyType>);
 		static_assert(ExecutorConcept<ExecutorType>);
 
@@ -65,20 +82,38 @@ namespace cc::occ {
 
 		LogPersist<AbKeyType> log_persist_;
 
+	private:
+		/// Tuples unlinked by one thread, waiting for optimistic readers to drop them
+		struct alignas(CACHE_LINE_SIZE) RetireSlot {
+			thread::EpochRetireList<IndexTupleType> retire_list;
+		};
+
+		std::array<RetireSlot, thread::get_max_tid()> retire_slot_array_;
+
+		/// Slot shared by threads without tid
+		RetireSlot shared_retire_slot_;
+
+		std::mutex shared_retire_lock_;
+
 	public: // Class Property
 
 		explicit OCC(StorageManager *storage_manager_ptr): time_counter(0),
-				storage_manager_ptr_(storage_manager_ptr), log_persist_(storage_manager_ptr->get_log_space_range()) {
+				storage_manager_ptr_(storage_manager_ptr), log_persist_(storage_manager_ptr->get_log_space_range(), storage_manager_ptr->get_log_space_stripe_num()) {
 			spdlog::warn("Atomic version of OCC can't make sure that data read is integral when running transaction, "
 						"but this inconsistency will be detected when validating.");
 
 			storage_manager_ptr_->register_data_deallocate_func([&](const IndexTupleType &index_tuple) {
-				void *data_ptr = index_tuple.get_data_ptr();
-				storage_manager_ptr_->deallocate_data_and_header(index_tuple.get_data_type(), data_ptr);
+				deallocate_tuple(index_tuple);
 			});
 		}
 
 		~OCC() {
+			auto free_func = [this](const IndexTupleType &index_tuple) { deallocate_tuple(index_tuple); };
+			for (RetireSlot &slot: retire_slot_array_) {
+				slot.retire_list.drain(free_func);
+			}
+			shared_retire_slot_.retire_list.drain(free_func);
+
 			get_concurrent_control_message().clear_up();
 		}
 
@@ -118,6 +153,32 @@ namespace cc::occ {
 			return executor;
 		}
 
+		/*!
+		 * @brief Get executor for a transaction whose conflicts are excluded by a deterministic scheduler.
+		 * It skips validation of timestamps in commitment, which fails only if accessed tuples are migrated.
+		 * @return Executor with initialized context of transaction
+		 */
+		ExecutorType get_scheduled_executor() {
+			ExecutorType executor(this);
+			executor.get_context().scheduled_ = true;
+			init_tx(executor.get_context());
+			return executor;
+		}
+
+		/*!
+		 * @brief Get data of a tuple without recording it, for schedulers analysing access sets of transactions.
+		 * It should be called while no transaction commits.
+		 * @param key Abstract key of data tuple
+		 * @param payload_size Size of the tuple
+		 * @return The pointer to data, nullptr if there is no such tuple
+		 */
+		const void *peek(const AbKeyType &key, uint32_t &payload_size) {
+			IndexTupleType index_tuple;
+			if (!storage_manager_ptr_->read_data_index_tuple(key.type_, key.logic_key_, index_tuple)) { return nullptr; }
+			payload_size = index_tuple.get_data_size();
+			return index_tuple.get_data_ptr();
+		}
+
 	private:
 		uint64_t get_new_wts() {
 			return ++time_counter;
@@ -133,6 +194,7 @@ namespace cc::occ {
 			tx_context.message_.start_total();
 			tx_context.message_.start_running();
 			tx_context.status_ = Context::Status::Running;
+			tx_context.epoch_guard_.enter();
 			return true;
 		}
 
@@ -154,6 +216,7 @@ namespace cc::occ {
 				default:
 					break;
 			}
+			tx_context.epoch_guard_.leave();
 			return true;
 		}
 
@@ -175,7 +238,10 @@ namespace cc::occ {
 			if (data_ptr != nullptr) { return data_ptr; }
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 			// Read timestamp before copying data.
 			// Correspondingly, we will write data before write timestamp in write phase.
 			// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -184,6 +250,30 @@ namespace cc::occ {
 		}
 
 
+		/*!
+		 * @brief Read operation, getting the size of payload as well
+		 * @param tx_context Context of transaction
+		 * @param key Abstract key of data tuple
+		 * @param payload_size The size of valid data, which is less than the size of tuple for variable-length tuples
+		 * @return Whether reading is successful
+		 */
+		void *read(Context &tx_context, const AbKeyType &key, uint32_t &payload_size) {
+			// Look up write set
+			const WriteEntryType *entry_ptr = tx_context.look_up_write_entry(key);
+			if (entry_ptr != nullptr) {
+				payload_size = entry_ptr->get_payload_size();
+				return entry_ptr->data_ptr;
+			}
+			// Index reading
+			IndexTupleType temp_index_tuple;
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
+			payload_size = temp_index_tuple.get_data_size();
+			return tx_context.access_read(key, temp_index_tuple);
+		}
+
 		/*!
 		 * @brief Update operation
 		 * @param tx_context Context of transaction
@@ -193,7 +283,10 @@ namespace cc::occ {
 		void *update(Context &tx_context, const AbKeyType &key) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 			// Read timestamp before copying data.
 			// Correspondingly, we will write data before write timestamp in write phase.
 			// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -212,7 +305,10 @@ namespace cc::occ {
 		void *update(Context &tx_context, const AbKeyType &key, uint32_t size, uint32_t offset) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 			// Read timestamp before copying data.
 			// Correspondingly, we will write data before write timestamp in write phase.
 			// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -231,7 +327,10 @@ namespace cc::occ {
 		bool insert(Context &tx_context, const AbKeyType &key, const void *row, uint32_t size) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (read_index(tx_context, key, temp_index_tuple)) { return false; }
+			if (read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyExists);
+				return false;
+			}
 			// There is no such tuple reference to get from index
 			return tx_context.access_insert(key, row, size);
 		}
@@ -245,7 +344,10 @@ namespace cc::occ {
 		bool remove(Context &tx_context, const AbKeyType &key) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) { return false; }
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return false;
+			}
 			// There is no such tuple reference to get from index
 			return tx_context.access_delete(key, temp_index_tuple);
 		}
@@ -277,6 +379,10 @@ namespace cc::occ {
 			bool success_validate = true;
 			int lock_num = 0;
 
+			// Transactions scheduled deterministically never run concurrently with conflicting ones,
+			// so that only migration of tuples may invalidate what they accessed.
+			const bool check_wts = !tx_context.scheduled_;
+
 			if (has_write) {
 				// According to the comparison rule, write tx should be ahead of read tx with the same key
 				std::sort(write_set.begin(), write_set.end());
@@ -287,7 +393,11 @@ namespace cc::occ {
 					// Avoid locking the same tuple repeatedly
 					++lock_num;
 					origin_tuple.lock_write();
-					if (entry.wts != origin_tuple.get_wts_ref().load(std::memory_order_acquire)) {
+					uint64_t wts = origin_tuple.get_wts_ref().load(std::memory_order_acquire);
+					if ((check_wts && entry.wts != wts) || wts == DataTupleHeaderType::MIGRATED_WTS
+					    || storage_manager_ptr_->is_data_tuple_migrated(entry.key.type_, origin_tuple)) {
+						ConflictTracker::get_thread_tracker().record_conflict(entry.key);
+						get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 						success_validate = false;
 						break;
 					}
@@ -302,6 +412,8 @@ namespace cc::occ {
 						if (!origin_tuple.try_lock_read()) {
 							// Avoid repeated tuple in a read set and a write set
 							if (!tx_context.look_up_write_set(entry.key)) {
+								ConflictTracker::get_thread_tracker().record_conflict(entry.key);
+								get_thread_message().set_abort_reason(AbortReason::Locked);
 								success_validate = false;
 								break;
 							}
@@ -311,8 +423,11 @@ namespace cc::occ {
 						}
 
 						uint64_t wts = origin_tuple.get_wts_ref().load(std::memory_order::acquire);
+						bool migrated = storage_manager_ptr_->is_data_tuple_migrated(entry.key.type_, origin_tuple);
 						origin_tuple.unlock_read();
-						if (entry.wts != wts) {
+						if ((check_wts && entry.wts != wts) || wts == DataTupleHeaderType::MIGRATED_WTS || migrated) {
+							ConflictTracker::get_thread_tracker().record_conflict(entry.key);
+							get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 							success_validate = false;
 							break;
 						}
@@ -338,6 +453,9 @@ namespace cc::occ {
 				}
 			}
 
+			tx_context.epoch_guard_.leave();
+			// Free tuples unlinked by this or former transactions once no reader holds them
+			retire_tuples(tx_context);
 			tx_context.message_.end_commit();
 			tx_context.message_.end_total();
 
@@ -350,7 +468,7 @@ namespace cc::occ {
 		 * @return Always true
 		 */
 		bool abort(Context &tx_context) {
-			get_thread_message().abort_transaction();
+			get_thread_message().abort_transaction(tx_context.message_);
 			return clean_up(tx_context);
 		}
 
@@ -380,25 +498,51 @@ namespace cc::occ {
 
 			auto [log_amount, log_size] = tx_context.get_log_amount_size();
 
+			using StartLogType  = LogTuple<LogLabel::Start, AbKeyType>;
+			using CommitLogType = LogTuple<LogLabel::Commit, AbKeyType>;
+			using InsertLogType = LogTuple<LogLabel::Insert, AbKeyType>;
+			using UpdateLogType = LogTuple<LogLabel::Update, AbKeyType>;
+			using DeleteLogType = LogTuple<LogLabel::Delete, AbKeyType>;
+
+			uint64_t raw_log_size     = sizeof(StartLogType) + sizeof(CommitLogType);
+			uint64_t written_log_size = raw_log_size;
+
 			// ---- Write log
 			// Start
 			log_persist_.add_start_log(commit_ts);
 			// Insert
 			for (const InsertEntryType &entry: insert_set) {
 				log_persist_.add_insert_log(commit_ts, entry.key, entry.data_ptr, entry.size);
+				raw_log_size     += sizeof(InsertLogType) + entry.size;
+				written_log_size += sizeof(InsertLogType) + entry.size;
 			}
 			// Write
 			for (const WriteEntryType &entry: write_set) {
 				if (entry.type == TxType::Write) {
-					log_persist_.add_update_log(commit_ts, entry.key, entry.data_ptr, entry.size, entry.offset);
+					raw_log_size += sizeof(UpdateLogType) + entry.size;
+					// The tuple is locked, so the pre-image is the same as the one read,
+					// unless a variable-length tuple grows.
+					if (DELTA_UPDATE_LOG && entry.offset + entry.size <= entry.tuple.get_data_size()) {
+						written_log_size += log_persist_.add_delta_update_log(commit_ts, entry.key,
+						                                                      entry.data_ptr, entry.tuple.get_data_ptr(),
+						                                                      entry.size, entry.offset);
+					}
+					else {
+						log_persist_.add_update_log(commit_ts, entry.key, entry.data_ptr, entry.size, entry.offset);
+						written_log_size += sizeof(UpdateLogType) + entry.size;
+					}
 				}
 				else {
 					log_persist_.add_delete_log(commit_ts, entry.key);
+					raw_log_size     += sizeof(DeleteLogType);
+					written_log_size += sizeof(DeleteLogType);
 				}
 			}
 			// Commit
 			log_persist_.add_commit_log(commit_ts);
 
+			get_thread_message().record_log(raw_log_size, written_log_size);
+
 			tx_context.message_.end_persist_log();
 		}
 
@@ -430,7 +574,7 @@ namespace cc::occ {
 				auto size          = entry.size;
 
 				// Make header of data
-				auto [header_ptr, data_ptr] = storage_manager_ptr_->allocate_data_and_header(key.type_);
+				auto [header_ptr, data_ptr] = allocate_tuple(key.type_, size);
 				new(header_ptr) DataTupleHeaderType(commit_ts);
 				// Make index tuple of data and connect it with data header.
 				IndexTupleType index_tuple(key.type_, entry.size, header_ptr, data_ptr);
@@ -449,25 +593,31 @@ namespace cc::occ {
 				if (entry.type == TxType::Write) [[likely]] {
 					auto size          = entry.size;
 					auto offset        = entry.offset;
+
+					if constexpr (VARIABLE_LENGTH) {
+						// The payload outgrows the block, relocate it into a larger one
+						if (offset + size > origin_tuple.get_data_size()) {
+							relocate_tuple(tx_context, entry, commit_ts);
+							continue;
+						}
+					}
 					// Write data before write timestamp in write phase.
 					// Correspondingly, we will read timestamp before copying data.
 					// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
 					origin_tuple.set_data(entry.data_ptr, size, offset);
 					storage_manager_ptr_->pwb_range(
-							static_cast<uint8_t *>(origin_tuple.get_data_ptr()) + offset,
+							static_cast<uint8_t *>(origin_tuple.get_persist_data_ptr()) + offset,
 							size
 					);
 					storage_manager_ptr_->fence();
 					origin_tuple.get_wts_ref().store(commit_ts, std::memory_order_release);
-
-					break;
 				}
 				else if (entry.type == TxType::Delete) {
 					const AbKeyType &key = entry.key;
 
-					storage_manager_ptr_->deallocate_data_and_header(key.type_, origin_tuple.get_data_ptr());
 					storage_manager_ptr_->delete_data_index_tuple(key.type_, key.logic_key_);
-					break;
+					// Optimistic readers may still hold the tuple
+					tx_context.retired_set_.push_back(origin_tuple);
 				}
 			}
 
@@ -475,5 +625,76 @@ namespace cc::occ {
 
 			tx_context.message_.end_persist_data();
 		}
+
+		/*!
+		 * @brief Move a variable-length tuple into a block fitting its new payload.
+		 * The origin is invalidated but kept alive until no optimistic reader may hold it.
+		 * @param tx_context Context of transaction
+		 * @param entry Write entry whose payload grows
+		 * @param commit_ts Timestamp of the new tuple
+		 */
+		void relocate_tuple(Context &tx_context, const WriteEntryType &entry, uint64_t commit_ts) {
+			const AbKeyType &key        = entry.key;
+			const auto &origin_tuple    = entry.tuple;
+			const uint32_t payload_size = entry.get_payload_size();
+
+			auto [header_ptr, data_ptr] = allocate_tuple(key.type_, payload_size);
+			new(header_ptr) DataTupleHeaderType(commit_ts);
+			std::memcpy(data_ptr, entry.data_ptr, payload_size);
+			storage_manager_ptr_->pwb_range(header_ptr, sizeof(DataTupleHeaderType));
+			storage_manager_ptr_->pwb_range(data_ptr, payload_size);
+			storage_manager_ptr_->fence();
+
+			IndexTupleType new_tuple(key.type_, payload_size, header_ptr, data_ptr);
+			storage_manager_ptr_->update_data_index_tuple(key.type_, key.logic_key_, new_tuple);
+			origin_tuple.invalidate_migrated();
+
+			tx_context.retired_set_.push_back(origin_tuple);
+		}
+
+		/*!
+		 * @brief Retire tuples unlinked by the transaction and free those which no reader holds.
+		 * It should be called after the epoch of the transaction is left.
+		 * @param tx_context Context of transaction
+		 */
+		void retire_tuples(Context &tx_context) {
+			auto &retired_set = tx_context.retired_set_;
+			auto retire_func  = [this, &retired_set](RetireSlot &slot) {
+				slot.retire_list.retire(retired_set.begin(), retired_set.end());
+				slot.retire_list.reclaim([this](const IndexTupleType &index_tuple) { deallocate_tuple(index_tuple); });
+			};
+
+			if (!thread::is_registered()) [[unlikely]] {
+				std::lock_guard<std::mutex> guard(shared_retire_lock_);
+				retire_func(shared_retire_slot_);
+			}
+			else {
+				retire_func(retire_slot_array_[thread::get_tid()]);
+			}
+			retired_set.clear();
+		}
+
+		std::pair<DataTupleHeaderType *, void *> allocate_tuple(uint32_t data_type, uint32_t size) {
+			if constexpr (VARIABLE_LENGTH) {
+				auto [header_ptr, data_ptr] = storage_manager_ptr_->allocate_data_and_header(data_type, size);
+				return { static_cast<DataTupleHeaderType *>(header_ptr), data_ptr };
+			}
+			else {
+				auto [header_ptr, data_ptr] = storage_manager_ptr_->allocate_data_and_header(data_type);
+				return { static_cast<DataTupleHeaderType *>(header_ptr), data_ptr };
+			}
+		}
+
+		void deallocate_tuple(const IndexTupleType &index_tuple) {
+			if constexpr (VARIABLE_LENGTH) {
+				storage_manager_ptr_->deallocate_data_and_header(
+						index_tuple.get_data_type(), index_tuple.get_data_header_ptr(),
+						index_tuple.get_data_ptr(), index_tuple.get_data_size()
+				);
+			}
+			else {
+				storage_manager_ptr_->deallocate_data_and_header(index_tuple.get_data_type(), index_tuple.get_data_ptr());
+			}
+		}
 	};
 }
@@ -10,6 +10,10 @@
 #include <vector>
 #include <queue>
 #include <utility>
+#include <algorithm>
+#include <cstring>
+
+#include <thread/epoch_manager.h>
 
 #include <concurrent_control/config.h>
 #include <concurrent_control/occ/data_tuple.h>
@@ -48,6 +52,11 @@ namespace cc::occ {
 		auto operator <=> (const AccessEntry &other) const {
 			return key <=> other.key;
 		}
+
+		//! @brief Get the size of payload after writing, which grows if writing beyond a variable-length tuple.
+		uint32_t get_payload_size() const {
+			return std::max(tuple.get_data_size(), offset + size);
+		}
 	};
 
 	template<class AbKey>
@@ -124,9 +133,15 @@ namespace cc::occ {
 		std::vector<WriteEntry> write_set_;
 		/// For all insert elements
 		std::vector<InsertEntry> insert_set_;
+		/// For tuples relocated or deleted in commitment, freed once no optimistic reader holds them
+		std::vector<IndexTupleType> retired_set_;
+		/// Announcement of epoch, keeping tuples read from being freed until the end of execution
+		thread::EpochGuard epoch_guard_;
+		/// Whether conflicts of the transaction are excluded by a deterministic scheduler, skipping validation of timestamps
+		bool scheduled_;
 
 	public:
-		TxContext(): commit_ts_(0), log_info_size_(0), log_amount_(0) {
+		TxContext(): commit_ts_(0), log_info_size_(0), log_amount_(0), scheduled_(false) {
 			read_set_.reserve(64);
 			write_set_.reserve(16);
 		}
@@ -167,16 +182,22 @@ namespace cc::occ {
 			read_set_.clear();
 			write_set_.clear();
 			insert_set_.clear();
+			retired_set_.clear();
 
 			log_amount_ = log_info_size_ = 0;
 		}
 
 	public:
 		void *look_up_write_set(const AbKeyType &key) {
+			const WriteEntry *entry_ptr = look_up_write_entry(key);
+			return entry_ptr == nullptr ? nullptr : entry_ptr->data_ptr;
+		}
+
+		const WriteEntry *look_up_write_entry(const AbKeyType &key) const {
 			// According to partial principle
 			for (auto it = write_set_.crbegin(); it != write_set_.crend(); ++it) {
 				if (it->key == key) {
-					return it->data_ptr;
+					return &(*it);
 				}
 			}
 			return nullptr;
@@ -199,14 +220,21 @@ namespace cc::occ {
 		}
 
 		void *access_write(const AbKeyType &key, IndexTupleType &tuple, uint32_t size, uint32_t offset) {
-			// Allocate a temp space storing data
-			uint8_t *data_buffer = allocate_data_buffer(tuple.get_data_size());
+			// A tuple written repeatedly keeps one entry, so that it is locked once and its log is diffed against the pre-image once
+			if (WriteEntry *entry_ptr = find_write_entry(key); entry_ptr != nullptr) {
+				merge_write_range(*entry_ptr, size, offset);
+				return entry_ptr->data_ptr;
+			}
+			// Allocate a temp space storing data, which may be larger than a variable-length tuple
+			const uint32_t buffer_size = std::max(tuple.get_data_size(), offset + size);
+			uint8_t *data_buffer = allocate_data_buffer(buffer_size);
 			// Get wts from header of data tuple, read timestamp before data pointer
 			tuple.lock_read();
 			uint64_t wts = tuple.get_wts_ref().load(std::memory_order_acquire);
 			tuple.unlock_read();
 			// Read data
 			std::memcpy(data_buffer, tuple.get_data_ptr(), tuple.data_size_);
+			std::memset(data_buffer + tuple.data_size_, 0, buffer_size - tuple.data_size_);
 
 			write_set_.emplace_back(
 				WriteEntry {
@@ -265,5 +293,30 @@ namespace cc::occ {
 			};
 		}
 
+	private:
+		WriteEntry *find_write_entry(const AbKeyType &key) {
+			for (WriteEntry &entry: write_set_) {
+				if (entry.type == TxType::Write && entry.key == key) { return &entry; }
+			}
+			return nullptr;
+		}
+
+		//! @brief Extend the range of an update to cover another write, growing the buffer if the payload grows.
+		void merge_write_range(WriteEntry &entry, uint32_t size, uint32_t offset) {
+			const uint32_t buffer_size = entry.get_payload_size();
+			const uint32_t end         = std::max(entry.offset + entry.size, offset + size);
+			if (end > buffer_size) {
+				uint8_t *data_buffer = allocate_data_buffer(end);
+				std::memcpy(data_buffer, entry.data_ptr, buffer_size);
+				std::memset(data_buffer + buffer_size, 0, end - buffer_size);
+				deallocate_data_buffer(entry.data_ptr, buffer_size);
+				entry.data_ptr = data_buffer;
+			}
+			log_info_size_ -= entry.size;
+			entry.offset    = std::min(entry.offset, offset);
+			entry.size      = end - entry.offset;
+			log_info_size_ += entry.size;
+		}
+
 	};
 }
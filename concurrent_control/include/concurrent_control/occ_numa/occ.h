@@ -8,7 +8,7 @@
 #include <cstdint>
 #include <atomic>
 #include <array>
-#include <util/latency_counter.h>
+#include <util/latency_histogram.h>
 #include <spdlog/spdlog.h>
 #include <thread/thread.h>
 
@@ -196,7 +196,10 @@ namespace cc::occ_numa {
 			if (data_ptr != nullptr) { return data_ptr; }
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 			// Read timestamp before copying data.
 			// Correspondingly, we will write data before write timestamp in write phase.
 			// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -214,7 +217,10 @@ namespace cc::occ_numa {
 		void *update(Context &tx_context, const AbKeyType &key) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 			// Read timestamp before copying data.
 			// Correspondingly, we will write data before write timestamp in write phase.
 			// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -233,7 +239,10 @@ namespace cc::occ_numa {
 		void *update(Context &tx_context, const AbKeyType &key, uint32_t size, uint32_t offset) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 			// Read timestamp before copying data.
 			// Correspondingly, we will write data before write timestamp in write phase.
 			// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -252,7 +261,10 @@ namespace cc::occ_numa {
 		bool insert(Context &tx_context, const AbKeyType &key, const void *row, uint32_t size) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (read_index(tx_context, key, temp_index_tuple)) { return false; }
+			if (read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyExists);
+				return false;
+			}
 			// There is no such tuple reference to get from index
 			return tx_context.access_insert(key, row, size);
 		}
@@ -266,7 +278,10 @@ namespace cc::occ_numa {
 		bool remove(Context &tx_context, const AbKeyType &key) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) { return false; }
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return false;
+			}
 			// There is no such tuple reference to get from index
 			return tx_context.access_delete(key, temp_index_tuple);
 		}
@@ -305,6 +320,7 @@ namespace cc::occ_numa {
 						std::this_thread::yield();
 					}
 					if (entry.wts != origin_tuple.get_wts_ref().load(std::memory_order_acquire)) {
+						get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 						success_validate = false;
 						break;
 					}
@@ -319,6 +335,7 @@ namespace cc::occ_numa {
 						if (!origin_tuple.try_lock_write()) {
 							// Avoid repeated tuple in a read set and a write set
 							if (!tx_context.look_up_write_set(entry.key)) {
+								get_thread_message().set_abort_reason(AbortReason::Locked);
 								success_validate = false;
 								break;
 							}
@@ -330,6 +347,7 @@ namespace cc::occ_numa {
 
 						uint64_t wts = origin_tuple.get_wts_ref().load(std::memory_order::acquire);
 						if (entry.wts != wts) {
+							get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 							success_validate = false;
 							break;
 						}
@@ -410,7 +428,7 @@ namespace cc::occ_numa {
 		 * @return Always true
 		 */
 		bool abort(Context &tx_context) {
-			get_thread_message().abort_transaction();
+			get_thread_message().abort_transaction(tx_context.message_);
 			return clean_up(tx_context);
 		}
 
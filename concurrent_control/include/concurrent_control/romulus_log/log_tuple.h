@@ -6,25 +6,48 @@
 #pragma once
 
 #include <cstdint>
+#include <atomic>
+#include <compare>
 
 namespace cc::romulus {
 
-	// Each log entry is two words (8+8 = 16 bytes)
+	//! @brief Log entry of a modified tuple, whose whole content is persisted.
+	//! Only the address is kept, so that entries stay one word on the flat-combining path.
 	struct LogEntry {
+		/// Pointer to the modified tuple
 		void *tuple_ptr;
 
 		LogEntry(): tuple_ptr(nullptr) {}
+
+		explicit LogEntry(void *op_tuple_ptr): tuple_ptr(op_tuple_ptr) {}
+
+		//! @brief Entries are ordered by address to persist them sequentially
+		auto operator<=>(const LogEntry &other) const {
+			return tuple_ptr <=> other.tuple_ptr;
+		}
+
+		bool operator==(const LogEntry &other) const {
+			return tuple_ptr == other.tuple_ptr;
+		}
 	};
 
-	struct LogChunk {
-		static constexpr uint32_t CHUNK_SIZE = 1024;
+	//! @brief State of a flat-combining request slot
+	enum class FCRequestKind : uint32_t {
+		/// No request, or the request has been applied
+		Empty,
+		/// A mutative transaction waits for being applied
+		Mutation
+	};
 
-	public:
-		LogEntry  entries[CHUNK_SIZE];
-		uint64_t  num_entries;
-		LogChunk* next;
+	//! @brief Typed flat-combining request slot, padded to avoid false sharing.
+	//! @tparam Transaction Type of transaction to apply
+	template<class Transaction>
+	struct alignas(128) FCRequest {
+		/// Published after tx_ptr is set
+		std::atomic<FCRequestKind> kind;
+		/// Transaction to be applied by combiner
+		Transaction *tx_ptr;
 
-	public:
-		LogChunk(): num_entries(0), next(nullptr) {}
+		FCRequest(): kind(FCRequestKind::Empty), tx_ptr(nullptr) {}
 	};
 }
@@ -5,9 +5,12 @@
 
 #pragma once
 
-#include <util/latency_counter.h>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+#include <util/latency_histogram.h>
 #include <thread/thread.h>
-#include <log_manager/abstract_log_manager.h>
 
 #include <concurrent_control/abstract_concurrent_control.h>
 #include <concurrent_control/romulus_log/rwlock.h>
@@ -58,7 +61,7 @@ namespace cc {
 
 			static constexpr uint32_t ALL_FIELD = WorkloadType::ALL_FIELD;
 
-			static constexpr uint32_t CHUNK_SIZE = 1024;
+			static constexpr uint32_t LOG_RESERVE_SIZE = 1024;
 
 			static constexpr uint32_t MAX_THREAD_NUM = thread::get_max_tid();
 
@@ -73,31 +76,30 @@ namespace cc {
 
 		private:
 			// Stuff used by the Flat Combining mechanism
-			static constexpr uint32_t CLPAD = 128 / sizeof(uintptr_t);
+			using FCRequestType = FCRequest<Transaction>;
+
+			/// Typed request slots, one per thread
+			FCRequestType fc[MAX_THREAD_NUM];
 
-			alignas(128) std::atomic<std::function<void()>*> fc[MAX_THREAD_NUM * CLPAD]; // array of atomic pointers to functions
+			/// Thread id of requests gathered by the combiner
+			uint32_t lfc[MAX_THREAD_NUM];
 
-			std::function<void()>* lfc[MAX_THREAD_NUM];
+			uint32_t lfc_num;
 
 			CRWWPSpinLock rwlock;
 
-			// There is always at least one (empty) chunk in the log, it's the head
 			std::atomic<State> state;
 
-			LogChunk* log_head;
-
-			LogChunk* log_tail;
+			/// Modifications of the current batch
+			std::vector<LogEntry> log_;
 
 		public: // Class Property
 
 			explicit RomulusLog(StorageManager *storage_manager):
 				storage_manager_ (storage_manager),
-				state(State::IDLE),
-				log_head(new LogChunk), log_tail(log_head) {
-				for (uint32_t i = 0; i < MAX_THREAD_NUM; ++i) {
-					fc[i * CLPAD].store(nullptr, std::memory_order::relaxed);
-					lfc[i] = nullptr;
-				}
+				lfc_num(0),
+				state(State::IDLE) {
+				log_.reserve(LOG_RESERVE_SIZE);
 
 				storage_manager_->register_data_deallocate_func([&](const IndexTupleType &index_tuple) {
 					storage_manager_->deallocate_data(index_tuple.get_data_ptr());
@@ -143,88 +145,37 @@ namespace cc {
 			//! @param tx Transaction to execute
 			//! @return
 			bool run_tx(auto &tx, Context &thread_context) {
-				// For transaction, we should build four lambda function for it.
-				// As for the reason to take it apart, it is my intention to simplify the callback function,
-				// which will be done once the lambada ended.
-
-				auto read_func = [&](KeyType key, FieldType field, void *output_ptr) -> bool {
-					IndexTupleType temp_index_tuple;
-					// Get tuple reference from index
-					if (!read_index(thread_context, key, temp_index_tuple)) { return false; }
-					copy_data_from_index_tuple(thread_context, temp_index_tuple, output_ptr);
-					// Add it into read set
-					return true;
-				};
-
-				auto write_func = [&](KeyType key, FieldType field, RowType &&value) -> bool {
-					IndexTupleType temp_index_tuple;
-					// Get tuple reference from index
-					if (!read_index(thread_context, key, temp_index_tuple)) { return false; }
-
-					// Write directly
-					if (field == ALL_FIELD) {
-						temp_index_tuple.set_data(value);
-					}
-					else {
-						temp_index_tuple.get_data().set_element(field, value.get_element(field));
-					}
-
-					add_to_log(temp_index_tuple.get_data_ptr());
-					return true;
-				};
-
-				auto scan_func = [&](KeyType key, FieldType field, uint32_t scan_length, void *output_ptr) -> bool {
-					IndexTupleType temp_index_tuple;
-
-					for (uint32_t i = 0; i < scan_length; ++i) {
-						// Get tuple reference from index
-						// Get tuple reference from index
-						if (!read_index(thread_context, key, temp_index_tuple)) { return false; }
-						copy_data_from_index_tuple(thread_context, temp_index_tuple, output_ptr);
-						output_ptr = reinterpret_cast<char *>(output_ptr) + sizeof(RowType);
-					}
-					return true;
-				};
-
-				auto insert_func = [&](KeyType key, FieldType field, RowType &&value) -> bool {
-					// There is no such tuple reference to get from index
-					TupleType *new_data = storage_manager_->allocate_data(value);
-					bool res = storage_manager_->add_data(key, IndexTupleType{new_data});
-					if (!res) { assert(false); }
-					return true;
-				};
-
 				uint32_t tid = thread::get_tid();
 
 				if (tx.is_only_read()) {
 					rwlock.shared_lock(tid);
-					tx.run(read_func, write_func, scan_func, insert_func);
+					apply_transaction(tx, thread_context);
 					rwlock.shared_unlock(tid);
 
 					return false;
 				}
 				else {
-					std::function<void()> myfunc = [&](){ tx.run(read_func, write_func, scan_func, insert_func); };
-
 					// Add our mutation to the array of flat combining
-					fc[tid * CLPAD].store(&myfunc, std::memory_order_release);
+					FCRequestType &request = fc[tid];
+					request.tx_ptr = &tx;
+					request.kind.store(FCRequestKind::Mutation, std::memory_order_release);
 					// Lock writersMutex
 					while (true) {
 						if (rwlock.try_exclusive_lock()) break;
 						// Check if another thread executed my mutation
-						if (fc[tid * CLPAD].load(std::memory_order_acquire) == nullptr) { return false; }
+						if (request.kind.load(std::memory_order_acquire) == FCRequestKind::Empty) { return false; }
 						std::this_thread::yield();
 					}
 
-					bool something_to_do = false;
 					// Save a local copy of the flat combining array
-
+					lfc_num = 0;
 					for (uint32_t i = 0; i < MAX_THREAD_NUM; i++) {
-						lfc[i] = fc[i * CLPAD].load(std::memory_order_acquire);
-						if (lfc[i] != nullptr) { something_to_do = true; }
+						if (fc[i].kind.load(std::memory_order_acquire) == FCRequestKind::Mutation) {
+							lfc[lfc_num++] = i;
+						}
 					}
 					// Check if there is at least one operation to apply
-					if (!something_to_do) {
+					if (lfc_num == 0) {
 						rwlock.exclusive_unlock();
 						return false;
 					}
@@ -236,10 +187,13 @@ namespace cc {
 					rwlock.wait_for_readers();
 
 					thread_context.message_.start_persist_data();
-					// Apply all mutativeFunc
-					for (auto & f : lfc) {
-						if (f != nullptr) { (*f)(); }
+					// Apply all mutations in batch
+					for (uint32_t i = 0; i < lfc_num; ++i) {
+						apply_transaction(*fc[lfc[i]].tx_ptr, thread_context);
 					}
+					// Sort modifications by address, and merge those on the same tuple.
+					std::sort(log_.begin(), log_.end());
+					log_.erase(std::unique(log_.begin(), log_.end()), log_.end());
 					apply_main_pwb();
 					thread_context.message_.end_persist_data();
 				}
@@ -254,13 +208,13 @@ namespace cc {
 				storage_manager_->pwb_range(&state, sizeof(state));
 				storage_manager_->fence();
 
-				// After changing state to COPYING all applied mutativeFunc are visible and persisted
-				for (uint32_t i = 0; i < MAX_THREAD_NUM; i++) {
-					if (lfc[i] == nullptr) continue;
-					fc[i * CLPAD].store(nullptr, std::memory_order_release);
+				// After changing state to COPYING all applied mutations are visible and persisted
+				for (uint32_t i = 0; i < lfc_num; i++) {
+					fc[lfc[i]].kind.store(FCRequestKind::Empty, std::memory_order_release);
 				}
+				lfc_num = 0;
 
-				apply_log_pwb();
+				apply_log_pwb(thread_context);
 
 				clear_log();
 				storage_manager_->fence();
@@ -278,30 +232,76 @@ namespace cc {
 
 
 		private:
+			/*!
+			 * @brief Apply a transaction with typed callbacks, where modifications are recorded in log.
+			 * @param tx Transaction to apply
+			 * @param thread_context Context of the thread applying transaction
+			 */
+			void apply_transaction(Transaction &tx, Context &thread_context) {
+				auto read_func = [&](KeyType key, FieldType field, void *output_ptr) -> bool {
+					IndexTupleType temp_index_tuple;
+					// Get tuple reference from index
+					if (!read_index(thread_context, key, temp_index_tuple)) { return false; }
+					copy_data_from_index_tuple(thread_context, temp_index_tuple, output_ptr);
+					return true;
+				};
+
+				auto write_func = [&](KeyType key, FieldType field, RowType &&value) -> bool {
+					IndexTupleType temp_index_tuple;
+					// Get tuple reference from index
+					if (!read_index(thread_context, key, temp_index_tuple)) { return false; }
+
+					// Write directly
+					if (field == ALL_FIELD) {
+						temp_index_tuple.set_data(value);
+					}
+					else {
+						temp_index_tuple.get_data().set_element(field, value.get_element(field));
+					}
+
+					add_to_log(temp_index_tuple.get_data_ptr());
+					return true;
+				};
+
+				auto scan_func = [&](KeyType key, FieldType field, uint32_t scan_length, void *output_ptr) -> bool {
+					IndexTupleType temp_index_tuple;
+
+					for (uint32_t i = 0; i < scan_length; ++i) {
+						// Get tuple reference from index
+						if (!read_index(thread_context, key, temp_index_tuple)) { return false; }
+						copy_data_from_index_tuple(thread_context, temp_index_tuple, output_ptr);
+						output_ptr = reinterpret_cast<char *>(output_ptr) + sizeof(RowType);
+					}
+					return true;
+				};
+
+				auto insert_func = [&](KeyType key, FieldType field, RowType &&value) -> bool {
+					// There is no such tuple reference to get from index
+					TupleType *new_data = storage_manager_->allocate_data(value);
+					bool res = storage_manager_->add_data(key, IndexTupleType{new_data});
+					if (!res) { assert(false); }
+
+					add_to_log(new_data);
+					return true;
+				};
+
+				tx.run(read_func, write_func, scan_func, insert_func);
+			}
+
 			/*
 	         * Called to make every store persistent on main and back region
 	         */
 			void apply_main_pwb() {
-				// Apply the log to the instance on 'to_addr', copying data from the instance at 'from_addr'
-				LogChunk* chunk = log_head;
-				while (chunk != nullptr) {
-					for (uint32_t i = 0; i < chunk->num_entries; i++) {
-						LogEntry& e = chunk->entries[i];
-						storage_manager_->pwb_range(static_cast<TupleType *>(e.tuple_ptr)->get_main_data_ptr(), sizeof(RowType));
-					}
-					chunk = chunk->next;
+				// Log entries have been sorted by address.
+				for (LogEntry &e: log_) {
+					storage_manager_->pwb_range(static_cast<TupleType *>(e.tuple_ptr)->get_main_data_ptr(), sizeof(RowType));
 				}
 			}
 
 			void apply_back_pwb() {
-				// Apply the log to the instance on 'to_addr', copying data from the instance at 'from_addr'
-				LogChunk* chunk = log_head;
-				while (chunk != nullptr) {
-					for (uint32_t i = 0; i < chunk->num_entries; i++) {
-						LogEntry& e = chunk->entries[i];
-						storage_manager_->pwb_range(static_cast<TupleType *>(e.tuple_ptr)->get_back_data_ptr(), sizeof(RowType));
-					}
-					chunk = chunk->next;
+				// Log entries have been sorted by address.
+				for (LogEntry &e: log_) {
+					storage_manager_->pwb_range(static_cast<TupleType *>(e.tuple_ptr)->get_back_data_ptr(), sizeof(RowType));
 				}
 			}
 
@@ -309,56 +309,26 @@ namespace cc {
 		     * Called at the end of a transaction to replicate the mutations on "back",
 		     * or when abort_transaction() is called by the user, to rollback the
 		     * mutations on "main".
-		     * Deletes the log as it is being applied.
 		     */
 			void apply_log_pwb(Context &thread_context) {
 				thread_context.message_.start_persist_log();
-				// Apply the log to the instance on 'to_addr', copying data from the instance at 'from_addr'
-				LogChunk* chunk = log_head;
-				while (chunk != nullptr) {
-					for (uint32_t i = 0; i < chunk->num_entries; i++) {
-						LogEntry& e = chunk->entries[i];
-						static_cast<TupleType *>(e.tuple_ptr)->back_up();
-						storage_manager_->pwb_range(static_cast<TupleType *>(e.tuple_ptr)->get_back_data_ptr(), sizeof(RowType));
-					}
-					chunk = chunk->next;
+				for (LogEntry &e: log_) {
+					static_cast<TupleType *>(e.tuple_ptr)->back_up();
 				}
+				apply_back_pwb();
 				storage_manager_->fence();
 				thread_context.message_.end_persist_log();
 			}
 
 			void clear_log() {
-				LogChunk* chunk = log_head->next;
-				while (chunk != nullptr) {
-					LogChunk* next = chunk->next;
-					delete chunk;
-					chunk = next;
-				}
-				// Clear the log, leaving one chunk for next transaction, with zero'ed entries
-				log_tail = log_head;
-				log_head->num_entries = 0;
-				log_head->next = nullptr;
+				log_.clear();
 			}
 
-
 			/*
-			* Adds to the log the current contents of the memory location starting at
-			* 'addr' with a certain 'length' in bytes
+			* Adds to the log the modification on a tuple
 			*/
 			void add_to_log(TupleType* addr) {
-				// Get the current chunk of log and if it is already full then create a new chunk and add the entry there.
-				LogChunk* chunk = log_tail;
-
-				if (chunk->num_entries == CHUNK_SIZE) {
-					chunk = new LogChunk();
-					log_tail->next = chunk;
-					log_tail = chunk;
-				}
-				LogEntry& e = chunk->entries[chunk->num_entries];
-
-				e.tuple_ptr = addr;
-
-				chunk->num_entries++;
+				log_.emplace_back(addr);
 			}
 
 			//! @brief Read content from index
@@ -373,6 +343,14 @@ namespace cc {
 				return res;
 			}
 
+			//! @brief Copy the main content of a tuple
+			//! @param thread_context
+			//! @param index_tuple
+			//! @param output_ptr Output buffer of a whole row
+			void copy_data_from_index_tuple(Context &thread_context, const IndexTupleType &index_tuple, void *output_ptr) {
+				std::memcpy(output_ptr, index_tuple.get_main_data_ptr(), sizeof(RowType));
+			}
+
 		};
 	}
 }
@@ -10,6 +10,11 @@
 #include <atomic>
 #include <span>
 #include <optional>
+#include <memory>
+#include <algorithm>
+
+#include <thread/thread.h>
+#include <memory/cache_config.h>
 
 namespace cc::sp {
 
@@ -59,30 +64,61 @@ namespace cc::sp {
 
 		static constexpr size_t LOG_PAGE_SIZE = 2048;
 
+	private:
+		/// Bump allocator over one stripe of log space
+		struct alignas(CACHE_LINE_SIZE) StripeCursor {
+			uint8_t *begin_;
+			uint8_t *end_;
+			std::atomic<uint8_t *> cur_bound_;
+		};
+
 	private:
 		// Assume the space is large enough to contain all logs.
 		std::span<uint8_t> log_space_range_;
 
-		std::atomic<uint8_t *> cur_bound_;
+		/// The number of stripes(PMEM namespaces) the log space consists of
+		uint32_t stripe_num_;
+
+		std::unique_ptr<StripeCursor[]> stripe_cursor_;
 
 	public:
-		LogPersist(std::span<uint8_t> log_space_range): log_space_range_(log_space_range), cur_bound_(log_space_range.data()) {}
+		/*!
+		 * @param log_space_range Log space
+		 * @param stripe_num The number of equal-sized stripes of log space, each on its own NUMA node
+		 */
+		LogPersist(std::span<uint8_t> log_space_range, uint32_t stripe_num = 1):
+				log_space_range_(log_space_range),
+				stripe_num_(std::max(stripe_num, 1U)),
+				stripe_cursor_(std::make_unique<StripeCursor[]>(stripe_num_)) {
+			const size_t stripe_size = log_space_range.size() / stripe_num_;
+			for (uint32_t i = 0; i < stripe_num_; ++i) {
+				StripeCursor &cursor = stripe_cursor_[i];
+				cursor.begin_ = log_space_range.data() + i * stripe_size;
+				cursor.end_   = (i + 1 == stripe_num_) ? log_space_range.data() + log_space_range.size() : cursor.begin_ + stripe_size;
+				cursor.cur_bound_.store(cursor.begin_, std::memory_order::relaxed);
+			}
+		}
 
 		~LogPersist() = default;
 
 	public:
+		/*!
+		 * @brief Allocate log space on the stripe local to the calling thread.
+		 * @return false if the local stripe is full
+		 */
 		std::pair<bool, LogSpace> allocate_log_space(size_t update_amount, size_t expected_size) {
 			size_t size = expected_size +
 					sizeof(LogTuple<LogLabel::Commit, AbKeyType>) +
 					sizeof(LogTuple<LogLabel::Update, AbKeyType>) +
 					sizeof(LogTuple<LogLabel::Start, AbKeyType>);
+			StripeCursor &cursor = get_local_stripe();
 			LogSpace res_space;
 			while (true) {
-				uint8_t *log_ptr = res_space.start_ptr = cur_bound_.load(std::memory_order::relaxed);
-				if (log_ptr + size >= std::addressof(log_space_range_.back())) {
+				uint8_t *log_ptr = res_space.start_ptr = cursor.cur_bound_.load(std::memory_order::relaxed);
+				if (log_ptr + size >= cursor.end_) {
 					return { false, {} };
 				}
-				if (cur_bound_.compare_exchange_weak(log_ptr, res_space.start_ptr + size)) { break; }
+				if (cursor.cur_bound_.compare_exchange_weak(log_ptr, res_space.start_ptr + size)) { break; }
 			}
 			res_space.cur_ptr = res_space.start_ptr;
 			res_space.end_ptr = res_space.start_ptr + size;
@@ -92,7 +128,16 @@ namespace cc::sp {
 		}
 
 		void reset_log_space() {
-			cur_bound_.store(log_space_range_.data());
+			for (uint32_t i = 0; i < stripe_num_; ++i) {
+				stripe_cursor_[i].cur_bound_.store(stripe_cursor_[i].begin_);
+			}
+		}
+
+	private:
+		//! @brief Get the stripe local to the calling thread.
+		StripeCursor &get_local_stripe() {
+			if (stripe_num_ == 1 || !thread::is_registered()) { return stripe_cursor_[0]; }
+			return stripe_cursor_[static_cast<uint32_t>(thread::get_cpu_numa_id()) % stripe_num_];
 		}
 
 	public:
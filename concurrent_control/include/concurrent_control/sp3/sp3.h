@@ -7,7 +7,7 @@
 
 #include <tbb/concurrent_unordered_set.h>
 
-#include <util/latency_counter.h>
+#include <util/latency_histogram.h>
 #include <spdlog/spdlog.h>
 #include <thread/thread.h>
 
@@ -91,7 +91,7 @@ namespace cc::sp {
 
 		explicit SP(StorageManager *storage_manager_ptr):
 				storage_manager_ptr_(storage_manager_ptr),
-				log_persist_(storage_manager_ptr->get_log_space_range()),
+				log_persist_(storage_manager_ptr->get_log_space_range(), storage_manager_ptr->get_log_space_stripe_num()),
 				dep_list(new std::array<uint32_t, thread::get_max_tid()>[thread::get_max_tid(), CACHE_LINE_SIZE]),
 				localLP(new std::array<uint32_t, thread::get_max_tid()>[thread::get_max_tid(), CACHE_LINE_SIZE]),
 				update_event_set_idx_(0) {
@@ -174,6 +174,7 @@ namespace cc::sp {
 
 			uint32_t tid = thread::get_tid();
 			if (stop_flag_.load(std::memory_order::acquire)) {
+				util::TraceScope trace_scope(tid == 0 ? "stop_the_world" : "wait_stop");
 				if (tid == 0) {
 					// Wait for all threads blocked
 					for (uint32_t i = 1; i < thread::get_max_tid(); ++i) {
@@ -275,7 +276,10 @@ namespace cc::sp {
 
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 
 			// Read timestamp before copying data.
 			// Correspondingly, we will write data before write timestamp in write phase.
@@ -301,7 +305,10 @@ namespace cc::sp {
 		void *update(Context &tx_context, const AbKeyType &key) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 
 			uint32_t tid = thread::get_tid();
 
@@ -332,7 +339,10 @@ namespace cc::sp {
 		void *update(Context &tx_context, const AbKeyType &key, uint32_t size, uint32_t offset) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+			if (!read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+				return nullptr;
+			}
 
 			uint32_t tid = thread::get_tid();
 
@@ -363,7 +373,10 @@ namespace cc::sp {
 		bool insert(Context &tx_context, const AbKeyType &key, const void *row, uint32_t size) {
 			// Index reading
 			IndexTupleType temp_index_tuple;
-			if (read_index(tx_context, key, temp_index_tuple)) { return false; }
+			if (read_index(tx_context, key, temp_index_tuple)) {
+				get_thread_message().set_abort_reason(AbortReason::KeyExists);
+				return false;
+			}
 			// There is no such tuple reference to get from index
 			return tx_context.access_insert(key, row, size) != nullptr;
 		}
@@ -455,6 +468,7 @@ namespace cc::sp {
 				else {
 					stop_flag_.store(true);
 
+					get_thread_message().set_abort_reason(AbortReason::LogSpace);
 					tx_context.message_.end_validate();
 					return false;
 				}
@@ -483,6 +497,7 @@ namespace cc::sp {
 					uint32_t lthid = origin_tuple.get_data_header_ptr()->thid_;
 
 					if (entry.wts != wts || (lthid != NO_LOCK_THREAD && lthid != tid)) {
+						get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 						success_validate = false;
 						break;
 					}
@@ -539,7 +554,7 @@ namespace cc::sp {
 		 * @return Always true
 		 */
 		bool abort(Context &tx_context) {
-			get_thread_message().abort_transaction();
+			get_thread_message().abort_transaction(tx_context.message_);
 
 			uint32_t tid = thread::get_tid();
 			global_tx_id_table[tid].state.store(TxStatus::Normal);
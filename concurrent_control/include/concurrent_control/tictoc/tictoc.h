@@ -5,13 +5,14 @@
 
 #pragma once
 
-#include <util/latency_counter.h>
+#include <util/latency_histogram.h>
 #include <spdlog/spdlog.h>
 #include <thread/thread.h>
 
 #include <recovery/recovery.h>
 
 #include <concurrent_control/abstract_concurrent_control.h>
+#include <concurrent_control/conflict_tracker.h>
 
 #include <concurrent_control/tictoc/data_tuple.h>
 #include <concurrent_control/tictoc/tx_context.h>
@@ -172,7 +173,10 @@ namespace cc {
 				if (data_ptr != nullptr) { return data_ptr; }
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return nullptr;
+				}
 				// Read timestamp before copying data.
 				// Correspondingly, we will write data before write timestamp in write phase.
 				// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -190,7 +194,10 @@ namespace cc {
 			void *update(Context &tx_context, const AbKeyType &key) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return nullptr;
+				}
 				// Read timestamp before copying data.
 				// Correspondingly, we will write data before write timestamp in write phase.
 				// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -209,7 +216,10 @@ namespace cc {
 			void *update(Context &tx_context, const AbKeyType &key, uint32_t size, uint32_t offset) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return nullptr;
+				}
 				// Read timestamp before copying data.
 				// Correspondingly, we will write data before write timestamp in write phase.
 				// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -228,7 +238,10 @@ namespace cc {
 			bool insert(Context &tx_context, const AbKeyType &key, const void *row, uint32_t size) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (read_index(tx_context, key, temp_index_tuple)) { return false; }
+				if (read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyExists);
+					return false;
+				}
 				// There is no such tuple reference to get from index
 				return tx_context.access_insert(key, row, size);
 			}
@@ -242,7 +255,10 @@ namespace cc {
 			bool remove(Context &tx_context, const AbKeyType &key) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return false; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return false;
+				}
 				// There is no such tuple reference to get from index
 				return tx_context.access_delete(key, temp_index_tuple);
 			}
@@ -289,6 +305,8 @@ namespace cc {
 						++lock_num;
 						// Assert that the entry hasn't changed after first read
 						if (rts < wts || entry.wts != wts) {
+							ConflictTracker::get_thread_tracker().record_conflict(entry.key);
+							get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 							success_validate = false;
 							break;
 						}
@@ -307,6 +325,8 @@ namespace cc {
 								// Avoid repeated tuple in a read set and a
 								// write set
 								if (!tx_context.look_up_write_set(entry.key)) {
+									ConflictTracker::get_thread_tracker().record_conflict(entry.key);
+									get_thread_message().set_abort_reason(AbortReason::Locked);
 									success_validate = false;
 									break;
 								}
@@ -318,6 +338,8 @@ namespace cc {
 							uint64_t wts = origin_tuple.get_wts().load(std::memory_order::acquire);
 							// Assert that the entry hasn't changed after first read
 							if (entry.wts != wts) [[unlikely]] {
+								ConflictTracker::get_thread_tracker().record_conflict(entry.key);
+								get_thread_message().set_abort_reason(AbortReason::TimestampChanged);
 								success_validate = false;
 								origin_tuple.unlock_read();
 								break;
@@ -369,7 +391,7 @@ namespace cc {
 			 * @return Always true
 			 */
 			bool abort(Context &tx_context) {
-				get_thread_message().abort_transaction();
+				get_thread_message().abort_transaction(tx_context.message_);
 				return clean_up(tx_context);
 			}
 
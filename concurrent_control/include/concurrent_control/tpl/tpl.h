@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include <util/latency_counter.h>
+#include <util/latency_histogram.h>
 #include <thread/thread.h>
 
 #include <recovery/recovery.h>
@@ -166,7 +166,10 @@ namespace cc {
 				if (data_ptr != nullptr) { return data_ptr; }
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return nullptr;
+				}
 				// Read timestamp before copying data.
 				// Correspondingly, we will write data before write timestamp in write phase.
 				// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -184,7 +187,10 @@ namespace cc {
 			void *update(Context &tx_context, const AbKeyType &key) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return nullptr;
+				}
 				// Read timestamp before copying data.
 				// Correspondingly, we will write data before write timestamp in write phase.
 				// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -203,7 +209,10 @@ namespace cc {
 			void *update(Context &tx_context, const AbKeyType &key, uint32_t size, uint32_t offset) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return nullptr; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return nullptr;
+				}
 				// Read timestamp before copying data.
 				// Correspondingly, we will write data before write timestamp in write phase.
 				// Then, if we read the old data, the timestamp should be old, too, which will incur validation failure.
@@ -222,7 +231,10 @@ namespace cc {
 			bool insert(Context &tx_context, const AbKeyType &key, const void *row, uint32_t size) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (read_index(tx_context, key, temp_index_tuple)) { return false; }
+				if (read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyExists);
+					return false;
+				}
 				// There is no such tuple reference to get from index
 				return tx_context.access_insert(key, row, size);
 			}
@@ -236,7 +248,10 @@ namespace cc {
 			bool remove(Context &tx_context, const AbKeyType &key) {
 				// Index reading
 				IndexTupleType temp_index_tuple;
-				if (!read_index(tx_context, key, temp_index_tuple)) { return false; }
+				if (!read_index(tx_context, key, temp_index_tuple)) {
+					get_thread_message().set_abort_reason(AbortReason::KeyNotFound);
+					return false;
+				}
 				// There is no such tuple reference to get from index
 				return tx_context.access_delete(key, temp_index_tuple);
 			}
@@ -275,7 +290,7 @@ namespace cc {
 			 * @return Always true
 			 */
 			bool abort(Context &tx_context) {
-				get_thread_message().abort_transaction();
+				get_thread_message().abort_transaction(tx_context.message_);
 				return clean_up(tx_context);
 			}
 
@@ -135,7 +135,10 @@ namespace cc {
 			}
 
 			void *access_read(const AbKeyType &key, IndexTupleType &tuple) {
-				if (!tuple.try_lock_read()) { return nullptr; }
+				if (!tuple.try_lock_read()) {
+					ConcurrentControlMessage::get_thread_message().set_abort_reason(AbortReason::Locked);
+					return nullptr;
+				}
 				// Add it into read set.
 				read_set_.emplace_back(
 						Entry {
@@ -148,7 +151,10 @@ namespace cc {
 			}
 
 			void *access_write(const AbKeyType &key, IndexTupleType &tuple, uint32_t size, uint32_t offset) {
-				if (!tuple.try_lock_write()) { return nullptr; }
+				if (!tuple.try_lock_write()) {
+					ConcurrentControlMessage::get_thread_message().set_abort_reason(AbortReason::Locked);
+					return nullptr;
+				}
 				// Allocate a temp space storing data
 				uint32_t data_size = tuple.get_data_size();
 				uint8_t *data_buffer = allocate_data_buffer(data_size);
@@ -190,7 +196,10 @@ namespace cc {
 			}
 
 			bool access_delete(const AbKeyType &key, IndexTupleType &tuple) {
-				if (!tuple.try_lock_write()) { return false; }
+				if (!tuple.try_lock_write()) {
+					ConcurrentControlMessage::get_thread_message().set_abort_reason(AbortReason::Locked);
+					return false;
+				}
 				{
 					write_set_.emplace_back(
 							Entry {
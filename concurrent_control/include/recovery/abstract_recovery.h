@@ -41,4 +41,22 @@ namespace recovery {
 		uint8_t *cur_ptr;
 		uint8_t *end_ptr;
 	};
+
+	//! @brief Statistics about recovery after crash.
+	struct RecoveryStatistics {
+		/// Time spent on scanning data region(ms)
+		uint64_t data_iteration_time{0};
+		/// Time spent on scanning log(ms)
+		uint64_t log_iteration_time{0};
+		/// Time spent on replaying updates of committed transactions in log(ms)
+		uint64_t replay_time{0};
+		/// The number of valid data tuples found
+		uint64_t data_tuple_num{0};
+		/// Bytes of valid data tuples found
+		uint64_t data_size{0};
+		/// Bytes of log scanned
+		uint64_t log_size{0};
+		/// The number of updates replayed
+		uint64_t replay_update_num{0};
+	};
 }
@@ -6,10 +6,17 @@
 #pragma once
 
 #include <cstdint>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <fstream>
 
 #include <thread/thread.h>
 #include <spdlog/spdlog.h>
+#include <util/tsc_clock.h>
+#include <util/event_tracer.h>
 #include <listener/listener.h>
+#include <concurrent_control/conflict_tracker.h>
 #include <global_config/global_config.h>
 
 namespace ptm {
@@ -30,84 +37,322 @@ namespace ptm {
 	public:
 		bench() {}
 
-		//! @brief Turn bench on
-		void run(const auto &TEST_THREAD_NUM_ARRAY, uint32_t TEST_TIME_MILLISECOND, bool do_warm_up = false) {
+		/*!
+		 * @brief Turn bench on
+		 * @param OFFERED_LOAD_ARRAY Offered loads(txn/s) to sweep in open-loop mode for each kind of thread_num,
+		 * which produces a throughput-latency curve. Run in closed loop if empty.
+		 */
+		void run(const auto &TEST_THREAD_NUM_ARRAY, uint32_t TEST_TIME_MILLISECOND, bool do_warm_up = false,
+		         const std::vector<double> &OFFERED_LOAD_ARRAY = {}) {
+			// Calibrate timer before any transaction is timed
+			spdlog::info("TSC frequency: {:.1f} MHz", util::TSCClock::get_frequency());
+
 			// Do test on each kind of thread_num
 			for (uint32_t thread_num: TEST_THREAD_NUM_ARRAY) {
-				// ------ Initialize basic components.
-
-				// Initialize storage manager and transaction manager
-				StorageManager storage_manager;
-				for (TableScheme table_scheme: WorkloadType::TableSchemeSizeDefinition) {
-					storage_manager.add_table(table_scheme.tuple_size, table_scheme.max_tuple_num);
+				if (OFFERED_LOAD_ARRAY.empty()) {
+					run_once(thread_num, 0, TEST_TIME_MILLISECOND, do_warm_up);
+					continue;
 				}
+				// Sweep offered load
+				std::vector<transaction::TransactionManagerInfo> curve;
+				for (double offered_load: OFFERED_LOAD_ARRAY) {
+					curve.emplace_back(run_once(thread_num, offered_load, TEST_TIME_MILLISECOND, do_warm_up));
+				}
+				print_load_curve(thread_num, curve);
+			}
+		}
 
-				TransactionManager transaction_manager(ThreadBindStrategy, &storage_manager);
-				// Initialize concurrent control class
-				cc::ConcurrentControlMessage::disable_record();
+	private:
+		//! @brief Run test once and print summary.
+		transaction::TransactionManagerInfo run_once(uint32_t thread_num, double offered_load,
+		                                             uint32_t TEST_TIME_MILLISECOND, bool do_warm_up) {
+			// ------ Initialize basic components.
 
-				spdlog::info("Start initialization");
-				transaction_manager.init();
+			// Initialize storage manager and transaction manager
+			StorageManager storage_manager;
+			for (TableScheme table_scheme: WorkloadType::TableSchemeSizeDefinition) {
+				storage_manager.add_table(table_scheme.tuple_size, table_scheme.max_tuple_num);
+			}
 
-				// ------- Warming up
-				if (do_warm_up) {
-					spdlog::info("Start warming up");
-					// For warming up, we just insert all base data into system.
-					transaction_manager.warm_up(thread_num);
-				}
+			TransactionManager transaction_manager(ThreadBindStrategy, &storage_manager);
+			if constexpr (requires { transaction_manager.set_offered_load(offered_load); }) {
+				transaction_manager.set_offered_load(offered_load);
+			}
+			else if (offered_load > 0) {
+				spdlog::warn("Open-loop mode is not supported by the transaction manager, run in closed loop");
+			}
+			// Initialize concurrent control class
+			cc::ConcurrentControlMessage::disable_record();
 
-				spdlog::info("Set Listener");
+			spdlog::info("Start initialization");
+			transaction_manager.init();
+
+			// ------- Warming up
+			if (do_warm_up) {
+				spdlog::info("Start warming up");
+				// For warming up, we just insert all base data into system.
+				transaction_manager.warm_up(thread_num);
+			}
 
-				util::listener::ListenerArray listener_array;
+			spdlog::info("Set Listener");
+
+			util::listener::ListenerArray listener_array;
 //				listener_array.add_listener(new util::listener::PMMListener);
+//				listener_array.add_listener(new util::listener::PMMNodeListener);
 //				listener_array.add_listener(new util::listener::NUMAWatcher);
 //				listener_array.add_listener(new util::listener::TimeListener{});
 //				listener_array.add_listener(new util::listener::PAPIListener);
 
-				// ------ Test
-				spdlog::info("Start tests");
-
-				// Running transactions
-				cc::ConcurrentControlMessage::enable_record();
-				listener_array.start_record();
-
-				// ProfilerStart("PTM.prof");
-				transaction_manager.run(thread_num, std::chrono::milliseconds(TEST_TIME_MILLISECOND));
-				// ProfilerStop();
-
-				listener_array.end_record();
-				// Get a relative message about transaction running.
-				transaction::TransactionManagerInfo manager_info = transaction_manager.get_manager_info();
-				cc::ConcurrentControlMessage::disable_record();
-
-				// ------ Print summary
-				// print global property
-				GlobalConfig::print_property();
-				// print information about task execution
-				util::print_property("Task Summary",
-									  std::make_tuple("Test time", manager_info.total_running_time_, "ms"),
-				                      std::make_tuple("Total Thread Num", manager_info.total_thread_num_, ""),
-				                      std::make_tuple("Worker Thread Num", manager_info.worker_thread_num_, ""),
-									  std::make_tuple("Total tx", manager_info.total_tx_, ""),
-									  std::make_tuple("Abort tx", manager_info.abort_tx_, ""),
-									  std::make_tuple("Speed", (manager_info.total_tx_ - manager_info.abort_tx_) * 1000 / manager_info.total_running_time_, "txn/s"),
-									  std::make_tuple("Abort rate", static_cast<double>(manager_info.abort_tx_) * 100.0 / manager_info.total_tx_, "%"),
-									  std::make_tuple("Running Latency(99%)", manager_info.running_latency_, "ns"),
-									  std::make_tuple("Commit Latency(99%)", manager_info.commit_latency_, "ns"),
-									  std::make_tuple("Index Latency(99%)", manager_info.index_latency_, "ns"),
-									  std::make_tuple("Validate Latency(99%)", manager_info.validate_latency_, "ns"),
-									  std::make_tuple("Persist Log Latency(99%)", manager_info.persist_log_latency_, "ns"),
-									  std::make_tuple("Persist Data Latency(99%)", manager_info.persist_data_latency_, "ns"),
-									  std::make_tuple("Total Latency(99%)", manager_info.total_transaction_latency_, "ns"),
-									  std::make_tuple("Running Time", manager_info.running_time_, "ns"),
-									  std::make_tuple("Commit Time", manager_info.commit_time_, "ns"),
-									  std::make_tuple("Index Time", manager_info.index_time_, "ns"),
-									  std::make_tuple("Transaction Interface Time", manager_info.transaction_interface_time_, "ns"),
-									  std::make_tuple("Validate Time", manager_info.validate_time_, "ns"),
-									  std::make_tuple("Persist Log Time", manager_info.persist_log_time_, "ns"),
-									  std::make_tuple("Persist Data Time", manager_info.persist_data_time_, "ns")
-									  );
+			// ------ Test
+			spdlog::info("Start tests");
+
+			// Running transactions
+			cc::ConcurrentControlMessage::enable_record();
+			if constexpr (is_pmem_emulated()) {
+				NVMEmulator::clear_up();
+			}
+			if constexpr (util::ENABLE_EVENT_TRACE) {
+				util::EventTracer::clear();
+				util::EventTracer::enable();
+			}
+			listener_array.start_record();
+
+			// ProfilerStart("PTM.prof");
+			transaction_manager.run(thread_num, std::chrono::milliseconds(TEST_TIME_MILLISECOND));
+			// ProfilerStop();
+
+			listener_array.end_record();
+			if constexpr (util::ENABLE_EVENT_TRACE) {
+				util::EventTracer::disable();
+			}
+			// Get a relative message about transaction running.
+			transaction::TransactionManagerInfo manager_info = transaction_manager.get_manager_info();
+			cc::ConcurrentControlMessage::disable_record();
+
+			// ------ Print summary
+			// print global property
+			GlobalConfig::print_property();
+			// print information about task execution
+			util::print_property("Task Summary",
+								  std::make_tuple("Test time", manager_info.total_running_time_, "ms"),
+			                      std::make_tuple("Total Thread Num", manager_info.total_thread_num_, ""),
+			                      std::make_tuple("Worker Thread Num", manager_info.worker_thread_num_, ""),
+								  std::make_tuple("Total tx", manager_info.total_tx_, ""),
+								  std::make_tuple("Abort tx", manager_info.abort_tx_, ""),
+								  std::make_tuple("Speed", (manager_info.total_tx_ - manager_info.abort_tx_) * 1000 / manager_info.total_running_time_, "txn/s"),
+								  std::make_tuple("Abort rate", static_cast<double>(manager_info.abort_tx_) * 100.0 / manager_info.total_tx_, "%"),
+								  std::make_tuple("Retry tx", manager_info.retry_tx_, ""),
+								  std::make_tuple("Deferred tx", manager_info.defer_tx_, ""),
+								  std::make_tuple("Unfinished Deferred tx", manager_info.unfinished_defer_tx_, ""),
+								  std::make_tuple("Unfinished Routed tx", manager_info.unfinished_route_tx_, ""),
+								  std::make_tuple("Wasted Work Time", manager_info.wasted_time_, "ns"),
+								  std::make_tuple("Backoff Time", manager_info.backoff_time_, "ns"),
+								  std::make_tuple("Early Abort tx", manager_info.early_abort_tx_, ""),
+								  std::make_tuple("Log Size per tx", manager_info.log_size_ / std::max<uint64_t>(manager_info.total_tx_ - manager_info.abort_tx_, 1), "B"),
+								  std::make_tuple("Log Reduction", manager_info.raw_log_size_ == 0 ? 0.0 :
+								                  static_cast<double>(manager_info.raw_log_size_ - manager_info.log_size_) * 100.0 / manager_info.raw_log_size_, "%"),
+								  std::make_tuple("Running Latency(99%)", manager_info.running_latency_, "ns"),
+								  std::make_tuple("Commit Latency(99%)", manager_info.commit_latency_, "ns"),
+								  std::make_tuple("Index Latency(99%)", manager_info.index_latency_, "ns"),
+								  std::make_tuple("Validate Latency(99%)", manager_info.validate_latency_, "ns"),
+								  std::make_tuple("Persist Log Latency(99%)", manager_info.persist_log_latency_, "ns"),
+								  std::make_tuple("Persist Log Latency(max)", manager_info.persist_log_latency_max_, "ns"),
+								  std::make_tuple("Persist Data Latency(99%)", manager_info.persist_data_latency_, "ns"),
+								  std::make_tuple("Total Latency(50%)", manager_info.total_transaction_latency_50_, "ns"),
+								  std::make_tuple("Total Latency(99%)", manager_info.total_transaction_latency_, "ns"),
+								  std::make_tuple("Total Latency(99.9%)", manager_info.total_transaction_latency_999_, "ns"),
+								  std::make_tuple("Total Latency(max)", manager_info.total_transaction_latency_max_, "ns"),
+								  std::make_tuple("Early Validate Latency(99%)", manager_info.early_validate_latency_, "ns"),
+								  std::make_tuple("Running Time", manager_info.running_time_, "ns"),
+								  std::make_tuple("Commit Time", manager_info.commit_time_, "ns"),
+								  std::make_tuple("Index Time", manager_info.index_time_, "ns"),
+								  std::make_tuple("Transaction Interface Time", manager_info.transaction_interface_time_, "ns"),
+								  std::make_tuple("Validate Time", manager_info.validate_time_, "ns"),
+								  std::make_tuple("Persist Log Time", manager_info.persist_log_time_, "ns"),
+								  std::make_tuple("Persist Data Time", manager_info.persist_data_time_, "ns"),
+								  std::make_tuple("Early Validate Time", manager_info.early_validate_time_, "ns")
+								  );
+			// print latency including queueing delay in open-loop mode
+			if (manager_info.offered_load_ > 0) {
+				util::print_property("Open-loop Summary",
+				                     std::make_tuple("Offered Load", static_cast<uint64_t>(manager_info.offered_load_), "txn/s"),
+				                     std::make_tuple("Response Latency(50%)", manager_info.response_latency_50_, "ns"),
+				                     std::make_tuple("Response Latency(99%)", manager_info.response_latency_99_, "ns"),
+				                     std::make_tuple("Response Latency(99.9%)", manager_info.response_latency_999_, "ns"),
+				                     std::make_tuple("Response Latency(max)", manager_info.response_latency_max_, "ns")
+				                     );
+			}
+			// print commit, abort and latency of each transaction type
+			if constexpr (requires { WorkloadType::TransactionTypeNameDefinition; }) {
+				print_type_breakdown(manager_info);
+			}
+			// print aborted attempts and wasted time of each reason
+			if (manager_info.abort_tx_ > 0) {
+				print_abort_breakdown(manager_info);
+			}
+			// print persistence instructions of each phase
+			if constexpr (ENABLE_PERSIST_COUNTER) {
+				print_persist_breakdown(manager_info);
+			}
+			// print hardware events of each phase
+			if constexpr (util::listener::ENABLE_PAPI_COUNTER) {
+				print_papi_breakdown(manager_info);
+			}
+			// print keys incurring validation failure most
+			cc::ConflictTracker::get_summary_tracker().print_summary();
+			cc::ConflictTracker::get_summary_tracker().clear_up();
+			// print persistence traffic on emulated PMEM
+			if constexpr (is_pmem_emulated()) {
+				NVMEmulator::print_summary();
+			}
+			// dump throughput and latency sampled during the run
+			if constexpr (requires { transaction_manager.get_time_series(); }) {
+				dump_time_series(transaction_manager.get_time_series(), thread_num, offered_load);
+			}
+			// dump timeline of each thread
+			if constexpr (util::ENABLE_EVENT_TRACE) {
+				dump_event_trace(thread_num, offered_load);
+			}
+
+			return manager_info;
+		}
+
+		//! @brief Print achieved throughput and latency against offered load.
+		static void print_load_curve(uint32_t thread_num, const std::vector<transaction::TransactionManagerInfo> &curve) {
+			util::print_property_header(std::format("Throughput-Latency Curve ({} threads)", thread_num));
+			std::cout << "\e[32m" << std::left
+			          << std::format("{:>14}\t{:>14}\t{:>14}\t{:>14}\t{:>14}\t{:>14}\n",
+			                         "Offered(txn/s)", "Achieved(txn/s)", "Abort(%)", "p50(ns)", "p99(ns)", "p99.9(ns)");
+			for (const auto &info: curve) {
+				std::cout << std::format("{:>14}\t{:>14}\t{:>14.2f}\t{:>14}\t{:>14}\t{:>14}\n",
+				                         static_cast<uint64_t>(info.offered_load_),
+				                         (info.total_tx_ - info.abort_tx_) * 1000 / info.total_running_time_,
+				                         static_cast<double>(info.abort_tx_) * 100.0 / std::max<uint64_t>(info.total_tx_, 1),
+				                         info.response_latency_50_, info.response_latency_99_, info.response_latency_999_);
+			}
+			std::cout << "\e[0m" << std::endl;
+		}
+
+		//! @brief Print statistics of each transaction type which has been executed.
+		static void print_type_breakdown(const transaction::TransactionManagerInfo &manager_info) {
+			util::print_property_header("Transaction Type Breakdown");
+			std::cout << "\e[32m" << std::left
+			          << std::format("{:20}\t{:>12}\t{:>12}\t{:>10}\t{:>12}\t{:>12}\t{:>12}\n",
+			                         "Type", "Commit tx", "Abort tx", "Abort(%)", "p50(ns)", "p99(ns)", "max(ns)");
+			uint32_t type_tag = 0;
+			for (const char *type_name: WorkloadType::TransactionTypeNameDefinition) {
+				if (type_tag >= cc::MAX_TRANSACTION_TYPE_NUM) { break; }
+				const auto &type_info = manager_info.type_info_[type_tag++];
+				if (type_info.total_tx_ == 0) { continue; }
+				std::cout << std::format("{:20}\t{:>12}\t{:>12}\t{:>10.2f}\t{:>12}\t{:>12}\t{:>12}\n",
+				                         type_name, type_info.total_tx_ - type_info.abort_tx_, type_info.abort_tx_,
+				                         static_cast<double>(type_info.abort_tx_) * 100.0 / type_info.total_tx_,
+				                         type_info.latency_50_, type_info.latency_99_, type_info.latency_max_);
+			}
+			std::cout << "\e[0m" << std::endl;
+		}
+
+		//! @brief Print aborted attempts and time wasted by them of each reason.
+		static void print_abort_breakdown(const transaction::TransactionManagerInfo &manager_info) {
+			uint64_t total_abort_tx = 0;
+			for (const auto &reason_info: manager_info.reason_info_) { total_abort_tx += reason_info.abort_tx_; }
+			total_abort_tx = std::max<uint64_t>(total_abort_tx, 1);
+
+			util::print_property_header("Abort Reason Breakdown");
+			std::cout << "\e[32m" << std::left
+			          << std::format("{:20}\t{:>12}\t{:>10}\t{:>14}\t{:>14}\t{:>14}\n",
+			                         "Reason", "Abort tx", "Share(%)", "Wasted p50(ns)", "Wasted p99(ns)", "Wasted(ms)");
+			for (uint32_t reason = 0; reason < cc::ABORT_REASON_NUM; ++reason) {
+				const auto &reason_info = manager_info.reason_info_[reason];
+				if (reason_info.abort_tx_ == 0) { continue; }
+				std::cout << std::format("{:20}\t{:>12}\t{:>10.2f}\t{:>14}\t{:>14}\t{:>14.3f}\n",
+				                         cc::AbortReasonName[reason], reason_info.abort_tx_,
+				                         static_cast<double>(reason_info.abort_tx_) * 100.0 / total_abort_tx,
+				                         reason_info.wasted_time_50_, reason_info.wasted_time_99_,
+				                         static_cast<double>(reason_info.total_wasted_time_) / 1'000'000);
+			}
+			std::cout << "\e[0m" << std::endl;
+		}
+
+		//! @brief Print flushed cache lines and fences of each phase per committed transaction.
+		static void print_persist_breakdown(const transaction::TransactionManagerInfo &manager_info) {
+			const uint64_t commit_tx = std::max<uint64_t>(manager_info.total_tx_ - manager_info.abort_tx_, 1);
+			uint64_t total_line_num = 0, total_fence_num = 0;
+
+			util::print_property_header("Persistence Instructions per Committed tx");
+			std::cout << "\e[32m" << std::left
+			          << std::format("{:20}\t{:>14}\t{:>14}\n", "Phase", "Lines", "Fences");
+			for (uint32_t phase = 0; phase <= cc::RECORD_EVENT_NUM; ++phase) {
+				const uint64_t line_num  = manager_info.persist_flush_line_num_[phase];
+				const uint64_t fence_num = manager_info.persist_fence_num_[phase];
+				total_line_num  += line_num;
+				total_fence_num += fence_num;
+				if (line_num == 0 && fence_num == 0) { continue; }
+				// Instructions in total phase are those between other phases
+				std::cout << std::format("{:20}\t{:>14.3f}\t{:>14.3f}\n",
+				                         phase == cc::RECORD_EVENT_NUM ? "out of phase" : cc::RecordEventName[phase],
+				                         static_cast<double>(line_num) / commit_tx,
+				                         static_cast<double>(fence_num) / commit_tx);
 			}
+			std::cout << std::format("{:20}\t{:>14.3f}\t{:>14.3f}\n", "all",
+			                         static_cast<double>(total_line_num) / commit_tx,
+			                         static_cast<double>(total_fence_num) / commit_tx);
+			std::cout << "\e[0m" << std::endl;
+		}
+
+		//! @brief Print hardware events of each phase per committed transaction.
+		static void print_papi_breakdown(const transaction::TransactionManagerInfo &manager_info) {
+			using util::listener::PAPICounter;
+
+			const uint64_t commit_tx = std::max<uint64_t>(manager_info.total_tx_ - manager_info.abort_tx_, 1);
+			std::array<uint64_t, PAPICounter::EVENT_NUM> total_event_num{};
+
+			util::print_property_header("Hardware Events per Committed tx");
+			std::cout << "\e[32m" << std::left << std::format("{:20}", "Phase");
+			for (const char *event_name: PAPICounter::EVENT_NAME) {
+				std::cout << std::format("\t{:>14}", event_name);
+			}
+			std::cout << '\n';
+			for (uint32_t phase = 0; phase < cc::RECORD_EVENT_NUM; ++phase) {
+				const auto &event_num = manager_info.papi_event_num_[phase];
+				if (std::ranges::all_of(event_num, [](uint64_t num) { return num == 0; })) { continue; }
+				// Events in total phase are those between other phases
+				std::cout << std::format("{:20}", cc::RecordEventName[phase]);
+				for (uint32_t event = 0; event < PAPICounter::EVENT_NUM; ++event) {
+					total_event_num[event] += event_num[event];
+					std::cout << std::format("\t{:>14.1f}", static_cast<double>(event_num[event]) / commit_tx);
+				}
+				std::cout << '\n';
+			}
+			std::cout << std::format("{:20}", "all");
+			for (uint32_t event = 0; event < PAPICounter::EVENT_NUM; ++event) {
+				std::cout << std::format("\t{:>14.1f}", static_cast<double>(total_event_num[event]) / commit_tx);
+			}
+			std::cout << "\n\e[0m" << std::endl;
+		}
+
+		//! @brief Dump time series into csv and json files named by the number of threads and offered load.
+		static void dump_time_series(const auto &time_series, uint32_t thread_num, double offered_load) {
+			if (time_series.get_samples().empty()) { return; }
+
+			std::string file_name = "time_series_" + std::to_string(thread_num);
+			if (offered_load > 0) { file_name += "_" + std::to_string(static_cast<uint64_t>(offered_load)); }
+			std::ofstream csv_file(file_name + ".csv");
+			time_series.dump_csv(csv_file);
+			std::ofstream json_file(file_name + ".json");
+			time_series.dump_json(json_file);
+			spdlog::info("Time series: {}.csv, {}.json", file_name, file_name);
+		}
+
+		//! @brief Dump events traced into a json file named by the number of threads and offered load,
+		//! which can be opened by chrome://tracing or Perfetto.
+		static void dump_event_trace(uint32_t thread_num, double offered_load) {
+			std::string file_name = "trace_" + std::to_string(thread_num);
+			if (offered_load > 0) { file_name += "_" + std::to_string(static_cast<uint64_t>(offered_load)); }
+			std::ofstream json_file(file_name + ".json");
+			util::EventTracer::dump_json(json_file);
+			util::EventTracer::clear();
+			spdlog::info("Event trace: {}.json", file_name);
 		}
 	};
 }
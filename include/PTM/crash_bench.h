@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cstdint>
+#include <csignal>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <filesystem>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+#include <util/crash_injector.h>
+#include <util/random_generator.h>
+#include <recovery/abstract_recovery.h>
+#include <global_config/global_config.h>
+
+namespace ptm {
+
+	/*!
+	 * @brief Bench of crash consistency and recovery.
+	 * Each round runs the workload in a child process which is killed at a random moment, then recovers
+	 * in another child process on persistent memory left behind and checks invariants of the workload.
+	 * Killing by SIGKILL loses volatile state only, thus PMEM is required to be emulated on DRAM, where
+	 * files can be cleaned up between rounds.
+	 */
+	template<class GlobalConfig>
+	class crash_bench {
+		static_assert(util::ENABLE_CRASH_INJECTION, "Crash bench requires ENABLE_CRASH_INJECTION_DEFINED=true");
+
+	public:
+		using ConcurrentControl  = GlobalConfig::ConcurrentControl;
+
+		using TransactionManager = GlobalConfig::TransactionManager;
+
+		using StorageManager     = GlobalConfig::StorageManager;
+
+		using WorkloadType       = GlobalConfig::WorkloadType;
+
+		static constexpr auto ThreadBindStrategy = GlobalConfig::ThreadBindStrategy;
+
+		/// The maximum hit count before crash at a crash point
+		static constexpr uint64_t MAX_CRASH_HIT_NUM = 100'000;
+
+		enum class CrashMode {
+			/// Killed by the parent after a random delay
+			Kill,
+			/// Crash before appending the commit log
+			WriteLog,
+			/// Crash after persisting a batch of data
+			ProcessBatch
+		};
+
+		static constexpr const char *CrashModeName[] = { "kill", "write_log", "process_batch" };
+
+		static constexpr uint32_t CRASH_MODE_NUM = std::size(CrashModeName);
+
+		//! @brief Result of a round, shared between processes.
+		struct RoundResult {
+			CrashMode mode;
+			/// Delay before kill(ms) or hit count of the crash point
+			uint64_t crash_param;
+			/// Set by the running process once initialization finishes
+			std::atomic<bool> started;
+			/// Whether the running process was killed rather than exited
+			bool crashed;
+			/// Whether the recovering process exited normally
+			bool recovered;
+
+			bool consistent;
+
+			recovery::RecoveryStatistics statistics;
+		};
+
+	public:
+		crash_bench() {}
+
+		/*!
+		 * @brief Turn bench on
+		 * @param ROUND_NUM The number of crash-recovery rounds
+		 * @param THREAD_NUM The number of workers running before crash
+		 * @param MAX_RUN_TIME_MILLISECOND The maximum running time before crash
+		 * @return The number of rounds recovered consistently
+		 */
+		uint32_t run(uint32_t ROUND_NUM, uint32_t THREAD_NUM, uint32_t MAX_RUN_TIME_MILLISECOND) {
+			if constexpr (!is_pmem_emulated()) {
+				spdlog::error("Crash bench requires PMEM emulated on DRAM");
+				return 0;
+			}
+			else if constexpr (!requires (ConcurrentControl &cc) { cc.recovery(); }) {
+				spdlog::error("Recovery is not supported by the concurrent control");
+				return 0;
+			}
+			else {
+				auto *result_array = static_cast<RoundResult *>(mmap(nullptr, sizeof(RoundResult) * ROUND_NUM,
+				                                                     PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+				if (result_array == MAP_FAILED) {
+					perror("ERROR: mmap() is not working !!! ");
+					exit(-1);
+				}
+
+				for (uint32_t round = 0; round < ROUND_NUM; ++round) {
+					RoundResult &result = *new (&result_array[round]) RoundResult{};
+					result.mode = static_cast<CrashMode>(util::rander.rand_range(0U, CRASH_MODE_NUM - 1));
+					result.crash_param = (result.mode == CrashMode::Kill) ?
+					                     util::rander.rand_range<uint64_t>(1, MAX_RUN_TIME_MILLISECOND) :
+					                     util::rander.rand_range<uint64_t>(1, MAX_CRASH_HIT_NUM);
+
+					spdlog::info("Round {}: crash mode {}, parameter {}", round, CrashModeName[static_cast<uint32_t>(result.mode)], result.crash_param);
+					clear_persistent_files();
+					run_round(result, THREAD_NUM, MAX_RUN_TIME_MILLISECOND);
+				}
+
+				const uint32_t consistent_num = print_summary(result_array, ROUND_NUM);
+				munmap(result_array, sizeof(RoundResult) * ROUND_NUM);
+				clear_persistent_files();
+				return consistent_num;
+			}
+		}
+
+	private:
+		void run_round(RoundResult &result, uint32_t thread_num, uint32_t max_run_time) {
+			// ------ Run until crash
+			pid_t pid = fork_process();
+			if (pid == 0) {
+				run_process(result, thread_num, max_run_time);
+			}
+
+			int status = 0;
+			bool reaped = false;
+			if (result.mode == CrashMode::Kill) {
+				// Start timing after initialization, which is not the concern
+				while (!result.started.load(std::memory_order::acquire)) {
+					// The process may exit before starting, then it has been reaped
+					if (waitpid(pid, &status, WNOHANG) == pid) { reaped = true; break; }
+					std::this_thread::sleep_for(std::chrono::milliseconds{1});
+				}
+				if (!reaped) {
+					std::this_thread::sleep_for(std::chrono::milliseconds{result.crash_param});
+					kill(pid, SIGKILL);
+				}
+			}
+			if (!reaped) { status = wait_process(pid); }
+			result.crashed = WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL;
+
+			// ------ Recover
+			pid = fork_process();
+			if (pid == 0) {
+				recover_process(result);
+			}
+			status = wait_process(pid);
+			result.recovered = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+			if (!result.recovered) {
+				spdlog::error("Recovery process exits abnormally");
+			}
+		}
+
+		[[noreturn]] static void run_process(RoundResult &result, uint32_t thread_num, uint32_t max_run_time) {
+			StorageManager storage_manager;
+			for (TableScheme table_scheme: WorkloadType::TableSchemeSizeDefinition) {
+				storage_manager.add_table(table_scheme.tuple_size, table_scheme.max_tuple_num);
+			}
+			TransactionManager transaction_manager(ThreadBindStrategy, &storage_manager);
+			cc::ConcurrentControlMessage::disable_record();
+
+			transaction_manager.init();
+			if (result.mode == CrashMode::WriteLog) {
+				util::CrashInjector::arm("write_log", result.crash_param);
+			}
+			else if (result.mode == CrashMode::ProcessBatch) {
+				util::CrashInjector::arm("process_batch", result.crash_param);
+			}
+			result.started.store(true, std::memory_order::release);
+
+			transaction_manager.run(thread_num, std::chrono::milliseconds(max_run_time));
+			// Leave without tearing down even if no crash point is hit
+			std::_Exit(0);
+		}
+
+		[[noreturn]] static void recover_process(RoundResult &result) {
+			util::CrashInjector::set_restarted(true);
+
+			StorageManager storage_manager;
+			for (TableScheme table_scheme: WorkloadType::TableSchemeSizeDefinition) {
+				storage_manager.add_table(table_scheme.tuple_size, table_scheme.max_tuple_num);
+			}
+			TransactionManager transaction_manager(ThreadBindStrategy, &storage_manager);
+			cc::ConcurrentControlMessage::disable_record();
+
+			result.statistics = transaction_manager.recover();
+			result.consistent = transaction_manager.check_consistency();
+			std::_Exit(0);
+		}
+
+		static pid_t fork_process() {
+			pid_t pid = fork();
+			if (pid < 0) {
+				perror("ERROR: fork() is not working !!! ");
+				exit(-1);
+			}
+			return pid;
+		}
+
+		//! @brief Wait for a child process.
+		//! @return Status of the process
+		static int wait_process(pid_t pid) {
+			int status = 0;
+			while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+			return status;
+		}
+
+		//! @brief Remove files of emulated PMEM, so that each round starts from scratch.
+		static void clear_persistent_files() {
+			std::error_code ec;
+			for (const char *dir_name: allocator::GLOBAL_DATA_MEM_DIR_PATH) {
+				std::filesystem::remove_all(get_mapped_dir(dir_name), ec);
+			}
+			for (const char *dir_name: logm::GLOBAL_LOG_MEM_DIR_PATH) {
+				std::filesystem::remove_all(get_mapped_dir(dir_name), ec);
+			}
+			std::filesystem::remove(get_mapped_dir(ix::INDEX_PMEM_DIR_NAME) + '/' + ix::INDEX_FILE_NAME, ec);
+			std::filesystem::remove(get_mapped_dir(ix::INDEX_DRAM_DIR_NAME) + '/' + ix::INDEX_FILE_NAME, ec);
+		}
+
+		static uint32_t print_summary(const RoundResult *result_array, uint32_t round_num) {
+			GlobalConfig::print_property();
+
+			uint32_t consistent_num = 0;
+			util::print_property_header("Crash Recovery Summary");
+			std::cout << "\e[32m" << std::left
+			          << std::format("{:>6}\t{:14}\t{:>10}\t{:>8}\t{:>12}\t{:>12}\t{:>12}\t{:>12}\t{:>12}\t{:>12}\t{:>12}\n",
+			                         "Round", "Mode", "Param", "Crashed", "Data(ms)", "Log(ms)", "Replay(ms)",
+			                         "Data(B)", "Log(B)", "Updates", "Consistent");
+			for (uint32_t round = 0; round < round_num; ++round) {
+				const RoundResult &result = result_array[round];
+				const bool passed = result.recovered && result.consistent;
+				consistent_num += passed;
+				std::cout << std::format("{:>6}\t{:14}\t{:>10}\t{:>8}\t{:>12}\t{:>12}\t{:>12}\t{:>12}\t{:>12}\t{:>12}\t{:>12}\n",
+				                         round, CrashModeName[static_cast<uint32_t>(result.mode)], result.crash_param,
+				                         result.crashed ? "yes" : "no",
+				                         result.statistics.data_iteration_time, result.statistics.log_iteration_time,
+				                         result.statistics.replay_time, result.statistics.data_size,
+				                         result.statistics.log_size, result.statistics.replay_update_num,
+				                         passed ? "yes" : "NO");
+			}
+			std::cout << std::format("Consistent rounds: {}/{}\n", consistent_num, round_num);
+			std::cout << "\e[0m" << std::endl;
+			return consistent_num;
+		}
+	};
+
+}
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <utility>
 #include <magic_enum.hpp>
 
 #include <thread_allocator/thread_allocator.h>
@@ -40,6 +41,47 @@ namespace ptm {
 
 	using StorageManagerType       = storage::StorageManagerType;
 
+	// Per-table storage layout
+
+	//! @brief Resolve the index of a table from its hint.
+	template<IndexType DefaultIndexTp>
+	constexpr IndexType get_table_index_type(workload::TableIndexHint hint) {
+		switch (hint) {
+			case workload::TableIndexHint::Direct:  return IndexType::Array;
+			case workload::TableIndexHint::Hash:    return IndexType::HashMap;
+			case workload::TableIndexHint::Ordered: return IndexType::BPTree;
+			default:                                return DefaultIndexTp;
+		}
+	}
+
+	//! @brief Resolve the media of a table from its hint.
+	constexpr storage::TableMedia get_table_media(workload::TableMediaHint hint) {
+		switch (hint) {
+			case workload::TableMediaHint::DRAM: return storage::TableMedia::DRAM;
+			case workload::TableMediaHint::PMEM: return storage::TableMedia::PMEM;
+			default:                             return storage::TableMedia::Default;
+		}
+	}
+
+	/*!
+	 * @brief Layouts of all tables of workload, which are resolved at compile time from the table
+	 * scheme, so that the storage manager is able to dispatch to data managers statically.
+	 */
+	template<class Workload, IndexType DefaultIndexTp>
+	struct TableLayoutManager {
+	private:
+		template<size_t ...I>
+		static auto make_table_layout(std::index_sequence<I...>) -> storage::TableLayoutList<
+				storage::TableLayout<
+						get_table_index_type<DefaultIndexTp>(Workload::TableSchemeSizeDefinition.begin()[I].index_hint),
+						get_table_media(Workload::TableSchemeSizeDefinition.begin()[I].media_hint)
+				>...
+		>;
+
+	public:
+		using TableLayouts = decltype(make_table_layout(std::make_index_sequence<Workload::TableSchemeSizeDefinition.size()>{}));
+	};
+
 	// Global Configuration Manager
 
 	template<
@@ -61,12 +103,18 @@ namespace ptm {
 
 		using VersionHeaderType   = cc::ConcurrentControlBasicManager<ConcurrentControlTp, WorkloadType>::VersionHeaderType;
 
-		using StorageManager      = storage::StorageManagerManager<StorageManagerTp, KeyType, DataTupleHeaderType, IndexTupleType, DataIndexTp, VersionHeaderType>::StorageManager;
+		using TableLayouts        = TableLayoutManager<WorkloadType, DataIndexTp>::TableLayouts;
+
+		using StorageManager      = storage::StorageManagerManager<StorageManagerTp, KeyType, DataTupleHeaderType, IndexTupleType, DataIndexTp, VersionHeaderType, TableLayouts>::StorageManager;
 
 		using ConcurrentControl   = cc::ConcurrentControlManager<ConcurrentControlTp, WorkloadType, StorageManager>::ConcurrentControl;
 
 		using TransactionManager  = transaction::TransactionManagerManager<TransactionManagerTp, WorkloadType, ConcurrentControl>::TransactionManager;
 
+		static_assert(!workload::is_variable_length_workload<WorkloadType>()
+		              || requires { requires ConcurrentControl::SUPPORT_VARIABLE_LENGTH_TUPLE; },
+		              "Variable-length tuples are not supported by the concurrent control");
+
 		static constexpr auto ThreadBindStrategy = ThreadBindStrategyTp;
 
 		static void print_property() {
@@ -95,10 +95,13 @@ int main() {
 	/// Duration in millisecond for each test.
 	constexpr uint32_t test_time_millisecond = 60'000;
 
+	/// Offered loads(txn/s) to sweep in open-loop mode, leave empty for closed-loop mode.
+	const std::vector<double> test_offered_load{};
+
 	// Test bench
 	ptm::bench<GlobalConfig> bench;
 	// Start bench
-	bench.run(test_thread_num, test_time_millisecond, true);
+	bench.run(test_thread_num, test_time_millisecond, true, test_offered_load);
 
 	return 0;
 }
\ No newline at end of file
@@ -34,6 +34,7 @@ namespace datam {
 			DataManager::IndexTupleType &index_tuple,
 			DataManager::DataTupleHeaderType *data_tuple_header_ptr,
 			void *data_ptr,
+			size_t data_size,
 			std::function<void(const typename DataManager::IndexTupleType &)> deallocate_func) {
 
 		/*
@@ -62,16 +63,23 @@ namespace datam {
 		{ manager.delete_data_index_tuple(data_key) } -> std::same_as<bool>;
 		// Require read interface
 		{ manager.read_data_index_tuple(data_key, index_tuple) } -> std::same_as<bool>;
+		// Require update interface
+		{ manager.update_data_index_tuple(data_key, index_tuple) } -> std::same_as<bool>;
 
 		// Require allocate interface
 		{ manager.allocate_data_and_header() } -> std::same_as<std::pair<decltype(data_tuple_header_ptr), decltype(data_ptr)>>;
 		{ manager.allocate_data() } -> std::same_as<decltype(data_ptr)>;
 		{ manager.allocate_header() } -> std::same_as<decltype(data_tuple_header_ptr)>;
+		// Require allocate interface for variable-length tuples
+		{ manager.allocate_data_and_header(data_size) } -> std::same_as<std::pair<decltype(data_tuple_header_ptr), decltype(data_ptr)>>;
 		// Require deallocate interface
 		{ manager.deallocate_data_and_header(data_ptr) } -> std::same_as<bool>;
 		{ manager.deallocate_data(data_ptr) } -> std::same_as<bool>;
 		{ manager.deallocate_header(data_tuple_header_ptr) } -> std::same_as<bool>;
+		{ manager.deallocate_data_and_header(data_tuple_header_ptr, data_ptr, data_size) } -> std::same_as<bool>;
 
 		{ manager.register_deallocate_data_func(deallocate_func) } -> std::same_as<void>;
+		// Free all tuples left in index by the registered function
+		{ manager.clear_data_index() } -> std::same_as<void>;
 	};
 }
@@ -9,6 +9,7 @@
 
 #include <data_manager/simple_data_manager/dram_data_manager.h>
 #include <data_manager/simple_data_manager/pmem_data_manager.h>
+#include <data_manager/tiered_data_manager/tiered_data_manager.h>
 
 namespace datam {
 
@@ -16,6 +17,8 @@ namespace datam {
 		DRAM,
 		PMEM,
 		PMEM_NUMA,
+		/// Hot tuples in DRAM and cold ones in PMEM
+		TIERED,
 	};
 
 	template<DataManagerKind Type, class Key, class TupleHeader, class IndexTuple, IndexType IndexTp>
@@ -37,4 +40,11 @@ namespace datam {
 		static_assert(DataManagerConcept<DataManager>);
 	};
 
+	template<class Key, class TupleHeader, class IndexTuple, IndexType IndexTp>
+	struct DataManagerManager<DataManagerKind::TIERED, Key, TupleHeader, IndexTuple, IndexTp> {
+		using DataManager = TieredDataManager<Key, TupleHeader, IndexTuple, IndexTp>;
+
+		static_assert(DataManagerConcept<DataManager>);
+	};
+
 }
@@ -14,7 +14,7 @@ namespace datam {
 
 	template<class Key, class TupleHeader, class IndexTuple, IndexType IndexTp>
 	struct PMEMDataManagerBasic {
-		using DataAllocator = allocator::SimplePmemAllocator;
+		using DataAllocator = allocator::SlabPmemAllocator;
 
 		using DataIndex = ix::IndexManager<IndexTp, Key, IndexTuple>::Index;
 	};
@@ -46,7 +46,7 @@ namespace datam {
 
 		static constexpr StorageMemType get_data_storage_memtype() { return DATA_STORAGE_MEM_TYPE; };
 
-		using DataAllocator = allocator::SimplePmemAllocator;
+		using DataAllocator = allocator::SlabPmemAllocator;
 		static_assert(allocator::MemAllocatorConcept<DataAllocator>);
 
 		static constexpr size_t ALLOC_ALIGN_SIZE = DataAllocator::ALLOC_ALIGN_SIZE;
@@ -5,6 +5,12 @@
 
 #pragma once
 
+#include <array>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
 #include <data_manager/abstract_data_manager.h>
 #include <mem_allocator/mem_allocator.h>
 
@@ -23,28 +29,91 @@ namespace datam {
 
 		static constexpr size_t DATA_ALLOC_ALIGN_SIZE    = std::min(VHEADER_ALLOC_ALIGN_SIZE, 16UL);
 
+		/*
+		 * Size classes for variable-length tuples
+		 */
+
+		/// Block size of the smallest size class
+		static constexpr size_t MIN_CLASS_BLOCK_SIZE = std::max(VHEADER_ALLOC_ALIGN_SIZE, 64UL);
+
+		static constexpr uint32_t MAX_SIZE_CLASS_NUM = 8;
+		/// Size class of the block holding a whole tuple
+		static constexpr uint32_t FULL_SIZE_CLASS    = MAX_SIZE_CLASS_NUM;
+
+		/// Whether allocators can be mapped by name, which is required to find size classes again in recovery
+		static constexpr bool NAMED_CLASS_ALLOCATOR  = std::is_constructible_v<DataAllocator, const std::string &, size_t, size_t>;
+
 	private:
+		struct SizeClass {
+			size_t block_size;
+
+			std::once_flag init_flag;
+			/// Created on the first allocation
+			std::unique_ptr<DataAllocator> allocator_ptr;
+		};
+
+	private:
+		/// Size of header, aligned for data following it
+		size_t header_size_;
+
 		size_t data_size_;
 
+		size_t expected_amount_;
+
 		DataIndex data_index_;
 
 		DataAllocator data_allocator_;
 
+		/// The number of size classes smaller than a whole tuple
+		uint32_t size_class_num_;
+
+		std::array<SizeClass, MAX_SIZE_CLASS_NUM> size_class_array_;
+
+		/// Prefix of file names of size classes, reserved at construction to keep names the same among runs
+		std::string class_file_name_;
+
 		std::function<void(const IndexTupleType &)> data_deallocate_func = [](const IndexTupleType &){};
 
 
 	public:
 		SimpleDataManagerTemplate(size_t tuple_size, size_t expected_amount):
-			data_size_(tuple_size +  align_ceil(sizeof(DataTupleHeaderType), DATA_ALLOC_ALIGN_SIZE)),
+			header_size_(align_ceil(sizeof(DataTupleHeaderType), DATA_ALLOC_ALIGN_SIZE)),
+			data_size_(tuple_size + header_size_),
+			expected_amount_(expected_amount),
 			data_index_(sizeof(IndexTupleType), expected_amount),
-			data_allocator_(data_size_, expected_amount) {}
+			data_allocator_(data_size_, expected_amount),
+			size_class_num_(0),
+			class_file_name_(allocate_file_name()) {
+
+			// Classes larger than half of a whole tuple save little, leave them to the full block
+			for (size_t block_size = MIN_CLASS_BLOCK_SIZE;
+			     block_size * 2 <= data_size_ && size_class_num_ < MAX_SIZE_CLASS_NUM;
+			     block_size *= 2) {
+				// Blocks holding nothing but header are useless
+				if (block_size <= header_size_) { continue; }
+				size_class_array_[size_class_num_++].block_size = block_size;
+			}
+		}
 
 		~SimpleDataManagerTemplate() {
-			data_index_.clear(data_deallocate_func);
+			clear_data_index();
 		}
 
+		/*!
+		 * @brief Iterate blocks of whole tuples, as well as those of size classes used by the former run.
+		 * Each block holds header followed by payload in both cases.
+		 */
 		void recovery_iteration(std::function<bool(void *data_ptr)> &callback_func) {
 			data_allocator_.recovery_iteration(callback_func);
+
+			if constexpr (NAMED_CLASS_ALLOCATOR) {
+				for (uint32_t i = 0; i < size_class_num_; ++i) {
+					SizeClass &size_class = size_class_array_[i];
+					if (DataAllocator::has_file(get_class_file_name(size_class))) {
+						get_class_allocator(size_class).recovery_iteration(callback_func);
+					}
+				}
+			}
 		}
 
 	public:
@@ -60,6 +129,10 @@ namespace datam {
 			return data_index_.read(data_key, dst_index_tuple);
 		}
 
+		bool update_data_index_tuple(DataKeyType data_key, const IndexTupleType &src_index_tuple) {
+			return data_index_.update(data_key, src_index_tuple);
+		}
+
 		std::pair<DataTupleHeaderType *, void *> allocate_data_and_header() {
 			auto *res = static_cast<DataTupleHeaderType *>(data_allocator_.allocate(data_size_));
 			return {res, res + 1};
@@ -70,6 +143,31 @@ namespace datam {
 			return true;
 		}
 
+		/*!
+		 * @brief Allocate a tuple by the actual size of payload.
+		 * Tuples are placed in the smallest size class fitting them, or in a full block if none fits.
+		 * @param size Size of payload, which should not exceed the tuple size of table
+		 */
+		std::pair<DataTupleHeaderType *, void *> allocate_data_and_header(size_t size) {
+			DEBUG_ASSERT(size + header_size_ <= data_size_);
+			const uint32_t class_idx = get_size_class(size);
+			if (class_idx == FULL_SIZE_CLASS) { return allocate_data_and_header(); }
+
+			SizeClass &size_class = size_class_array_[class_idx];
+			auto *res = static_cast<DataTupleHeaderType *>(get_class_allocator(size_class).allocate(size_class.block_size));
+			return {res, res + 1};
+		}
+
+		//! @brief Deallocate a tuple allocated by the actual size of payload.
+		bool deallocate_data_and_header(DataTupleHeaderType *header_ptr, void *data_ptr, size_t size) {
+			const uint32_t class_idx = get_size_class(size);
+			if (class_idx == FULL_SIZE_CLASS) { return deallocate_data_and_header(data_ptr); }
+
+			SizeClass &size_class = size_class_array_[class_idx];
+			size_class.allocator_ptr->deallocate(header_ptr, size_class.block_size);
+			return true;
+		}
+
 		void *allocate_data() {
 			spdlog::error("This Data Manager DO NOT support (de)allocate data tuple and header separately.");
 			return nullptr;
@@ -93,6 +191,38 @@ namespace datam {
 		void register_deallocate_data_func(const std::function<void(const IndexTupleType &)> &deallocate_func) {
 			data_deallocate_func = deallocate_func;
 		}
+
+		//! @brief Free all tuples left in index by the registered function
+		void clear_data_index() {
+			data_index_.clear(data_deallocate_func);
+		}
+
+	private:
+		uint32_t get_size_class(size_t size) const {
+			const size_t block_size = size + header_size_;
+			for (uint32_t i = 0; i < size_class_num_; ++i) {
+				if (block_size <= size_class_array_[i].block_size) { return i; }
+			}
+			return FULL_SIZE_CLASS;
+		}
+
+		std::string get_class_file_name(const SizeClass &size_class) const {
+			return class_file_name_ + "_" + std::to_string(size_class.block_size);
+		}
+
+		DataAllocator &get_class_allocator(SizeClass &size_class) {
+			std::call_once(size_class.init_flag, [this, &size_class]() {
+				if constexpr (NAMED_CLASS_ALLOCATOR) {
+					size_class.allocator_ptr = std::make_unique<DataAllocator>(
+							get_class_file_name(size_class), size_class.block_size, expected_amount_
+					);
+				}
+				else {
+					size_class.allocator_ptr = std::make_unique<DataAllocator>(size_class.block_size, expected_amount_);
+				}
+			});
+			return *size_class.allocator_ptr;
+		}
 	};
 }
 
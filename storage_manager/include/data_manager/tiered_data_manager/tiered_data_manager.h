@@ -0,0 +1,574 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <bit>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <tbb/concurrent_queue.h>
+#include <tbb/concurrent_hash_map.h>
+#include <spdlog/spdlog.h>
+
+#include <util/simple_hash.h>
+#include <thread/epoch_manager.h>
+#include <memory/nvm_config.h>
+#include <mem_allocator/mem_allocator.h>
+#include <data_manager/abstract_data_manager.h>
+#include <data_manager/simple_data_manager/simple_data_manager.h>
+
+namespace datam {
+
+	/*!
+	 * @brief Concept about index tuple able to be cached in another block while transactions are running.
+	 * With the write lock of origin held, make_cached() copies header and data into the cache block and keeps
+	 * the origin as home, into which set_data() writes through. get_home_tuple() and write_back_version()
+	 * move the tuple back home, and invalidate_migrated() makes every transaction having read a dropped
+	 * cache block fail in validation.
+	 */
+	template<class IndexTuple, class DataTupleHeader>
+	concept MigratableIndexTupleConcept = requires(const IndexTuple tuple, DataTupleHeader *header_ptr, void *data_ptr) {
+		{ tuple.try_lock_write() } -> std::same_as<bool>;
+		{ tuple.unlock_write() } -> std::same_as<void>;
+		{ tuple.get_data_ptr() } -> std::convertible_to<void *>;
+		{ tuple.get_home_data_ptr() } -> std::convertible_to<void *>;
+		{ tuple.make_cached(header_ptr, data_ptr) } -> std::same_as<IndexTuple>;
+		{ tuple.get_home_tuple(header_ptr) } -> std::same_as<IndexTuple>;
+		{ tuple.write_back_version(tuple) } -> std::same_as<void>;
+		{ tuple.invalidate_migrated() } -> std::same_as<void>;
+	};
+
+	/*!
+	 * @brief Data manager keeping hot tuples in a read cache of fast tier(DRAM), while all tuples live in a slow tier(PMEM).
+	 * Tuples are inserted into the slow tier, which stays the durable home of each tuple. Sampled index reads
+	 * feed a count-min sketch, and a tuple estimated over PROMOTE_THRESHOLD is queued for promotion
+	 * while it is left in the slow tier, so that tuples failing promotion are queued again by later accesses. A background migrator copies queued tuples into the fast tier, drops cached copies
+	 * whose estimated frequency has decayed once the fast tier is filled over the watermark, and halves the sketch
+	 * every DECAY_INTERVAL.
+	 *
+	 * Cached tuples are written through to their homes, so that recovery_iteration over the slow tier
+	 * is complete without redo logs of cached updates. Hence reads and timestamp checks of hot tuples are
+	 * served by DRAM, while their updates still persist data into PMEM. Each cache block keeps the header pointer of its home after the tuple, by which both are
+	 * freed together on deletion.
+	 * Homes are never marked in their persistent headers. Instead, homes of cached tuples are kept in
+	 * a volatile table, which concurrent controls check by is_migrated() in validation, so that transactions
+	 * having read a home before promotion abort. The timestamp of a home is only replaced on demotion.
+	 * A counting filter over home addresses screens the check, so that validated reads of most uncached
+	 * tuples cost one counter load instead of a table probe.
+	 *
+	 * Migration relies on MigratableIndexTupleConcept, and index tuples not satisfying it are never moved.
+	 * Moving a tuple under running transactions is only safe for concurrent controls validating every
+	 * timestamp read on commit(i.e. OCC), which is asserted by VALIDATE_ON_COMMIT of index tuple.
+	 * Readers should announce their epoch by thread::EpochGuard, and dropped cache blocks are freed once
+	 * every reader having seen them has left.
+	 */
+	template<class DataKey, class DataTupleHeader, class IndexTuple, class DataIndex, class FastAllocator, class SlowAllocator>
+	class TieredDataManagerTemplate {
+	public:
+		using DataKeyType         = DataKey;
+
+		using DataTupleHeaderType = DataTupleHeader;
+
+		using IndexTupleType      = IndexTuple;
+
+		static constexpr size_t VHEADER_ALLOC_ALIGN_SIZE = std::min(FastAllocator::ALLOC_ALIGN_SIZE, SlowAllocator::ALLOC_ALIGN_SIZE);
+
+		static constexpr size_t DATA_ALLOC_ALIGN_SIZE    = std::min(VHEADER_ALLOC_ALIGN_SIZE, 16UL);
+
+		static constexpr bool ENABLE_MIGRATION = MigratableIndexTupleConcept<IndexTuple, DataTupleHeader>;
+
+		static_assert(!ENABLE_MIGRATION || requires { requires IndexTuple::VALIDATE_ON_COMMIT; },
+		              "Tuples can only be moved under concurrent controls validating reads on commit");
+
+		/// The fast tier holds 1 / FAST_TIER_RATIO of expected tuples
+		static constexpr size_t FAST_TIER_RATIO     = 8;
+		/// Demotion starts once the fast tier is filled over FAST_TIER_WATERMARK / 100
+		static constexpr size_t FAST_TIER_WATERMARK = 90;
+
+		/// Only one in SAMPLE_INTERVAL index reads will be recorded into sketch
+		static constexpr uint32_t SAMPLE_INTERVAL   = 16;
+		/// Sampled accesses of a tuple to be promoted
+		static constexpr uint32_t PROMOTE_THRESHOLD = 4;
+		/// Sampled accesses below which a resident tuple is demoted
+		static constexpr uint32_t DEMOTE_THRESHOLD  = 2;
+
+		/// Counters of home filter per block of fast tier
+		static constexpr size_t HOME_FILTER_RATIO   = 4;
+
+		/// Rows of count-min sketch
+		static constexpr uint32_t SKETCH_DEPTH = 4;
+		/// Counters per row, which should be power of 2
+		static constexpr uint32_t SKETCH_WIDTH = 1 << 16;
+
+		/// The maximum number of tuples moved in one round
+		static constexpr uint32_t MIGRATE_BATCH_NUM = 256;
+
+		static constexpr auto MIGRATE_INTERVAL  = std::chrono::milliseconds(1);
+
+		static constexpr auto DECAY_INTERVAL    = std::chrono::milliseconds(200);
+
+		static_assert((SKETCH_WIDTH & (SKETCH_WIDTH - 1)) == 0);
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+	private:
+		size_t data_size_;
+
+		/// Cache blocks append the header pointer of home
+		size_t cache_size_;
+
+		DataIndex data_index_;
+
+		size_t fast_capacity_;
+
+		FastAllocator fast_allocator_;
+
+		SlowAllocator slow_allocator_;
+
+		/// Address range of fast tier
+		uint8_t *fast_start_ptr_;
+
+		uint8_t *fast_end_ptr_;
+
+		/// The number of blocks allocated in fast tier
+		std::atomic<size_t> fast_used_;
+
+		std::unique_ptr<std::atomic<uint32_t>[]> sketch_;
+
+		/// Keys waiting for promotion
+		tbb::concurrent_queue<DataKeyType> promote_queue_;
+
+		/// Keys in promote_queue_, by which each key is queued at most once
+		tbb::concurrent_hash_map<DataKeyType, bool> queued_keys_;
+
+		/// Keys resident in fast tier, scanned like a clock by migrator
+		std::deque<DataKeyType> resident_keys_;
+
+		/// Data pointers of homes whose tuples are cached in fast tier
+		tbb::concurrent_hash_map<const void *, bool> migrated_homes_;
+
+		/// Counting filter of migrated_homes_, raised before insertion and lowered after erasure
+		std::unique_ptr<std::atomic<uint32_t>[]> home_filter_;
+
+		size_t home_filter_mask_;
+
+		/// Cache blocks dropped by demotion, waiting for readers to leave
+		thread::EpochRetireList<DataTupleHeaderType *> retired_blocks_;
+
+		std::atomic<uint64_t> promote_num_;
+
+		std::atomic<uint64_t> demote_num_;
+
+		std::function<void(const IndexTupleType &)> data_deallocate_func = [](const IndexTupleType &){};
+
+		std::jthread migrator_;
+
+	public:
+		TieredDataManagerTemplate(size_t tuple_size, size_t expected_amount):
+				data_size_(tuple_size + align_ceil(sizeof(DataTupleHeaderType), DATA_ALLOC_ALIGN_SIZE)),
+				cache_size_(data_size_ + sizeof(DataTupleHeaderType *)),
+				data_index_(sizeof(IndexTupleType), expected_amount),
+				fast_capacity_(std::max<size_t>(expected_amount / FAST_TIER_RATIO, 1)),
+				fast_allocator_(cache_size_, fast_capacity_),
+				slow_allocator_(data_size_, expected_amount),
+				fast_start_ptr_(fast_allocator_.get_descriptor().start_ptr),
+				fast_end_ptr_(fast_start_ptr_ + fast_allocator_.get_descriptor().total_size),
+				fast_used_(0),
+				sketch_(std::make_unique<std::atomic<uint32_t>[]>(SKETCH_DEPTH * SKETCH_WIDTH)),
+				home_filter_(std::make_unique<std::atomic<uint32_t>[]>(std::bit_ceil(fast_capacity_ * HOME_FILTER_RATIO))),
+				home_filter_mask_(std::bit_ceil(fast_capacity_ * HOME_FILTER_RATIO) - 1),
+				promote_num_(0), demote_num_(0) {
+
+			if constexpr (ENABLE_MIGRATION) {
+				migrator_ = std::jthread([this](std::stop_token stop_token) { migrate_work(stop_token); });
+			}
+			else {
+				spdlog::warn("Index tuple doesn't support migration, all data tuples stay in the slow tier");
+			}
+		}
+
+		~TieredDataManagerTemplate() {
+			clear_data_index();
+
+			spdlog::info("Tiered data manager - promoted: {}, demoted: {}, resident: {}/{}",
+			             promote_num_.load(), demote_num_.load(), fast_used_.load(), fast_capacity_);
+		}
+
+		//! @brief Homes of all tuples are in the slow tier, holding up-to-date data.
+		void recovery_iteration(std::function<bool(void *data_ptr)> &callback_func) {
+			slow_allocator_.recovery_iteration(callback_func);
+		}
+
+	public:
+		bool add_data_index_tuple(DataKeyType data_key, const IndexTupleType &src_index_tuple) {
+			return data_index_.insert(data_key, src_index_tuple);
+		}
+
+		bool delete_data_index_tuple(DataKeyType data_key) {
+			return data_index_.remove(data_key);
+		}
+
+		bool read_data_index_tuple(DataKeyType data_key, IndexTupleType &dst_index_tuple) {
+			if (!data_index_.read(data_key, dst_index_tuple)) { return false; }
+			if constexpr (ENABLE_MIGRATION) {
+				record_access(data_key, dst_index_tuple);
+			}
+			return true;
+		}
+
+		bool update_data_index_tuple(DataKeyType data_key, const IndexTupleType &src_index_tuple) {
+			return data_index_.update(data_key, src_index_tuple);
+		}
+
+		/*!
+		 * @brief Whether the tuple is the home of a cached tuple, which should not be accessed any more.
+		 * It should be called with a lock of the tuple held.
+		 */
+		bool is_migrated(const IndexTupleType &index_tuple) const {
+			if constexpr (ENABLE_MIGRATION) {
+				const void *data_ptr = index_tuple.get_data_ptr();
+				if (is_in_fast_tier(data_ptr)) { return false; }
+				// Lock of home orders the filter after promotion and demotion
+				if (get_home_filter_ref(data_ptr).load(std::memory_order::relaxed) == 0) { return false; }
+				return migrated_homes_.count(data_ptr) != 0;
+			}
+			return false;
+		}
+
+		std::pair<DataTupleHeaderType *, void *> allocate_data_and_header() {
+			auto *res = static_cast<DataTupleHeaderType *>(slow_allocator_.allocate(data_size_));
+			return {res, res + 1};
+		}
+
+		bool deallocate_data_and_header(void *data_ptr) {
+			deallocate_block(static_cast<DataTupleHeaderType *>(data_ptr) - 1);
+			return true;
+		}
+
+		//! @brief Tuples are migrated in blocks of the same size, so variable-length tuples take a whole block.
+		std::pair<DataTupleHeaderType *, void *> allocate_data_and_header([[maybe_unused]] size_t size) {
+			DEBUG_ASSERT(size + sizeof(DataTupleHeaderType) <= data_size_);
+			return allocate_data_and_header();
+		}
+
+		bool deallocate_data_and_header(DataTupleHeaderType *header_ptr, [[maybe_unused]] void *data_ptr, [[maybe_unused]] size_t size) {
+			deallocate_block(header_ptr);
+			return true;
+		}
+
+		void *allocate_data() {
+			spdlog::error("This Data Manager DO NOT support (de)allocate data tuple and header separately.");
+			return nullptr;
+		}
+
+		bool deallocate_data(void *data_ptr) {
+			spdlog::error("This Data Manager DO NOT support (de)allocate data tuple and header separately.");
+			return false;
+		}
+
+		DataTupleHeaderType *allocate_header() {
+			spdlog::error("This Data Manager DO NOT support (de)allocate data tuple and header separately.");
+			return nullptr;
+		}
+
+		bool deallocate_header(void *header_ptr) {
+			spdlog::error("This Data Manager DO NOT support (de)allocate data tuple and header separately.");
+			return false;
+		}
+
+		void register_deallocate_data_func(const std::function<void(const IndexTupleType &)> &deallocate_func) {
+			data_deallocate_func = deallocate_func;
+		}
+
+		//! @brief Stop migration and free all tuples left in index by the registered function
+		void clear_data_index() {
+			if (migrator_.joinable()) {
+				migrator_.request_stop();
+				migrator_.join();
+			}
+			retired_blocks_.drain([this](DataTupleHeaderType *block_ptr) { drop_cache_block(block_ptr); });
+			data_index_.clear(data_deallocate_func);
+		}
+
+	private:
+		bool is_in_fast_tier(const void *ptr) const {
+			return ptr >= fast_start_ptr_ && ptr < fast_end_ptr_;
+		}
+
+		//! @brief Get the slot in cache block keeping the header pointer of home.
+		DataTupleHeaderType *&get_home_header_ref(DataTupleHeaderType *block_ptr) const {
+			return *reinterpret_cast<DataTupleHeaderType **>(reinterpret_cast<uint8_t *>(block_ptr) + data_size_);
+		}
+
+		std::atomic<uint32_t> &get_home_filter_ref(const void *home_data_ptr) const {
+			return home_filter_[util::fnvhash(reinterpret_cast<uint64_t>(home_data_ptr)) & home_filter_mask_];
+		}
+
+		//! @brief Free a tuple, together with its home if it is cached.
+		void deallocate_block(DataTupleHeaderType *block_ptr) {
+			if (is_in_fast_tier(block_ptr)) {
+				DataTupleHeaderType *home_header_ptr = get_home_header_ref(block_ptr);
+				migrated_homes_.erase(home_header_ptr + 1);
+				get_home_filter_ref(home_header_ptr + 1).fetch_sub(1, std::memory_order::relaxed);
+				slow_allocator_.deallocate(home_header_ptr, data_size_);
+				drop_cache_block(block_ptr);
+			}
+			else {
+				slow_allocator_.deallocate(block_ptr, data_size_);
+			}
+		}
+
+		void drop_cache_block(DataTupleHeaderType *block_ptr) {
+			fast_allocator_.deallocate(block_ptr, cache_size_);
+			fast_used_.fetch_sub(1, std::memory_order::relaxed);
+		}
+
+	private:
+		/*
+		 * Access tracking
+		 */
+
+		void record_access(DataKeyType data_key, const IndexTupleType &index_tuple) {
+			static thread_local uint32_t sample_counter = 0;
+			if (++sample_counter != SAMPLE_INTERVAL) { return; }
+			sample_counter = 0;
+
+			const uint64_t hash = get_key_hash(data_key);
+			uint32_t count = std::numeric_limits<uint32_t>::max();
+			for (uint32_t i = 0; i < SKETCH_DEPTH; ++i) {
+				auto &counter = sketch_[i * SKETCH_WIDTH + get_slot(hash, i)];
+				count = std::min(count, counter.fetch_add(1, std::memory_order::relaxed) + 1);
+			}
+			// Hot tuples left in slow tier are queued until promoted
+			if (count >= PROMOTE_THRESHOLD && !is_in_fast_tier(index_tuple.get_data_ptr())
+			    && queued_keys_.insert({data_key, true})) {
+				promote_queue_.push(data_key);
+			}
+		}
+
+		uint32_t estimate(DataKeyType data_key) const {
+			const uint64_t hash = get_key_hash(data_key);
+			uint32_t res = std::numeric_limits<uint32_t>::max();
+			for (uint32_t i = 0; i < SKETCH_DEPTH; ++i) {
+				res = std::min(res, sketch_[i * SKETCH_WIDTH + get_slot(hash, i)].load(std::memory_order::relaxed));
+			}
+			return res;
+		}
+
+		void decay_sketch() {
+			for (uint32_t i = 0; i < SKETCH_DEPTH * SKETCH_WIDTH; ++i) {
+				sketch_[i].store(sketch_[i].load(std::memory_order::relaxed) / 2, std::memory_order::relaxed);
+			}
+		}
+
+		static uint64_t get_key_hash(DataKeyType data_key) {
+			return util::fnvhash(static_cast<uint64_t>(data_key));
+		}
+
+		static uint32_t get_slot(uint64_t hash, uint32_t row) {
+			return static_cast<uint32_t>((hash >> (row * 16)) ^ (hash >> 32) * (row + 1)) & (SKETCH_WIDTH - 1);
+		}
+
+	private:
+		/*
+		 * Migration
+		 */
+
+		void migrate_work(std::stop_token stop_token) {
+			auto last_decay_time = Clock::now();
+			thread::EpochGuard epoch_guard;
+
+			while (!stop_token.stop_requested()) {
+				std::this_thread::sleep_for(MIGRATE_INTERVAL);
+				// Tuples freed by concurrent control stay readable while the migrator holds them
+				epoch_guard.enter();
+
+				// Make room for hot tuples
+				const size_t watermark = fast_capacity_ * FAST_TIER_WATERMARK / 100;
+				std::vector<DataTupleHeaderType *> dropped_blocks;
+				for (size_t i = 0, scan_num = resident_keys_.size();
+							i < scan_num && fast_used_.load(std::memory_order::relaxed) - dropped_blocks.size() >= watermark; ++i) {
+					DataKeyType data_key = resident_keys_.front();
+					resident_keys_.pop_front();
+					if (estimate(data_key) >= DEMOTE_THRESHOLD) {
+						resident_keys_.push_back(data_key);
+					}
+					else if (demote(data_key, dropped_blocks) == MigrateResult::Failed) {
+						resident_keys_.push_back(data_key);
+					}
+				}
+
+				DataKeyType data_key;
+				for (uint32_t i = 0; i < MIGRATE_BATCH_NUM && fast_used_.load(std::memory_order::relaxed) < watermark
+				                     && promote_queue_.try_pop(data_key); ++i) {
+					// Keys failing promotion will be queued again by later accesses
+					queued_keys_.erase(data_key);
+					if (promote(data_key) == MigrateResult::Moved) {
+						resident_keys_.push_back(data_key);
+					}
+				}
+
+				epoch_guard.leave();
+				retired_blocks_.retire(dropped_blocks.begin(), dropped_blocks.end());
+				retired_blocks_.reclaim([this](DataTupleHeaderType *block_ptr) { drop_cache_block(block_ptr); });
+
+				const auto cur_time = Clock::now();
+				if (cur_time - last_decay_time >= DECAY_INTERVAL) {
+					decay_sketch();
+					last_decay_time = cur_time;
+				}
+			}
+		}
+
+		enum class MigrateResult {
+			/// Tuple has been moved
+			Moved,
+			/// Tuple is locked by transactions
+			Failed,
+			/// Tuple has been deleted or is already in the target tier
+			Skipped
+		};
+
+		/*!
+		 * @brief Lock the tuple indexed by key, making sure that it is not replaced before locked.
+		 * @param in_fast Whether the tuple is expected in the fast tier
+		 * @param fail_res Reason of failure
+		 * @return Whether the tuple is locked
+		 */
+		bool lock_indexed_tuple(DataKeyType data_key, IndexTupleType &tuple, bool in_fast, MigrateResult &fail_res) {
+			fail_res = MigrateResult::Skipped;
+			if (!data_index_.read(data_key, tuple)) { return false; }
+			if (is_in_fast_tier(tuple.get_data_ptr()) != in_fast) { return false; }
+			if (!tuple.try_lock_write()) {
+				fail_res = MigrateResult::Failed;
+				return false;
+			}
+
+			IndexTupleType cur_tuple;
+			if (!data_index_.read(data_key, cur_tuple) || cur_tuple.get_data_ptr() != tuple.get_data_ptr()) {
+				tuple.unlock_write();
+				return false;
+			}
+			return true;
+		}
+
+		//! @brief Cache a tuple in fast tier, keeping its home in slow tier.
+		MigrateResult promote(DataKeyType data_key) {
+			IndexTupleType home_tuple;
+			MigrateResult fail_res;
+			if (!lock_indexed_tuple(data_key, home_tuple, false, fail_res)) { return fail_res; }
+
+			auto *block_ptr = static_cast<DataTupleHeaderType *>(fast_allocator_.allocate(cache_size_));
+			fast_used_.fetch_add(1, std::memory_order::relaxed);
+			get_home_header_ref(block_ptr) = static_cast<DataTupleHeaderType *>(home_tuple.get_data_ptr()) - 1;
+
+			IndexTupleType cache_tuple = home_tuple.make_cached(block_ptr, block_ptr + 1);
+			data_index_.update(data_key, cache_tuple);
+			get_home_filter_ref(home_tuple.get_data_ptr()).fetch_add(1, std::memory_order::relaxed);
+			migrated_homes_.insert({home_tuple.get_data_ptr(), true});
+			home_tuple.unlock_write();
+
+			promote_num_.fetch_add(1, std::memory_order::relaxed);
+			return MigrateResult::Moved;
+		}
+
+		/*!
+		 * @brief Redirect a cached tuple to its home, which is up to date due to write-through.
+		 * @param dropped_blocks Cache blocks to be retired
+		 */
+		MigrateResult demote(DataKeyType data_key, std::vector<DataTupleHeaderType *> &dropped_blocks) {
+			IndexTupleType cache_tuple;
+			MigrateResult fail_res;
+			if (!lock_indexed_tuple(data_key, cache_tuple, true, fail_res)) { return fail_res; }
+
+			auto *block_ptr = static_cast<DataTupleHeaderType *>(cache_tuple.get_data_ptr()) - 1;
+			IndexTupleType home_tuple = cache_tuple.get_home_tuple(get_home_header_ref(block_ptr));
+			// Stale transactions having read the home before promotion may hold it
+			if (!home_tuple.try_lock_write()) {
+				cache_tuple.unlock_write();
+				return MigrateResult::Failed;
+			}
+
+			// Updates during residence only reached the data of home
+			cache_tuple.write_back_version(home_tuple);
+			NVM::pwb_range(home_tuple.get_data_header_ptr(), sizeof(DataTupleHeaderType));
+			NVM::fence();
+			data_index_.update(data_key, home_tuple);
+			migrated_homes_.erase(home_tuple.get_data_ptr());
+			get_home_filter_ref(home_tuple.get_data_ptr()).fetch_sub(1, std::memory_order::relaxed);
+			cache_tuple.invalidate_migrated();
+			home_tuple.unlock_write();
+			cache_tuple.unlock_write();
+
+			dropped_blocks.push_back(block_ptr);
+			demote_num_.fetch_add(1, std::memory_order::relaxed);
+			return MigrateResult::Moved;
+		}
+	};
+}
+
+namespace datam {
+
+	template<class Key, class TupleHeader, class IndexTuple, IndexType IndexTp>
+	class TieredDataManager : public TieredDataManagerTemplate<
+			Key, TupleHeader,
+			IndexTuple,
+			typename ix::IndexManager<IndexTp, Key, IndexTuple>::Index,
+			allocator::SlabDRAMAllocator,
+			allocator::SlabPmemAllocator
+	>   {
+	public:
+		using BaseType      = TieredDataManagerTemplate<
+				Key, TupleHeader,
+				IndexTuple,
+				typename ix::IndexManager<IndexTp, Key, IndexTuple>::Index,
+				allocator::SlabDRAMAllocator,
+				allocator::SlabPmemAllocator
+		>;
+
+		using DataKeyType         = Key;
+		using DataTupleHeaderType = TupleHeader;
+		using IndexTupleType      = IndexTuple;
+
+		static constexpr StorageOrder DATA_STORAGE_ORDER = StorageOrder::Random;
+
+		static constexpr StorageOrder get_data_storage_order() { return DATA_STORAGE_ORDER; };
+
+		static constexpr StorageMemType DATA_STORAGE_MEM_TYPE = StorageMemType::PMEM;
+
+		static constexpr StorageMemType get_data_storage_memtype() { return DATA_STORAGE_MEM_TYPE; };
+
+		using FastAllocator = allocator::SlabDRAMAllocator;
+		static_assert(allocator::MemAllocatorConcept<FastAllocator>);
+
+		using SlowAllocator = allocator::SlabPmemAllocator;
+		static_assert(allocator::MemAllocatorConcept<SlowAllocator>);
+
+		static constexpr StorageControlHeader get_data_storage_control_header() { return SlowAllocator::get_header(); }
+
+		/*
+		 * Index Configuration
+		 */
+
+		using DataIndexNodeType = ix::IndexManager<IndexTp, DataKeyType, IndexTupleType>::NodeType;
+
+		using DataIndex         = ix::IndexManager<IndexTp, DataKeyType, IndexTupleType>::Index;
+
+		static_assert(ix::IndexConcept<DataIndex>);
+
+		/*
+		 * Align Assumed
+		 */
+		static constexpr size_t VHEADER_ALLOC_ALIGN_SIZE = BaseType::VHEADER_ALLOC_ALIGN_SIZE;
+
+		static constexpr size_t DATA_ALLOC_ALIGN_SIZE    = BaseType::DATA_ALLOC_ALIGN_SIZE;
+
+		TieredDataManager(size_t tuple_size, size_t expected_amount): BaseType(tuple_size, expected_amount) {}
+
+	};
+
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <spdlog/spdlog.h>
+
+#include <tbb/concurrent_hash_map.h>
+
+#include <thread/thread.h>
+#include <index/abstract_index.h>
+
+namespace ix {
+
+	inline namespace array_map {
+
+		template<class Key, class Value>
+		class ArrayMapHeader {
+		public:
+			using KeyType           = Key;
+			using ValueType         = Value;
+			using NodeType          = Value;
+		};
+
+		/*!
+		 * @brief Direct-mapped index for small and dense tables.
+		 * A key is used as the subscript of a slot array sized by the expected amount of tuples,
+		 * which avoids hashing and bucket chasing. Each slot is protected by a sequence lock, so that
+		 * readers of hot tuples never write to the shared cache line.
+		 * Keys out of the range of slots fall back to a concurrent hash map.
+		 */
+		template<class Key, class Value>
+		requires KeyConcept<Key>
+		         && ValueConcept<Value>
+		class ArrayMap {
+		public:
+			using Self              = ArrayMap<Key, Value>;
+
+			using KeyType           = Key;
+			using ValueType         = Value;
+
+			using OverflowMapType   = tbb::concurrent_hash_map<Key, Value>;
+
+			static_assert(std::is_integral_v<Key>, "Direct-mapped index requires integral keys");
+			static_assert(std::is_trivially_copyable_v<Value>, "Sequence lock requires trivially copyable values");
+
+			/// The number of slots per expected tuple, leaving space for sparse keys
+			static constexpr size_t SLOT_AMPLIFICATION = 2;
+
+			static constexpr size_t MIN_SLOT_NUM       = 64;
+
+		private:
+			struct Slot {
+				/// Odd while being modified
+				std::atomic<uint32_t> seq{0};
+				/// Whether the slot holds a value
+				bool occupied{false};
+
+				ValueType value;
+			};
+
+		private:
+			size_t slot_num_;
+
+			std::unique_ptr<Slot[]> slot_array_;
+
+			std::atomic<uint32_t> size_;
+
+			OverflowMapType overflow_map_;
+
+		public:
+			ArrayMap([[maybe_unused]] uint32_t tuple_size, uint32_t expected_amount):
+					slot_num_(std::max<size_t>(static_cast<size_t>(expected_amount) * SLOT_AMPLIFICATION, MIN_SLOT_NUM)),
+					slot_array_(std::make_unique<Slot[]>(slot_num_)),
+					size_(0) {}
+
+		public:
+			template<class ...Args>
+			bool insert(const KeyType &new_key, Args &&...args) {
+				Slot *slot_ptr = get_slot(new_key);
+				if (slot_ptr == nullptr) [[unlikely]] {
+					typename OverflowMapType::accessor accessor;
+					if (!overflow_map_.insert(accessor, new_key)) { return false; }
+					accessor->second = ValueType(std::forward<Args>(args)...);
+					size_.fetch_add(1, std::memory_order::relaxed);
+					return true;
+				}
+
+				lock_slot(*slot_ptr);
+				const bool res = !slot_ptr->occupied;
+				if (res) {
+					slot_ptr->value    = ValueType(std::forward<Args>(args)...);
+					slot_ptr->occupied = true;
+					size_.fetch_add(1, std::memory_order::relaxed);
+				}
+				unlock_slot(*slot_ptr);
+				return res;
+			}
+
+			bool remove(const KeyType &key) {
+				Slot *slot_ptr = get_slot(key);
+				if (slot_ptr == nullptr) [[unlikely]] {
+					if (!overflow_map_.erase(key)) { return false; }
+					size_.fetch_sub(1, std::memory_order::relaxed);
+					return true;
+				}
+
+				lock_slot(*slot_ptr);
+				const bool res = slot_ptr->occupied;
+				if (res) {
+					slot_ptr->occupied = false;
+					size_.fetch_sub(1, std::memory_order::relaxed);
+				}
+				unlock_slot(*slot_ptr);
+				return res;
+			}
+
+			bool read(const KeyType &key, ValueType &data) {
+				Slot *slot_ptr = get_slot(key);
+				if (slot_ptr == nullptr) [[unlikely]] {
+					typename OverflowMapType::const_accessor accessor;
+					if (!overflow_map_.find(accessor, key)) { return false; }
+					data = accessor->second;
+					return true;
+				}
+
+				while (true) {
+					const uint32_t seq = slot_ptr->seq.load(std::memory_order::acquire);
+					if (seq & 1) [[unlikely]] { thread::pause(); continue; }
+
+					const bool occupied = slot_ptr->occupied;
+					alignas(ValueType) uint8_t buffer[sizeof(ValueType)];
+					std::memcpy(buffer, &slot_ptr->value, sizeof(ValueType));
+
+					std::atomic_thread_fence(std::memory_order::acquire);
+					if (slot_ptr->seq.load(std::memory_order::relaxed) != seq) [[unlikely]] { continue; }
+
+					if (occupied) { std::memcpy(&data, buffer, sizeof(ValueType)); }
+					return occupied;
+				}
+			}
+
+			template<class ...Args>
+			bool update(const KeyType &key, Args && ...args) {
+				Slot *slot_ptr = get_slot(key);
+				if (slot_ptr == nullptr) [[unlikely]] {
+					typename OverflowMapType::accessor accessor;
+					if (!overflow_map_.find(accessor, key)) { return false; }
+					accessor->second = ValueType(std::forward<Args>(args)...);
+					return true;
+				}
+
+				lock_slot(*slot_ptr);
+				const bool res = slot_ptr->occupied;
+				if (res) { slot_ptr->value = ValueType(std::forward<Args>(args)...); }
+				unlock_slot(*slot_ptr);
+				return res;
+			}
+
+			bool contain(const KeyType &key) {
+				ValueType value;
+				return read(key, value);
+			}
+
+			void clear(std::function<void(const Value &)> &func) {
+				for (size_t i = 0; i < slot_num_; ++i) {
+					Slot &slot = slot_array_[i];
+					if (slot.occupied) {
+						func(slot.value);
+						slot.occupied = false;
+					}
+				}
+				std::for_each(overflow_map_.begin(), overflow_map_.end(), [&](const auto &item) {
+					func(item.second);
+				});
+				overflow_map_.clear();
+				size_.store(0, std::memory_order::relaxed);
+			}
+
+			uint32_t size() const {
+				return size_.load(std::memory_order::relaxed);
+			}
+
+		private:
+			Slot *get_slot(const KeyType &key) const {
+				const auto index = static_cast<std::make_unsigned_t<KeyType>>(key);
+				if (index >= slot_num_) [[unlikely]] { return nullptr; }
+				return &slot_array_[index];
+			}
+
+			static void lock_slot(Slot &slot) {
+				uint32_t seq = slot.seq.load(std::memory_order::relaxed);
+				while (true) {
+					if (!(seq & 1)
+					    && slot.seq.compare_exchange_weak(seq, seq + 1, std::memory_order::acquire)) {
+						break;
+					}
+					thread::pause();
+					seq = slot.seq.load(std::memory_order::relaxed);
+				}
+			}
+
+			static void unlock_slot(Slot &slot) {
+				slot.seq.fetch_add(1, std::memory_order::release);
+			}
+		};
+
+	}
+
+}
@@ -10,13 +10,16 @@
 #include <index/tbb_hashmap/tbb_hashmap.h>
 #include <index/bptree/bptree.h>
 #include <index/simple_map/simple_map.h>
+#include <index/array_map/array_map.h>
 
 namespace ix {
 
 	enum class IndexType {
 		HashMap,
 		BPTree,
-		SimpleMap
+		SimpleMap,
+		/// Direct-mapped array for small and dense tables
+		Array
 	};
 
 	template<IndexType Type, class KeyType, class ValueType>
@@ -49,4 +52,12 @@ namespace ix {
 		static_assert(IndexConcept<Index>);
 	};
 
+	template<class KeyType, class ValueType>
+	struct IndexManager<IndexType::Array, KeyType, ValueType> {
+		using NodeType = ArrayMapHeader<KeyType, ValueType>::NodeType;
+		using Index    = ArrayMap<KeyType, ValueType>;
+
+		static_assert(IndexConcept<Index>);
+	};
+
 }
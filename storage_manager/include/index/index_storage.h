@@ -24,7 +24,7 @@ namespace ix {
 	template<IndexStorageKind kind = IndexStorageKind::DRAMPool>
 	class IndexStorage {
 	private:
-		allocator::DRAMPoolAllocator allocator_;
+		allocator::SlabDRAMAllocator allocator_;
 
 	public:
 		IndexStorage(uint32_t tuple_size, uint32_t expected_amount):
@@ -66,7 +66,7 @@ namespace ix {
 	template<>
 	class IndexStorage<IndexStorageKind::Hybrid> {
 	private:
-		allocator::DRAMPoolAllocator dram_storage_;
+		allocator::SlabDRAMAllocator dram_storage_;
 		FileDescriptor pmem_descriptor_;
 
 	public:
@@ -84,7 +84,7 @@ namespace ix {
 		}
 
 		void back_up() {
-			FileDescriptor &dram_descriptor = dram_storage_.get_descriptor();
+			StripedFileDescriptor &dram_descriptor = dram_storage_.get_descriptor();
 			void *dram_start_ptr = dram_descriptor.start_ptr;
 			uint64_t dram_size   = dram_descriptor.total_size;
 			void *pmem_start_ptr = pmem_descriptor_.start_ptr;
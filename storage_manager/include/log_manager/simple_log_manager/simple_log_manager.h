@@ -51,5 +51,9 @@ namespace logm {
 		std::span<uint8_t> get_space_range() const {
 			return allocator_.get_space_range();
 		}
+
+		uint32_t get_space_stripe_num() const {
+			return allocator_.get_space_stripe_num();
+		}
 	};
 }
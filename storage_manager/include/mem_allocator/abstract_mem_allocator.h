@@ -9,7 +9,9 @@
 #include <cassert>
 #include <concepts>
 #include <span>
+#include <atomic>
 
+#include <thread/thread.h>
 #include <memory/file_descriptor.h>
 
 namespace allocator {
@@ -40,6 +42,23 @@ namespace allocator {
 
 	static constexpr const char * GLOBAL_DATA_MEM_DIR_PATH[] = ARCH_PMEM_DIR_NAME;
 
+	static constexpr uint32_t GLOBAL_DATA_MEM_DIR_NUM = std::size(GLOBAL_DATA_MEM_DIR_PATH);
+
+	/*!
+	 * @brief Get the stripe local to the calling thread.
+	 * Directories are expected in the order of NUMA nodes (as arch_dect.py lists them). With fewer
+	 * directories than nodes, nodes share them in turn; unregistered threads stripe over all of them.
+	 * @param stripe_num The number of stripes
+	 */
+	inline uint32_t get_local_stripe_index(uint32_t stripe_num) {
+		if (stripe_num <= 1) { return 0; }
+		if (!thread::is_registered()) {
+			static std::atomic<uint32_t> stripe_counter{0};
+			return stripe_counter.fetch_add(1, std::memory_order::relaxed) % stripe_num;
+		}
+		return static_cast<uint32_t>(thread::get_cpu_numa_id()) % stripe_num;
+	}
+
 	//! @brief Concept about memory allocator
 	//! @tparam MemAllocator
 	template<class MemAllocator>
@@ -15,6 +15,8 @@
 #include <mem_allocator/ring_round_allocator/pmem_allocator.h>
 #include <mem_allocator/ring_round_allocator/dram_allocator.h>
 
+#include <mem_allocator/slab_allocator/slab_allocator.h>
+
 namespace allocator {
 
 	enum class MemAllocatorType {
@@ -22,7 +24,9 @@ namespace allocator {
 		DramPoolAllocator,
 		SimplePmemAllocator,
 		RingRoundPMEMAllocator,
-		RingRoundDRAMAllocator
+		RingRoundDRAMAllocator,
+		SlabPmemAllocator,
+		SlabDRAMAllocator
 	};
 
 	template<MemAllocatorType Type>
@@ -65,4 +69,18 @@ namespace allocator {
 		static_assert(MemAllocatorConcept<AllocatorType>);
 	};
 
+	template<>
+	struct MemAllocatorManager<MemAllocatorType::SlabPmemAllocator> {
+		using AllocatorType = SlabPmemAllocator;
+
+		static_assert(MemAllocatorConcept<AllocatorType>);
+	};
+
+	template<>
+	struct MemAllocatorManager<MemAllocatorType::SlabDRAMAllocator> {
+		using AllocatorType = SlabDRAMAllocator;
+
+		static_assert(MemAllocatorConcept<AllocatorType>);
+	};
+
 }
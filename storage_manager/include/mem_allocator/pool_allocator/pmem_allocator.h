@@ -40,7 +40,8 @@ namespace allocator {
 			alloc_size_(align_block_size(tuple_size)),
 			pmem_descriptor_(PMEM_ROOT_DIR_NAME,
 			                 allocate_file_name(),
-							 std::max(alloc_size_ * expected_amount * 2, 128UL * 1024 * 1024)) {
+							 std::max(alloc_size_ * expected_amount * 2, 128UL * 1024 * 1024),
+			                 PMEM_DATA_MAP_OPTION) {
 
 			for (uint8_t *cur_ptr = pmem_descriptor_.start_ptr;
 						cur_ptr < pmem_descriptor_.start_ptr + pmem_descriptor_.total_size; cur_ptr += alloc_size_) {
@@ -49,6 +50,7 @@ namespace allocator {
 
 			spdlog::info("PMEM File Path: {}", pmem_descriptor_.file_path.string());
 			spdlog::info("PMEM Map Size: {}", pmem_descriptor_.total_size);
+			spdlog::info("PMEM Map Time: {} ms (MAP_SYNC: {})", pmem_descriptor_.map_time.count(), pmem_descriptor_.synced);
 			spdlog::info("Aligned Size of Data Block: {}", alloc_size_);
 			spdlog::info("Amount of Data Blocks: {}", blocks_array.unsafe_size());
 			spdlog::info("Address range: 0x{} - 0x{}",
@@ -102,7 +104,7 @@ namespace allocator {
 
 		void recovery_iteration(std::function<bool(void *data_ptr)> &callback_func) {
 			uint32_t iter_num = blocks_array.unsafe_size();
-			const uint32_t thread_num = 24;
+			const uint32_t thread_num = std::max(1U, thread::get_num_cpus());
 			const uint32_t avg_num = iter_num / thread_num;
 
 			auto task_func = [this, &callback_func](uint32_t task_num){
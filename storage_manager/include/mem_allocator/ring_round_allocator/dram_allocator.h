@@ -74,6 +74,11 @@ namespace allocator {
 		std::span<uint8_t> get_space_range() const {
 			return { pmem_descriptor_.start_ptr, pmem_descriptor_.total_size };
 		}
+
+		//! @brief Get the number of equal-sized stripes the space range consists of.
+		uint32_t get_space_stripe_num() const {
+			return 1;
+		}
 		
 	private:
 		static size_t align_size(size_t size) {
@@ -19,22 +19,22 @@ namespace allocator {
 	public:
 		static constexpr size_t ALLOC_ALIGN_SIZE = CACHE_LINE_SIZE;
 
-		inline static const char *PMEM_ROOT_DIR_NAME = GLOBAL_DATA_MEM_DIR_PATH[0];
-
 	private:
-
-		FileDescriptor pmem_descriptor_;
+		/// Log pages striped over all PMEM directories
+		StripedFileDescriptor pmem_descriptor_;
 
 		std::atomic<uint8_t *> cur_bound_;
 
 	public:
 		RindRoundPMEMAllocator(size_t tuple_size, size_t expected_amount):
-			pmem_descriptor_(PMEM_ROOT_DIR_NAME,
+			pmem_descriptor_(GLOBAL_DATA_MEM_DIR_PATH,
 							 allocate_file_name(),
 							 std::max(align_size(tuple_size) * expected_amount * 2, 1024UL * 1024 * 1024)),
 			 cur_bound_(pmem_descriptor_.start_ptr) {
 
-			spdlog::info("PMEM File Path: {}", pmem_descriptor_.file_path.string());
+			for (const auto &file_path: pmem_descriptor_.file_path_array) {
+				spdlog::info("PMEM File Path: {}", file_path.string());
+			}
 			spdlog::info("PMEM Map Size: {}", pmem_descriptor_.total_size);
 			spdlog::info("Address range: 0x{} - 0x{}",
 			             static_cast<void *>(pmem_descriptor_.start_ptr),
@@ -78,6 +78,11 @@ namespace allocator {
 			return { pmem_descriptor_.start_ptr, pmem_descriptor_.total_size };
 		}
 
+		//! @brief Get the number of equal-sized stripes the space range consists of.
+		uint32_t get_space_stripe_num() const {
+			return pmem_descriptor_.stripe_num;
+		}
+
 	private:
 		static size_t align_size(size_t size) {
 			constexpr size_t ALIGNED_SIZE = CACHE_LINE_SIZE;
@@ -0,0 +1,449 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <mutex>
+#include <array>
+#include <memory>
+#include <vector>
+#include <string>
+#include <thread>
+#include <filesystem>
+#include <functional>
+#include <spdlog/spdlog.h>
+
+#include <util/utility_macro.h>
+#include <thread/thread.h>
+#include <memory/memory_config.h>
+#include <mem_allocator/abstract_mem_allocator.h>
+
+namespace allocator {
+
+	/*!
+	 * @brief Pool allocator carving blocks lazily from a mapped file.
+	 * Instead of enqueuing every block at construction, a global frontier is bumped and each thread takes
+	 * a slab of SLAB_BLOCK_NUM blocks at a time. Freed blocks are cached by thread and handed back to
+	 * a global list in batches, so the shared state is only touched once per slab or batch.
+	 * PMEM blocks are striped over all data directories, and threads carve slabs from the stripe on
+	 * their own NUMA node first.
+	 *
+	 * On PMEM, each stripe begins with persistent metadata: a header with the frontier and a bitmap of
+	 * allocated blocks. A bit is set and written back before the block is handed out, so that the bitmap
+	 * is always a superset of live tuples once the tuple itself is persisted with a fence. Recovery
+	 * only probes blocks whose bits are set.
+	 * @tparam Media Storage media of mapped file
+	 */
+	template<MemMedia Media>
+	class SlabAllocatorTemplate {
+	public:
+		static constexpr size_t ALLOC_ALIGN_SIZE = CACHE_LINE_SIZE;
+
+		static constexpr size_t BLOCK_ALIGN_SIZE = CACHE_LINE_SIZE;
+
+		/// The number of blocks carved from frontier at a time
+		static constexpr size_t SLAB_BLOCK_NUM   = 256;
+
+		/// The number of blocks returned to global list at a time
+		static constexpr size_t FREE_BATCH_NUM   = 256;
+
+		/// The number of bitmap words scanned as a task in recovery
+		static constexpr size_t RECOVERY_TASK_WORD_NUM = 1024;
+
+		/// Whether allocation state is kept durable
+		static constexpr bool PERSIST_METADATA   = (Media == MemMedia::PMEM);
+
+		/// Huge pages and MAP_SYNC only pay off for the persistent pool
+		static constexpr MapOption MAP_OPTION    = (Media == MemMedia::PMEM) ? PMEM_DATA_MAP_OPTION : DEFAULT_MAP_OPTION;
+
+		/// Magic number marking valid metadata ("SLABMETA")
+		static constexpr uint64_t METADATA_MAGIC = 0x534C41424D455441UL;
+
+		static constexpr const char *DRAM_DIR_PATH[] = { "/dev/shm" };
+
+	private:
+		//! @brief Blocks owned by a thread.
+		struct alignas(CACHE_LINE_SIZE) ThreadCache {
+			/// Blocks freed by this thread, reused first
+			std::vector<void *> free_list;
+			/// The next unused block in the current slab
+			uint8_t *slab_cur = nullptr;
+			/// The end of the current slab
+			uint8_t *slab_end = nullptr;
+		};
+
+		//! @brief Persistent header at the start of each stripe.
+		struct alignas(CACHE_LINE_SIZE) StripeHeader {
+			uint64_t magic;
+			/// Aligned size of block, which should be the same among runs
+			uint64_t alloc_size;
+			/// The number of blocks in stripe
+			uint64_t block_num;
+			/// The number of blocks ever carved, blocks beyond which are never used
+			uint64_t frontier;
+		};
+
+		//! @brief Volatile state of a stripe
+		struct alignas(CACHE_LINE_SIZE) StripeState {
+			/// Offset of the first block never allocated in the stripe
+			std::atomic<size_t> offset{0};
+
+			StripeHeader *header_ptr = nullptr;
+
+			uint64_t *bitmap_ptr = nullptr;
+
+			uint8_t *block_start = nullptr;
+		};
+
+	private:
+		size_t alloc_size_;
+
+		StripedFileDescriptor pmem_descriptor_;
+
+		/// Size of metadata at the start of each stripe
+		size_t metadata_size_;
+
+		/// The number of blocks in each stripe
+		size_t stripe_block_num_;
+
+		std::unique_ptr<StripeState[]> stripe_array_;
+
+		/// Batches of freed blocks returned by threads
+		std::mutex batch_lock_;
+
+		std::vector<std::vector<void *>> free_batch_list_;
+
+		ThreadCache thread_cache_[thread::get_max_tid()];
+
+		/// Cache shared by threads without tid(e.g. background threads of data manager)
+		std::mutex shared_cache_lock_;
+
+		ThreadCache shared_cache_;
+
+	public:
+		SlabAllocatorTemplate(size_t tuple_size, size_t expected_amount):
+				SlabAllocatorTemplate(allocate_file_name(), tuple_size, expected_amount) {}
+
+		/*!
+		 * @brief Map files of the exact name, which are mapped again by the same name in recovery.
+		 * @param file_name Name of files in each data directory
+		 */
+		SlabAllocatorTemplate(const std::string &file_name, size_t tuple_size, size_t expected_amount):
+				alloc_size_(align_block_size(tuple_size)),
+				pmem_descriptor_(get_dir_array(),
+				                 file_name,
+				                 std::max(alloc_size_ * expected_amount * 2, 128UL * 1024 * 1024),
+				                 MAP_OPTION),
+				stripe_array_(std::make_unique<StripeState[]>(pmem_descriptor_.stripe_num)) {
+
+			init_layout();
+			print_info();
+		}
+
+		SlabAllocatorTemplate(std::string_view dir_name, std::string_view file_name, size_t tuple_size, size_t expected_amount):
+				alloc_size_(align_block_size(tuple_size)),
+				pmem_descriptor_(std::array<const char *, 1>{ dir_name.data() },
+				                 file_name.data() + allocate_file_name(),
+				                 std::max(alloc_size_ * expected_amount * 2, 128UL * 1024 * 1024),
+				                 MAP_OPTION),
+				stripe_array_(std::make_unique<StripeState[]>(pmem_descriptor_.stripe_num)) {
+
+			init_layout();
+			print_info();
+		}
+
+		constexpr static MemAllocatorControlHeader get_header() {
+			return {
+					.allocate_order = MemAllocatorOrder::Random,
+					.mem_type       = Media
+			};
+		}
+
+		StripedFileDescriptor &get_descriptor() {
+			return pmem_descriptor_;
+		}
+
+		//! @brief Whether files of the name have been created by a former run
+		static bool has_file(std::string_view file_name) {
+			return std::filesystem::exists(get_mapped_dir(get_dir_array()[0]) + '/' + std::string(file_name));
+		}
+
+	public:
+		void *allocate([[maybe_unused]] size_t size) {
+			if (!thread::is_registered()) [[unlikely]] {
+				std::lock_guard<std::mutex> guard(shared_cache_lock_);
+				return allocate_from(shared_cache_);
+			}
+			return allocate_from(thread_cache_[thread::get_tid()]);
+		}
+
+		void deallocate(void *ptr, [[maybe_unused]] size_t size) {
+			DEBUG_ASSERT(ptr != nullptr);
+			mark_block(ptr, false);
+			if (!thread::is_registered()) [[unlikely]] {
+				std::lock_guard<std::mutex> guard(shared_cache_lock_);
+				release_to(shared_cache_, ptr);
+				return;
+			}
+			release_to(thread_cache_[thread::get_tid()], ptr);
+		}
+
+		/*!
+		 * @brief Rebuild allocation state from persistent metadata.
+		 * Bitmaps below the persisted frontier are scanned in parallel by one thread per cpu. Only blocks
+		 * marked allocated are passed to callback, and those rejected are freed as well.
+		 * Volatile pools keep no allocation state to recover from, thus recovery is unavailable.
+		 * @param callback_func Function returning whether the block is in use
+		 */
+		void recovery_iteration(std::function<bool(void *data_ptr)> &callback_func) requires PERSIST_METADATA {
+			struct RecoveryTask {
+				uint32_t stripe_idx;
+				size_t   word_begin;
+				size_t   word_end;
+			};
+
+			std::vector<RecoveryTask> task_array;
+			for (uint32_t s = 0; s < pmem_descriptor_.stripe_num; ++s) {
+				StripeState &stripe = stripe_array_[s];
+				const size_t frontier = std::min<size_t>(stripe.header_ptr->frontier, stripe_block_num_);
+				stripe.offset.store(frontier * alloc_size_);
+
+				const size_t word_num = (frontier + 63) / 64;
+				for (size_t w = 0; w < word_num; w += RECOVERY_TASK_WORD_NUM) {
+					task_array.push_back({ s, w, std::min(word_num, w + RECOVERY_TASK_WORD_NUM) });
+				}
+			}
+
+			const uint32_t thread_num = get_recovery_thread_num();
+			std::vector<std::vector<void *>> free_block_array(thread_num);
+			std::atomic<size_t> task_counter{0};
+
+			auto task_func = [&](uint32_t thread_idx) {
+				auto &free_blocks = free_block_array[thread_idx];
+				for (size_t t = task_counter++; t < task_array.size(); t = task_counter++) {
+					const RecoveryTask &task = task_array[t];
+					StripeState &stripe   = stripe_array_[task.stripe_idx];
+					const size_t frontier = std::min<size_t>(stripe.header_ptr->frontier, stripe_block_num_);
+
+					for (size_t w = task.word_begin; w < task.word_end; ++w) {
+						uint64_t &word    = stripe.bitmap_ptr[w];
+						uint64_t new_word = word;
+						for (size_t b = 0; b < 64 && w * 64 + b < frontier; ++b) {
+							uint8_t *block_ptr = stripe.block_start + (w * 64 + b) * alloc_size_;
+							if ((word >> b) & 1) {
+								if (callback_func(block_ptr)) { continue; }
+								new_word &= ~(1UL << b);
+							}
+							free_blocks.push_back(block_ptr);
+						}
+						if (new_word != word) {
+							word = new_word;
+							NVM::pwb(&word);
+						}
+					}
+				}
+			};
+
+			std::vector<std::thread> thread_vec;
+			for (uint32_t i = 1; i < thread_num; ++i) {
+				thread_vec.emplace_back(task_func, i);
+			}
+			task_func(0);
+			for (auto &t: thread_vec) { t.join(); }
+			NVM::fence();
+
+			std::lock_guard<std::mutex> guard(batch_lock_);
+			std::vector<void *> batch;
+			for (auto &free_blocks: free_block_array) {
+				for (void *block_ptr: free_blocks) {
+					batch.push_back(block_ptr);
+					if (batch.size() == FREE_BATCH_NUM) {
+						free_batch_list_.emplace_back(std::move(batch));
+						batch.clear();
+					}
+				}
+			}
+			if (!batch.empty()) { free_batch_list_.emplace_back(std::move(batch)); }
+		}
+
+	private:
+		//! @brief Place metadata and blocks in each stripe, and format metadata not matching current layout.
+		void init_layout() {
+			const size_t stripe_size = pmem_descriptor_.stripe_size;
+			if constexpr (PERSIST_METADATA) {
+				// Each block costs alloc_size_ bytes and one bit
+				stripe_block_num_ = (stripe_size - sizeof(StripeHeader)) * 8 / (8 * alloc_size_ + 1);
+				while (true) {
+					const size_t bitmap_size = (stripe_block_num_ + 63) / 64 * sizeof(uint64_t);
+					metadata_size_ = align_block_size(sizeof(StripeHeader) + bitmap_size);
+					if (metadata_size_ + stripe_block_num_ * alloc_size_ <= stripe_size) { break; }
+					--stripe_block_num_;
+				}
+			}
+			else {
+				metadata_size_    = 0;
+				stripe_block_num_ = stripe_size / alloc_size_;
+			}
+
+			for (uint32_t s = 0; s < pmem_descriptor_.stripe_num; ++s) {
+				StripeState &stripe = stripe_array_[s];
+				uint8_t *stripe_start = pmem_descriptor_.get_stripe(s).data();
+				stripe.block_start = stripe_start + metadata_size_;
+
+				if constexpr (PERSIST_METADATA) {
+					stripe.header_ptr = reinterpret_cast<StripeHeader *>(stripe_start);
+					stripe.bitmap_ptr = reinterpret_cast<uint64_t *>(stripe_start + sizeof(StripeHeader));
+
+					StripeHeader &header = *stripe.header_ptr;
+					if (header.magic != METADATA_MAGIC || header.alloc_size != alloc_size_ || header.block_num != stripe_block_num_) {
+						const size_t bitmap_size = metadata_size_ - sizeof(StripeHeader);
+						std::memset(stripe.bitmap_ptr, 0, bitmap_size);
+						NVM::pwb_range(stripe.bitmap_ptr, bitmap_size);
+						header.alloc_size = alloc_size_;
+						header.block_num  = stripe_block_num_;
+						header.frontier   = 0;
+						NVM::pwb(&header);
+						NVM::fence();
+						// Magic goes last so that a torn format is never regarded as valid
+						header.magic = METADATA_MAGIC;
+						NVM::pwb(&header);
+						NVM::fence();
+					}
+				}
+			}
+		}
+
+		//! @brief Set or clear the bit of block in bitmap, and write it back.
+		void mark_block(void *ptr, bool allocated) {
+			if constexpr (PERSIST_METADATA) {
+				const uint32_t stripe_idx = pmem_descriptor_.get_stripe_index(ptr);
+				StripeState &stripe = stripe_array_[stripe_idx];
+				const size_t block_idx = (static_cast<uint8_t *>(ptr) - stripe.block_start) / alloc_size_;
+
+				uint64_t &word = stripe.bitmap_ptr[block_idx / 64];
+				const uint64_t mask = 1UL << (block_idx % 64);
+				if (allocated) {
+					std::atomic_ref<uint64_t>(word).fetch_or(mask, std::memory_order::relaxed);
+				}
+				else {
+					std::atomic_ref<uint64_t>(word).fetch_and(~mask, std::memory_order::relaxed);
+				}
+				// Ordered by the fence persisting the tuple afterwards
+				NVM::pwb(&word);
+			}
+		}
+
+		//! @brief Take a block from the cache, refilling it from freed batches or frontier.
+		void *allocate_from(ThreadCache &cache) {
+			while (true) {
+				void *res = nullptr;
+				if (!cache.free_list.empty()) {
+					res = cache.free_list.back();
+					cache.free_list.pop_back();
+				}
+				else if (cache.slab_cur < cache.slab_end) {
+					res = cache.slab_cur;
+					cache.slab_cur += alloc_size_;
+				}
+				else if (!fetch_free_batch(cache) && !carve_slab(cache)) [[unlikely]] {
+					spdlog::error("{}:{}: Running out of memory", __FILE__, __LINE__);
+					exit(-1);
+				}
+
+				if (res != nullptr) {
+					mark_block(res, true);
+					return res;
+				}
+			}
+		}
+
+		//! @brief Put a freed block into the cache, handing a batch back to global list once it is full.
+		void release_to(ThreadCache &cache, void *ptr) {
+			cache.free_list.push_back(ptr);
+			// Keep one batch for local reuse and hand the other back
+			if (cache.free_list.size() >= 2 * FREE_BATCH_NUM) {
+				std::vector<void *> batch(cache.free_list.end() - FREE_BATCH_NUM, cache.free_list.end());
+				cache.free_list.resize(cache.free_list.size() - FREE_BATCH_NUM);
+
+				std::lock_guard<std::mutex> guard(batch_lock_);
+				free_batch_list_.emplace_back(std::move(batch));
+			}
+		}
+
+		//! @brief Take a batch of freed blocks from global list.
+		bool fetch_free_batch(ThreadCache &cache) {
+			std::lock_guard<std::mutex> guard(batch_lock_);
+			if (free_batch_list_.empty()) { return false; }
+			cache.free_list.swap(free_batch_list_.back());
+			free_batch_list_.pop_back();
+			return true;
+		}
+
+		//! @brief Carve a new slab from frontier, preferring the local stripe.
+		bool carve_slab(ThreadCache &cache) {
+			const uint32_t stripe_num  = pmem_descriptor_.stripe_num;
+			const uint32_t local_index = get_local_stripe_index(stripe_num);
+			const size_t slab_size     = SLAB_BLOCK_NUM * alloc_size_;
+			const size_t stripe_size   = stripe_block_num_ * alloc_size_;
+
+			for (uint32_t i = 0; i < stripe_num; ++i) {
+				const uint32_t stripe_idx = (local_index + i) % stripe_num;
+				StripeState &stripe = stripe_array_[stripe_idx];
+				if (stripe.offset.load(std::memory_order::relaxed) >= stripe_size) { continue; }
+
+				const size_t offset = stripe.offset.fetch_add(slab_size, std::memory_order::relaxed);
+				if (offset >= stripe_size) [[unlikely]] { continue; }
+
+				const size_t slab_end = std::min(offset + slab_size, stripe_size);
+				persist_frontier(stripe, slab_end / alloc_size_);
+
+				cache.slab_cur = stripe.block_start + offset;
+				cache.slab_end = stripe.block_start + slab_end;
+				return true;
+			}
+			return false;
+		}
+
+		//! @brief Push persistent frontier forward before blocks beyond it are handed out.
+		static void persist_frontier(StripeState &stripe, uint64_t new_frontier) {
+			if constexpr (PERSIST_METADATA) {
+				std::atomic_ref<uint64_t> frontier(stripe.header_ptr->frontier);
+				uint64_t old_frontier = frontier.load(std::memory_order::relaxed);
+				while (old_frontier < new_frontier && !frontier.compare_exchange_weak(old_frontier, new_frontier)) {}
+				NVM::pwb(stripe.header_ptr);
+				NVM::fence();
+			}
+		}
+
+		static uint32_t get_recovery_thread_num() {
+			return std::max(1U, thread::get_num_cpus());
+		}
+
+		static std::span<const char * const> get_dir_array() {
+			if constexpr (Media == MemMedia::PMEM) {
+				return GLOBAL_DATA_MEM_DIR_PATH;
+			}
+			else {
+				return DRAM_DIR_PATH;
+			}
+		}
+
+		void print_info() const {
+			for (const auto &file_path: pmem_descriptor_.file_path_array) {
+				spdlog::info("PMEM File Path: {}", file_path.string());
+			}
+			spdlog::info("PMEM Map Size: {}", pmem_descriptor_.total_size);
+			spdlog::info("PMEM Map Time: {} ms (MAP_SYNC: {})", pmem_descriptor_.map_time.count(), pmem_descriptor_.synced);
+			spdlog::info("Aligned Size of Data Block: {}", alloc_size_);
+			spdlog::info("Amount of Data Blocks: {}", stripe_block_num_ * pmem_descriptor_.stripe_num);
+		}
+
+		static size_t align_block_size(size_t origin_size) {
+			return (origin_size + (BLOCK_ALIGN_SIZE - 1)) & (~(BLOCK_ALIGN_SIZE - 1));
+		}
+	};
+
+	using SlabPmemAllocator = SlabAllocatorTemplate<MemMedia::PMEM>;
+
+	using SlabDRAMAllocator = SlabAllocatorTemplate<MemMedia::DRAM>;
+}
@@ -53,6 +53,9 @@ namespace storage {
 		// Require read interface
 		{ manager.read_data_index_tuple(data_type_ino, data_key, log_tuple) } -> std::same_as<bool>;
 
+		// Require update interface
+		{ manager.update_data_index_tuple(data_type_ino, data_key, log_tuple) } -> std::same_as<bool>;
+
 		/*
 		 * Data interface.
 		 * Dividing data allocation and index is intended to leaf option of flushing to upper level.
@@ -65,6 +68,9 @@ namespace storage {
 
 		{ manager.allocate_header(data_type_ino) } -> std::same_as<decltype(data_tuple_header_ptr)>;
 
+		// Allocate space for data by the actual size of payload
+		{ manager.allocate_data_and_header(data_type_ino, size) } -> std::same_as<std::pair<decltype(data_tuple_header_ptr), decltype(data_ptr)>>;
+
 
 		// Require deallocate interface
 		{ manager.deallocate_data_and_header(data_type_ino, data_ptr) } -> std::same_as<void>;
@@ -73,6 +79,8 @@ namespace storage {
 
 		{ manager.deallocate_header(data_type_ino, data_tuple_header_ptr) } -> std::same_as<void>;
 
+		{ manager.deallocate_data_and_header(data_type_ino, data_tuple_header_ptr, data_ptr, size) } -> std::same_as<void>;
+
 		/*
 		 * Log interface
 		 */
@@ -9,6 +9,7 @@
 #include <log_manager/log_manager.h>
 #include <version_manager/version_manager.h>
 
+#include <storage_manager/table_layout.h>
 #include <storage_manager/simple_storage_manager/simple_storage_manager.h>
 
 namespace storage {
@@ -17,7 +18,8 @@ namespace storage {
 			typename TupleHeader,
 			typename IndexTuple,
 			IndexType DataIndexTp,
-			typename VersionHeader>
+			typename VersionHeader,
+			typename TableLayouts>
 	requires DataKeyTypeConcept<DataKey>
 	class PDPLSimpleManager:
 			public SimpleMVStorageManagerTemplate<
@@ -27,7 +29,7 @@ namespace storage {
 			> {
 
 	public:
-		using Self             = PDPLSimpleManager<DataKey, TupleHeader, IndexTuple, DataIndexTp, VersionHeader>;
+		using Self             = PDPLSimpleManager<DataKey, TupleHeader, IndexTuple, DataIndexTp, VersionHeader, TableLayouts>;
 		using DataManager      = datam::DataManagerManager<datam::DataManagerKind::PMEM, DataKey, TupleHeader, IndexTuple, DataIndexTp>::DataManager;
 		using LogManager       = logm::LogManagerManager<logm::LogManagerKind::PMEM_TL>::LogManager;
 		using VersionManager   = versionm::VersionManagerManager<versionm::VersionManagerKind::PMEM, VersionHeader>::VersionManager;
@@ -51,33 +53,34 @@ namespace storage {
 	template<typename DataKey,
 			typename TupleHeader,
 			typename IndexTuple,
-			IndexType DataIndexTp>
+			IndexType DataIndexTp,
+			typename TableLayouts>
 	requires DataKeyTypeConcept<DataKey>
-	class PDPLSimpleManager<DataKey, TupleHeader, IndexTuple, DataIndexTp, void>:
+	class PDPLSimpleManager<DataKey, TupleHeader, IndexTuple, DataIndexTp, void, TableLayouts>:
 			public SimpleStorageManagerTemplate<
-					typename datam::DataManagerManager<datam::DataManagerKind::PMEM, DataKey, TupleHeader, IndexTuple, DataIndexTp>::DataManager,
+					typename TableDataManagerTuple<datam::DataManagerKind::PMEM, DataKey, TupleHeader, IndexTuple, TableLayouts>::Type,
 					typename logm::LogManagerManager<logm::LogManagerKind::PMEM_TL>::LogManager
 			> {
 
 
 	public:
-		using Self             = PDPLSimpleManager<DataKey, TupleHeader, IndexTuple, DataIndexTp, void>;
-		using DataManager      = datam::DataManagerManager<datam::DataManagerKind::PMEM, DataKey, TupleHeader, IndexTuple, DataIndexTp>::DataManager;
+		using Self             = PDPLSimpleManager<DataKey, TupleHeader, IndexTuple, DataIndexTp, void, TableLayouts>;
+		using DataManagerTuple = TableDataManagerTuple<datam::DataManagerKind::PMEM, DataKey, TupleHeader, IndexTuple, TableLayouts>::Type;
 		using LogManager       = logm::LogManagerManager<logm::LogManagerKind::PMEM_TL>::LogManager;
-		using BaseManager      = SimpleStorageManagerTemplate<DataManager, LogManager>;
+		using BaseManager      = SimpleStorageManagerTemplate<DataManagerTuple, LogManager>;
 
 		/*
 		 * Data manager parameters
 		 */
-		using DataKeyType      = DataManager::DataKeyType;
-		using DataTupleHeaderType = DataManager::DataTupleHeaderType;
-		using IndexTupleType   = DataManager::IndexTupleType;
+		using DataKeyType      = BaseManager::DataKeyType;
+		using DataTupleHeaderType = BaseManager::DataTupleHeaderType;
+		using IndexTupleType   = BaseManager::IndexTupleType;
 
 		/*
 		 * Align Assumed
 		 */
-		static constexpr size_t DATA_ALLOC_ALIGN_SIZE    = DataManager::DATA_ALLOC_ALIGN_SIZE;
-		static constexpr size_t VHEADER_ALLOC_ALIGN_SIZE = DataManager::VHEADER_ALLOC_ALIGN_SIZE;
+		static constexpr size_t DATA_ALLOC_ALIGN_SIZE    = BaseManager::DATA_ALLOC_ALIGN_SIZE;
+		static constexpr size_t VHEADER_ALLOC_ALIGN_SIZE = BaseManager::VHEADER_ALLOC_ALIGN_SIZE;
 		static constexpr size_t LOG_ALLOC_ALIGN_SIZE     = LogManager::LOG_ALLOC_ALIGN_SIZE;
 	};
 
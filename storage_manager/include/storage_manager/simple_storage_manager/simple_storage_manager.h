@@ -5,6 +5,13 @@
 
 #pragma once
 
+#include <tuple>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <algorithm>
+
+#include <util/utility_macro.h>
 #include <data_manager/abstract_data_manager.h>
 #include <log_manager/abstract_log_manager.h>
 #include <version_manager/abstract_version_manager.h>
@@ -87,6 +94,19 @@ namespace storage {
 			return data_manager_array_[data_type_ino]->read_data_index_tuple(data_key, index_tuple);
 		}
 
+		bool update_data_index_tuple(uint32_t data_type_ino, DataKeyType data_key, const IndexTupleType &index_tuple) {
+			return data_manager_array_[data_type_ino]->update_data_index_tuple(data_key, index_tuple);
+		}
+
+		//! @brief Whether the tuple has been cached elsewhere by data managers moving tuples, which readers of it should abort.
+		bool is_data_tuple_migrated(uint32_t data_type_ino, const IndexTupleType &index_tuple) {
+			auto &data_manager = *data_manager_array_[data_type_ino];
+			if constexpr (requires { data_manager.is_migrated(index_tuple); }) {
+				return data_manager.is_migrated(index_tuple);
+			}
+			return false;
+		}
+
 		/*
 		 * Data interface
 		 */
@@ -95,6 +115,10 @@ namespace storage {
 			return data_manager_array_[data_type_ino]->allocate_data_and_header();
 		}
 
+		std::pair<DataTupleHeaderType *, void *> allocate_data_and_header(uint32_t data_type_ino, size_t size) {
+			return data_manager_array_[data_type_ino]->allocate_data_and_header(size);
+		}
+
 		void *allocate_data(uint32_t data_type_ino) {
 			return data_manager_array_[data_type_ino]->allocate_data();
 		}
@@ -107,6 +131,10 @@ namespace storage {
 			data_manager_array_[data_type_ino]->deallocate_data_and_header(header_ptr, data_ptr);
 		}
 
+		void deallocate_data_and_header(uint32_t data_type_ino, DataTupleHeaderType *header_ptr, void *data_ptr, size_t size) {
+			data_manager_array_[data_type_ino]->deallocate_data_and_header(header_ptr, data_ptr, size);
+		}
+
 		void deallocate_data(uint32_t data_type_ino, void *data_ptr) {
 			data_manager_array_[data_type_ino]->deallocate_data(data_ptr);
 		}
@@ -136,6 +164,11 @@ namespace storage {
 			return log_manager_.get_space_range();
 		}
 
+		//! @brief Get the number of stripes(one per PMEM directory) log space is divided into.
+		uint32_t get_log_space_stripe_num() const {
+			return log_manager_.get_space_stripe_num();
+		}
+
 		/*
 		 * Version interface
 		 */
@@ -162,26 +195,44 @@ namespace storage {
 		}
 	};
 
-	template<class DataManager, class LogManager>
-	requires datam::DataManagerConcept<DataManager>
+	/*!
+	 * @brief Storage manager with a data manager for each table.
+	 * Data managers are held in place by optionals in a tuple, constructed when their tables are added,
+	 * whose types may differ from table to table (index, media). Accesses are dispatched on the data
+	 * type inode by a compile-time generated comparison chain instead of an array of pointers.
+	 * @tparam DataManagerTuple std::tuple of data managers, ordered as the data type inode
+	 */
+	template<class DataManagerTuple, class LogManager>
+	class SimpleStorageManagerTemplate;
+
+	template<class ...DataManagers, class LogManager>
+	requires (datam::DataManagerConcept<DataManagers> && ...)
 	         && logm::LogManagerConcept<LogManager>
-	class SimpleStorageManagerTemplate {
+	class SimpleStorageManagerTemplate<std::tuple<DataManagers...>, LogManager> {
 
 	public:
-		using Self          = SimpleStorageManagerTemplate<DataManager, LogManager>;
+		using Self          = SimpleStorageManagerTemplate<std::tuple<DataManagers...>, LogManager>;
+
+		using FirstDataManager = std::tuple_element_t<0, std::tuple<DataManagers...>>;
+
+		static constexpr size_t TABLE_NUM = sizeof...(DataManagers);
 
 		/*
 		 * Data manager parameters
 		 */
-		using DataKeyType         = DataManager::DataKeyType;
-		using DataTupleHeaderType = DataManager::DataTupleHeaderType;
-		using IndexTupleType      = DataManager::IndexTupleType;
+		using DataKeyType         = FirstDataManager::DataKeyType;
+		using DataTupleHeaderType = FirstDataManager::DataTupleHeaderType;
+		using IndexTupleType      = FirstDataManager::IndexTupleType;
+
+		static_assert((std::is_same_v<DataKeyType, typename DataManagers::DataKeyType> && ...));
+		static_assert((std::is_same_v<DataTupleHeaderType, typename DataManagers::DataTupleHeaderType> && ...));
+		static_assert((std::is_same_v<IndexTupleType, typename DataManagers::IndexTupleType> && ...));
 
 		/*
-		 * Align Assumed
+		 * Align Assumed, which should hold for all tables
 		 */
-		static constexpr size_t DATA_ALLOC_ALIGN_SIZE    = DataManager::DATA_ALLOC_ALIGN_SIZE;
-		static constexpr size_t VHEADER_ALLOC_ALIGN_SIZE = DataManager::VHEADER_ALLOC_ALIGN_SIZE;
+		static constexpr size_t DATA_ALLOC_ALIGN_SIZE    = std::min({DataManagers::DATA_ALLOC_ALIGN_SIZE...});
+		static constexpr size_t VHEADER_ALLOC_ALIGN_SIZE = std::min({DataManagers::VHEADER_ALLOC_ALIGN_SIZE...});
 		static constexpr size_t LOG_ALLOC_ALIGN_SIZE     = LogManager::LOG_ALLOC_ALIGN_SIZE;
 
 	private:
@@ -189,22 +240,32 @@ namespace storage {
 
 		std::vector<size_t> table_size_array_;
 
-		std::vector<DataManager *> data_manager_array_;
+		/// Constructed when the table is added
+		std::tuple<std::optional<DataManagers>...> data_manager_tuple_;
 
 	public:
 		SimpleStorageManagerTemplate() = default;
 
 		~SimpleStorageManagerTemplate() {
-			for (DataManager *data_manager_ptr: data_manager_array_) {
-				delete data_manager_ptr;
-			}
+			// Data managers free tuples left in index through concurrent control, which visits the table again.
+			// Thus all tables are cleared while every one of them is still reachable.
+			std::apply([](auto &...data_manager) {
+				((data_manager.has_value() ? data_manager->clear_data_index() : void()), ...);
+			}, data_manager_tuple_);
+			destroy_tables();
 		}
 
 	public:
 		void add_table(size_t tuple_size, size_t expected_amount) {
-			DataManager *data_manager_ptr = new DataManager{tuple_size, expected_amount};
+			const size_t data_type_ino = table_size_array_.size();
+			if (data_type_ino >= TABLE_NUM) [[unlikely]] {
+				spdlog::error("Table {} is out of the layout of storage manager, which has {} tables", data_type_ino, TABLE_NUM);
+				return;
+			}
 			table_size_array_.emplace_back(tuple_size);
-			data_manager_array_.emplace_back(data_manager_ptr);
+			visit_table_slot(data_type_ino, [tuple_size, expected_amount](auto &data_manager) {
+				data_manager.emplace(tuple_size, expected_amount);
+			});
 		}
 
 		auto get_table_size_info() const { return table_size_array_; }
@@ -214,15 +275,37 @@ namespace storage {
 		 */
 
 		bool add_data_index_tuple(uint32_t data_type_ino, DataKeyType data_key, const IndexTupleType &index_tuple) {
-			return data_manager_array_[data_type_ino]->add_data_index_tuple(data_key, index_tuple);
+			return visit_table(data_type_ino, [&](auto &data_manager) {
+				return data_manager.add_data_index_tuple(data_key, index_tuple);
+			});
 		}
 
 		bool delete_data_index_tuple(uint32_t data_type_ino, DataKeyType data_key) {
-			return data_manager_array_[data_type_ino]->delete_data_index_tuple(data_key);
+			return visit_table(data_type_ino, [&](auto &data_manager) {
+				return data_manager.delete_data_index_tuple(data_key);
+			});
 		}
 
 		bool read_data_index_tuple(uint32_t data_type_ino, DataKeyType data_key, IndexTupleType &index_tuple) {
-			return data_manager_array_[data_type_ino]->read_data_index_tuple(data_key, index_tuple);
+			return visit_table(data_type_ino, [&](auto &data_manager) {
+				return data_manager.read_data_index_tuple(data_key, index_tuple);
+			});
+		}
+
+		bool update_data_index_tuple(uint32_t data_type_ino, DataKeyType data_key, const IndexTupleType &index_tuple) {
+			return visit_table(data_type_ino, [&](auto &data_manager) {
+				return data_manager.update_data_index_tuple(data_key, index_tuple);
+			});
+		}
+
+		//! @brief Whether the tuple has been cached elsewhere by data managers moving tuples, which readers of it should abort.
+		bool is_data_tuple_migrated(uint32_t data_type_ino, const IndexTupleType &index_tuple) {
+			return visit_table(data_type_ino, [&](auto &data_manager) {
+				if constexpr (requires { data_manager.is_migrated(index_tuple); }) {
+					return data_manager.is_migrated(index_tuple);
+				}
+				return false;
+			});
 		}
 
 		/*
@@ -230,7 +313,20 @@ namespace storage {
 		 */
 
 		std::pair<DataTupleHeaderType *, void *> allocate_data_and_header(uint32_t data_type_ino) {
-			auto [header_ptr, data_ptr] = data_manager_array_[data_type_ino]->allocate_data_and_header();
+			auto [header_ptr, data_ptr] = visit_table(data_type_ino, [](auto &data_manager) {
+				return data_manager.allocate_data_and_header();
+			});
+			return {
+				std::assume_aligned<VHEADER_ALLOC_ALIGN_SIZE>(header_ptr),
+				std::assume_aligned<DATA_ALLOC_ALIGN_SIZE>(data_ptr)
+			};
+		}
+
+		//! @brief Allocate a variable-length tuple by the actual size of payload.
+		std::pair<DataTupleHeaderType *, void *> allocate_data_and_header(uint32_t data_type_ino, size_t size) {
+			auto [header_ptr, data_ptr] = visit_table(data_type_ino, [size](auto &data_manager) {
+				return data_manager.allocate_data_and_header(size);
+			});
 			return {
 				std::assume_aligned<VHEADER_ALLOC_ALIGN_SIZE>(header_ptr),
 				std::assume_aligned<DATA_ALLOC_ALIGN_SIZE>(data_ptr)
@@ -238,34 +334,52 @@ namespace storage {
 		}
 
 		void *allocate_data(uint32_t data_type_ino) {
-			return std::assume_aligned<DATA_ALLOC_ALIGN_SIZE>(data_manager_array_[data_type_ino]->allocate_data());
+			return std::assume_aligned<DATA_ALLOC_ALIGN_SIZE>(visit_table(data_type_ino, [](auto &data_manager) {
+				return data_manager.allocate_data();
+			}));
 		}
 
 		DataTupleHeaderType *allocate_header(uint32_t data_type_ino) {
-			return std::assume_aligned<VHEADER_ALLOC_ALIGN_SIZE>(data_manager_array_[data_type_ino]->allocate_header());
+			return std::assume_aligned<VHEADER_ALLOC_ALIGN_SIZE>(visit_table(data_type_ino, [](auto &data_manager) {
+				return data_manager.allocate_header();
+			}));
 		}
 
 		void deallocate_data_and_header(uint32_t data_type_ino, void *data_ptr) {
-			data_manager_array_[data_type_ino]->deallocate_data_and_header(data_ptr);
+			visit_table(data_type_ino, [data_ptr](auto &data_manager) {
+				data_manager.deallocate_data_and_header(data_ptr);
+			});
+		}
+
+		void deallocate_data_and_header(uint32_t data_type_ino, DataTupleHeaderType *header_ptr, void *data_ptr, size_t size) {
+			visit_table(data_type_ino, [header_ptr, data_ptr, size](auto &data_manager) {
+				data_manager.deallocate_data_and_header(header_ptr, data_ptr, size);
+			});
 		}
 
 		void deallocate_data(uint32_t data_type_ino, void *data_ptr) {
-			data_manager_array_[data_type_ino]->deallocate_data(data_ptr);
+			visit_table(data_type_ino, [data_ptr](auto &data_manager) {
+				data_manager.deallocate_data(data_ptr);
+			});
 		}
 
 		void deallocate_header(uint32_t data_type_ino,DataTupleHeaderType *header_ptr) {
-			data_manager_array_[data_type_ino]->deallocate_header(header_ptr);
+			visit_table(data_type_ino, [header_ptr](auto &data_manager) {
+				data_manager.deallocate_header(header_ptr);
+			});
 		}
 
 		template<class Func>
 		void register_data_deallocate_func(Func &&func, uint32_t data_type = std::numeric_limits<uint32_t>::max()) {
 			if (data_type == std::numeric_limits<uint32_t>::max()) {
-				for (DataManager *data_manager_ptr: data_manager_array_) {
-					data_manager_ptr->register_deallocate_data_func(std::forward<Func>(func));
-				}
+				std::apply([&func](auto &...data_manager) {
+					((data_manager.has_value() ? data_manager->register_deallocate_data_func(func) : void()), ...);
+				}, data_manager_tuple_);
 			}
 			else {
-				data_manager_array_[data_type]->register_deallocate_data_func(std::forward<Func>(func));
+				visit_table(data_type, [&func](auto &data_manager) {
+					data_manager.register_deallocate_data_func(std::forward<Func>(func));
+				});
 			}
 		}
 
@@ -277,11 +391,18 @@ namespace storage {
 			return log_manager_.get_space_range();
 		}
 
+		//! @brief Get the number of stripes(one per PMEM directory) log space is divided into.
+		uint32_t get_log_space_stripe_num() const {
+			return log_manager_.get_space_stripe_num();
+		}
+
 		/*
 		 * Recovery
 		 */
 		void recovery_iteration(uint32_t data_type, std::function<bool(void *data_ptr)> &callback_func) {
-			data_manager_array_[data_type]->recovery_iteration(callback_func);
+			visit_table(data_type, [&callback_func](auto &data_manager) {
+				data_manager.recovery_iteration(callback_func);
+			});
 		}
 
 		/*
@@ -296,5 +417,51 @@ namespace storage {
 		void fence() {
 			NVM::fence();
 		}
+
+	private:
+		/*!
+		 * @brief Apply the function on the data manager of table.
+		 * A table out of layout or not added yet is reported, returning the default value(e.g. false or nullptr).
+		 */
+		template<class Func>
+		decltype(auto) visit_table(uint32_t data_type_ino, Func &&func) {
+			return visit_table_slot(data_type_ino, [&func, data_type_ino](auto &data_manager) -> decltype(auto) {
+				using ResultType = decltype(func(*data_manager));
+				if (!data_manager.has_value()) [[unlikely]] {
+					spdlog::error("Table {} has not been added into storage manager", data_type_ino);
+					return ResultType();
+				}
+				return func(*data_manager);
+			});
+		}
+
+		/*!
+		 * @brief Destroy data managers in the reverse order of adding tables, as members are destroyed
+		 * in the reverse order of construction. A table is unreachable once its destruction starts.
+		 */
+		template<size_t I = TABLE_NUM>
+		void destroy_tables() {
+			if constexpr (I != 0) {
+				std::get<I - 1>(data_manager_tuple_).reset();
+				destroy_tables<I - 1>();
+			}
+		}
+
+		//! @brief Apply the function on the slot holding data manager of table.
+		template<size_t I = 0, class Func>
+		decltype(auto) visit_table_slot(uint32_t data_type_ino, Func &&func) {
+			if constexpr (I + 1 == TABLE_NUM) {
+				using ResultType = decltype(func(std::get<I>(data_manager_tuple_)));
+				if (data_type_ino != I) [[unlikely]] {
+					spdlog::error("Table {} is out of the layout of storage manager, which has {} tables", data_type_ino, TABLE_NUM);
+					return ResultType();
+				}
+				return func(std::get<I>(data_manager_tuple_));
+			}
+			else {
+				if (data_type_ino == I) { return func(std::get<I>(data_manager_tuple_)); }
+				return visit_table_slot<I + 1>(data_type_ino, std::forward<Func>(func));
+			}
+		}
 	};
 }
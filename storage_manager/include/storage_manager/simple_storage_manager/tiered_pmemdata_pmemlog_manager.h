@@ -0,0 +1,86 @@
+#pragma once
+
+#include <data_manager/data_manager.h>
+#include <log_manager/log_manager.h>
+#include <version_manager/version_manager.h>
+
+#include <storage_manager/table_layout.h>
+#include <storage_manager/simple_storage_manager/simple_storage_manager.h>
+
+namespace storage {
+
+	/*!
+	 * @brief Storage manager caching hot data tuples in DRAM for reads over their PMEM homes, with logs in PMEM.
+	 * Multi-version data keeps the placement of PDPLSimpleManager, as version chains hold raw pointers to tuples.
+	 */
+	template<typename DataKey,
+			typename TupleHeader,
+			typename IndexTuple,
+			IndexType DataIndexTp,
+			typename VersionHeader,
+			typename TableLayouts>
+	requires DataKeyTypeConcept<DataKey>
+	class TieredPDPLManager:
+			public SimpleMVStorageManagerTemplate<
+					typename datam::DataManagerManager<datam::DataManagerKind::PMEM, DataKey, TupleHeader, IndexTuple, DataIndexTp>::DataManager,
+					typename logm::LogManagerManager<logm::LogManagerKind::PMEM_TL>::LogManager,
+					typename versionm::VersionManagerManager<versionm::VersionManagerKind::PMEM, VersionHeader>::VersionManager
+			> {
+
+	public:
+		using Self             = TieredPDPLManager<DataKey, TupleHeader, IndexTuple, DataIndexTp, VersionHeader, TableLayouts>;
+		using DataManager      = datam::DataManagerManager<datam::DataManagerKind::PMEM, DataKey, TupleHeader, IndexTuple, DataIndexTp>::DataManager;
+		using LogManager       = logm::LogManagerManager<logm::LogManagerKind::PMEM_TL>::LogManager;
+		using VersionManager   = versionm::VersionManagerManager<versionm::VersionManagerKind::PMEM, VersionHeader>::VersionManager;
+		using BaseManager      = SimpleMVStorageManagerTemplate<DataManager, LogManager, VersionManager>;
+
+		/*
+		 * Data manager parameters
+		 */
+		using DataKeyType      = DataManager::DataKeyType;
+		using DataTupleHeaderType = DataManager::DataTupleHeaderType;
+		using IndexTupleType   = DataManager::IndexTupleType;
+
+		/*
+		 * Align Assumed
+		 */
+		static constexpr size_t DATA_ALLOC_ALIGN_SIZE    = DataManager::DATA_ALLOC_ALIGN_SIZE;
+		static constexpr size_t VHEADER_ALLOC_ALIGN_SIZE = DataManager::VHEADER_ALLOC_ALIGN_SIZE;
+		static constexpr size_t LOG_ALLOC_ALIGN_SIZE     = LogManager::LOG_ALLOC_ALIGN_SIZE;
+	};
+
+	template<typename DataKey,
+			typename TupleHeader,
+			typename IndexTuple,
+			IndexType DataIndexTp,
+			typename TableLayouts>
+	requires DataKeyTypeConcept<DataKey>
+	class TieredPDPLManager<DataKey, TupleHeader, IndexTuple, DataIndexTp, void, TableLayouts>:
+			public SimpleStorageManagerTemplate<
+					typename TableDataManagerTuple<datam::DataManagerKind::TIERED, DataKey, TupleHeader, IndexTuple, TableLayouts>::Type,
+					typename logm::LogManagerManager<logm::LogManagerKind::PMEM_TL>::LogManager
+			> {
+
+
+	public:
+		using Self             = TieredPDPLManager<DataKey, TupleHeader, IndexTuple, DataIndexTp, void, TableLayouts>;
+		using DataManagerTuple = TableDataManagerTuple<datam::DataManagerKind::TIERED, DataKey, TupleHeader, IndexTuple, TableLayouts>::Type;
+		using LogManager       = logm::LogManagerManager<logm::LogManagerKind::PMEM_TL>::LogManager;
+		using BaseManager      = SimpleStorageManagerTemplate<DataManagerTuple, LogManager>;
+
+		/*
+		 * Data manager parameters
+		 */
+		using DataKeyType      = BaseManager::DataKeyType;
+		using DataTupleHeaderType = BaseManager::DataTupleHeaderType;
+		using IndexTupleType   = BaseManager::IndexTupleType;
+
+		/*
+		 * Align Assumed
+		 */
+		static constexpr size_t DATA_ALLOC_ALIGN_SIZE    = BaseManager::DATA_ALLOC_ALIGN_SIZE;
+		static constexpr size_t VHEADER_ALLOC_ALIGN_SIZE = BaseManager::VHEADER_ALLOC_ALIGN_SIZE;
+		static constexpr size_t LOG_ALLOC_ALIGN_SIZE     = LogManager::LOG_ALLOC_ALIGN_SIZE;
+	};
+
+}
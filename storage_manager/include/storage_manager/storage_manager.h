@@ -8,11 +8,13 @@
 #include <index/abstract_index.h>
 
 #include <storage_manager/abstract_storage_manager.h>
+#include <storage_manager/table_layout.h>
 
 #include <storage_manager/simple_storage_manager/random_dram_manager.h>
 #include <storage_manager/simple_storage_manager/random_pmemdata_dramlog_manager.h>
 #include <storage_manager/simple_storage_manager/simple_pmemdata_dramlog_manager.h>
 #include <storage_manager/simple_storage_manager/simple_pmemdata_pmemlog_manager.h>
+#include <storage_manager/simple_storage_manager/tiered_pmemdata_pmemlog_manager.h>
 
 namespace storage {
 
@@ -20,15 +22,17 @@ namespace storage {
 		Random_DRAM,
 		Random_PMEMDATA_DRAMLOG,
 		Simple_PMEMDATA_DRAMLOG,
-		Simple_PMEMDATA_PMEMLOG
+		Simple_PMEMDATA_PMEMLOG,
+		Tiered_PMEMDATA_PMEMLOG
 	};
 
 	template<StorageManagerType SMT,
 			typename DataKey, typename DataTupleHeader,
 			typename IndexTuple, IndexType DataIndexTp,
-			typename VersionType>
+			typename VersionType,
+			typename TableLayouts>
 	struct StorageManagerManager {
-		using StorageManager = DRAMRandomManager<DataKey, DataTupleHeader, IndexTuple, DataIndexTp, VersionType>;
+		using StorageManager = DRAMRandomManager<DataKey, DataTupleHeader, IndexTuple, DataIndexTp, VersionType, TableLayouts>;
 
 		static_assert(StorageManagerConcept<StorageManager>);
 	};
@@ -36,44 +40,60 @@ namespace storage {
 	template<
 			typename DataKey, typename DataTupleHeader,
 			typename IndexTuple, IndexType DataIndexTp,
-			typename VersionType>
+			typename VersionType,
+			typename TableLayouts>
 	struct StorageManagerManager<StorageManagerType::Random_DRAM,
 			DataKey, DataTupleHeader, IndexTuple, DataIndexTp,
-			VersionType> {
-		using StorageManager = DRAMRandomManager<DataKey, DataTupleHeader, IndexTuple, DataIndexTp, VersionType>;
+			VersionType, TableLayouts> {
+		using StorageManager = DRAMRandomManager<DataKey, DataTupleHeader, IndexTuple, DataIndexTp, VersionType, TableLayouts>;
 
 		static_assert(StorageManagerConcept<StorageManager>);
 	};
 
 	template<
 			typename DataKey, typename IndexTuple, typename DataTupleHeader, IndexType DataIndexTp,
-			typename VersionType>
+			typename VersionType,
+			typename TableLayouts>
 	struct StorageManagerManager<StorageManagerType::Random_PMEMDATA_DRAMLOG,
 			DataKey, DataTupleHeader, IndexTuple, DataIndexTp,
-			VersionType> {
-		using StorageManager = PDDLRandomManager<DataKey, DataTupleHeader, IndexTuple, DataIndexTp, VersionType>;
+			VersionType, TableLayouts> {
+		using StorageManager = PDDLRandomManager<DataKey, DataTupleHeader, IndexTuple, DataIndexTp, VersionType, TableLayouts>;
 
 		static_assert(StorageManagerConcept<StorageManager>);
 	};
 
 	template<
 			typename DataKey, typename IndexTuple, typename DataTupleHeader, IndexType DataIndexTp,
-			typename VersionType>
+			typename VersionType,
+			typename TableLayouts>
 	struct StorageManagerManager<StorageManagerType::Simple_PMEMDATA_DRAMLOG,
 			DataKey, DataTupleHeader, IndexTuple, DataIndexTp,
-			VersionType> {
-		using StorageManager = PDDLSimpleManager<DataKey, DataTupleHeader, IndexTuple, DataIndexTp, VersionType>;
+			VersionType, TableLayouts> {
+		using StorageManager = PDDLSimpleManager<DataKey, DataTupleHeader, IndexTuple, DataIndexTp, VersionType, TableLayouts>;
 
 		static_assert(StorageManagerConcept<StorageManager>);
 	};
 
 	template<
 			typename DataKey, typename IndexTuple, typename DataTupleHeader, IndexType DataIndexTp,
-			typename VersionType>
+			typename VersionType,
+			typename TableLayouts>
 	struct StorageManagerManager<StorageManagerType::Simple_PMEMDATA_PMEMLOG,
 			DataKey, DataTupleHeader, IndexTuple, DataIndexTp,
-			VersionType> {
-		using StorageManager = PDPLSimpleManager<DataKey, DataTupleHeader, IndexTuple, DataIndexTp, VersionType>;
+			VersionType, TableLayouts> {
+		using StorageManager = PDPLSimpleManager<DataKey, DataTupleHeader, IndexTuple, DataIndexTp, VersionType, TableLayouts>;
+
+		static_assert(StorageManagerConcept<StorageManager>);
+	};
+
+	template<
+			typename DataKey, typename IndexTuple, typename DataTupleHeader, IndexType DataIndexTp,
+			typename VersionType,
+			typename TableLayouts>
+	struct StorageManagerManager<StorageManagerType::Tiered_PMEMDATA_PMEMLOG,
+			DataKey, DataTupleHeader, IndexTuple, DataIndexTp,
+			VersionType, TableLayouts> {
+		using StorageManager = TieredPDPLManager<DataKey, DataTupleHeader, IndexTuple, DataIndexTp, VersionType, TableLayouts>;
 
 		static_assert(StorageManagerConcept<StorageManager>);
 	};
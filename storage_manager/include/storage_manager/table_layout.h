@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+
+#include <data_manager/data_manager.h>
+
+#include <storage_manager/abstract_storage_manager.h>
+
+namespace storage {
+
+	//! @brief Media where tuples of a table are placed.
+	enum class TableMedia {
+		/// Decided by the storage manager
+		Default,
+		DRAM,
+		PMEM
+	};
+
+	//! @brief Index and media of a single table.
+	template<IndexType IndexTp, TableMedia Media = TableMedia::Default>
+	struct TableLayout {
+		static constexpr IndexType  INDEX_TYPE = IndexTp;
+		static constexpr TableMedia MEDIA      = Media;
+	};
+
+	//! @brief Layouts of all tables, ordered as the data type inode.
+	template<class ...Tables>
+	struct TableLayoutList {
+		static constexpr size_t TABLE_NUM = sizeof...(Tables);
+	};
+
+	//! @brief Resolve the kind of data manager of a table.
+	constexpr datam::DataManagerKind get_table_data_manager_kind(TableMedia media, datam::DataManagerKind default_kind) {
+		switch (media) {
+			case TableMedia::DRAM: return datam::DataManagerKind::DRAM;
+			case TableMedia::PMEM: return datam::DataManagerKind::PMEM;
+			default:               return default_kind;
+		}
+	}
+
+	/*!
+	 * @brief Data managers of all tables, one for each layout.
+	 * @tparam DefaultKind The kind of data manager for tables without media specified.
+	 */
+	template<datam::DataManagerKind DefaultKind, class Key, class TupleHeader, class IndexTuple, class Layout>
+	struct TableDataManagerTuple {
+		using Type = void;
+	};
+
+	template<datam::DataManagerKind DefaultKind, class Key, class TupleHeader, class IndexTuple, class ...Tables>
+	struct TableDataManagerTuple<DefaultKind, Key, TupleHeader, IndexTuple, TableLayoutList<Tables...>> {
+		using Type = std::tuple<
+				typename datam::DataManagerManager<
+						get_table_data_manager_kind(Tables::MEDIA, DefaultKind),
+						Key, TupleHeader, IndexTuple, Tables::INDEX_TYPE
+				>::DataManager...
+		>;
+	};
+
+}
@@ -18,7 +18,7 @@ namespace versionm {
 	struct PMEMVersionManagerBasic {
 		using VersionHeaderType = VersionHeader;
 
-		using VersionAllocator  = allocator::SimplePmemAllocator;
+		using VersionAllocator  = allocator::SlabPmemAllocator;
 	};
 
 	template<class VersionHeader>
@@ -40,7 +40,7 @@ namespace versionm {
 
 		static constexpr StorageMemType get_data_storage_memtype() { return VERSION_STORAGE_MEM_TYPE; };
 
-		using VersionAllocator = allocator::SimplePmemAllocator;
+		using VersionAllocator = allocator::SlabPmemAllocator;
 		static_assert(allocator::MemAllocatorConcept<VersionAllocator>);
 
 		static constexpr StorageControlHeader get_version_storage_control_header() { return VersionAllocator::get_header(); }
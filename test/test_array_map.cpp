@@ -0,0 +1,134 @@
+#include <cstdint>
+#include <cassert>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <functional>
+
+#include <index/array_map/array_map.h>
+
+//! @brief Value whose halves are written together, so that a torn read is detectable.
+struct PairValue {
+	uint64_t value;
+
+	uint64_t check;
+
+	PairValue(): value(0), check(~0ULL) {}
+
+	explicit PairValue(uint64_t new_value): value(new_value), check(~new_value) {}
+
+	bool is_consistent() const { return check == ~value; }
+};
+
+using MapType = ix::ArrayMap<int64_t, PairValue>;
+
+//! @brief Keys inside the slot array, beyond it and negative ones behave the same.
+void test_single_thread() {
+	constexpr uint32_t EXPECTED_AMOUNT = 100;
+
+	MapType map(sizeof(PairValue), EXPECTED_AMOUNT);
+	const std::vector<int64_t> key_list = {
+			// Slots
+			0, 1, 63, 199,
+			// Overflow map
+			200, 1'000'000, INT64_MAX,
+			// Negative keys fall into overflow map as well
+			-1, -200, INT64_MIN
+	};
+
+	PairValue output;
+	for (int64_t key: key_list) {
+		assert(!map.contain(key));
+		assert(!map.read(key, output));
+		assert(!map.update(key, PairValue(1)));
+		assert(!map.remove(key));
+	}
+
+	// Insert
+	for (int64_t key: key_list) {
+		assert(map.insert(key, PairValue(static_cast<uint64_t>(key))));
+		assert(!map.insert(key, PairValue(0)));
+	}
+	assert(map.size() == key_list.size());
+	for (int64_t key: key_list) {
+		assert(map.read(key, output));
+		assert(output.value == static_cast<uint64_t>(key) && output.is_consistent());
+	}
+
+	// Update
+	for (int64_t key: key_list) {
+		assert(map.update(key, PairValue(static_cast<uint64_t>(key) + 1)));
+	}
+	for (int64_t key: key_list) {
+		assert(map.read(key, output));
+		assert(output.value == static_cast<uint64_t>(key) + 1 && output.is_consistent());
+	}
+
+	// Remove half of keys, and insert them again
+	for (size_t idx = 0; idx < key_list.size(); idx += 2) {
+		assert(map.remove(key_list[idx]));
+		assert(!map.remove(key_list[idx]));
+		assert(!map.contain(key_list[idx]));
+	}
+	assert(map.size() == key_list.size() / 2);
+	for (size_t idx = 1; idx < key_list.size(); idx += 2) {
+		assert(map.contain(key_list[idx]));
+	}
+	for (size_t idx = 0; idx < key_list.size(); idx += 2) {
+		assert(map.insert(key_list[idx], PairValue(2)));
+		assert(map.read(key_list[idx], output) && output.value == 2);
+	}
+
+	// Clear visits every value once
+	uint32_t clear_num = 0;
+	std::function<void(const PairValue &)> clear_func = [&clear_num](const PairValue &value) {
+		assert(value.is_consistent());
+		++clear_num;
+	};
+	map.clear(clear_func);
+	assert(clear_num == key_list.size());
+	assert(map.size() == 0);
+	for (int64_t key: key_list) { assert(!map.contain(key)); }
+}
+
+//! @brief Readers never see a value torn by concurrent writers.
+void test_concurrent_update() {
+	constexpr uint32_t KEY_NUM       = 8;
+	constexpr uint32_t WRITER_NUM    = 2;
+	constexpr uint32_t READER_NUM    = 2;
+	constexpr uint32_t WRITE_ROUND   = 200'000;
+
+	MapType map(sizeof(PairValue), KEY_NUM);
+	for (int64_t key = 0; key < KEY_NUM; ++key) { assert(map.insert(key, PairValue(0))); }
+
+	std::atomic<bool> stop{false};
+	std::vector<std::thread> thread_list;
+	for (uint32_t writer = 0; writer < WRITER_NUM; ++writer) {
+		thread_list.emplace_back([&map, writer] {
+			for (uint64_t round = 1; round <= WRITE_ROUND; ++round) {
+				assert(map.update(static_cast<int64_t>((round + writer) % KEY_NUM), PairValue(round)));
+			}
+		});
+	}
+	for (uint32_t reader = 0; reader < READER_NUM; ++reader) {
+		thread_list.emplace_back([&map, &stop] {
+			PairValue output;
+			while (!stop.load(std::memory_order::relaxed)) {
+				for (int64_t key = 0; key < KEY_NUM; ++key) {
+					assert(map.read(key, output));
+					assert(output.is_consistent());
+				}
+			}
+		});
+	}
+
+	for (uint32_t writer = 0; writer < WRITER_NUM; ++writer) { thread_list[writer].join(); }
+	stop.store(true, std::memory_order::relaxed);
+	for (uint32_t idx = WRITER_NUM; idx < thread_list.size(); ++idx) { thread_list[idx].join(); }
+}
+
+int main() {
+	test_single_thread();
+	test_concurrent_update();
+	return 0;
+}
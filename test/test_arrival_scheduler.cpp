@@ -0,0 +1,46 @@
+#include <cstdint>
+#include <cassert>
+#include <cmath>
+
+#include <util/tsc_clock.h>
+#include <transaction_manager/load_generator.h>
+
+using transaction::ArrivalScheduler;
+
+//! @brief Arrivals of a worker follow its share of the offered load.
+void test_rate(double offered_load, uint32_t thread_num) {
+	constexpr uint64_t ARRIVAL_NUM = 200'000;
+
+	ArrivalScheduler scheduler(offered_load, thread_num);
+	assert(scheduler.is_open_loop());
+
+	const double expect_interval = 1e9 * thread_num / offered_load;
+
+	// The first arrival lies within one interval from start
+	const uint64_t start_time = util::TSCClock::now();
+	scheduler.start();
+	const uint64_t first_arrival = scheduler.take_arrival();
+	assert(first_arrival >= start_time);
+	assert(util::TSCClock::to_ns(first_arrival - start_time) <= static_cast<uint64_t>(expect_interval) + 1000);
+
+	uint64_t last_arrival = first_arrival;
+	for (uint64_t idx = 1; idx < ARRIVAL_NUM; ++idx) {
+		const uint64_t arrival = scheduler.take_arrival();
+		assert(arrival >= last_arrival);
+		last_arrival = arrival;
+	}
+
+	// The standard error of mean interval is far below the tolerance
+	const double mean_interval = static_cast<double>(last_arrival - first_arrival)
+	                             * util::TSCClock::get_ns_per_cycle() / (ARRIVAL_NUM - 1);
+	assert(std::abs(mean_interval - expect_interval) <= expect_interval * 0.02);
+}
+
+int main() {
+	assert(!ArrivalScheduler(0.0, 4).is_open_loop());
+
+	test_rate(1e6, 1);
+	test_rate(1e6, 4);
+	test_rate(5e4, 8);
+	return 0;
+}
@@ -0,0 +1,24 @@
+#include <cassert>
+
+#include <PTM/crash_bench.h>
+#include <global_config/global_config.h>
+
+using namespace ptm;
+
+using GlobalConfig = GlobalConfigManager<
+				WorkloadType::SmallBank_Transfer,
+				IndexType::HashMap,
+				ConcurrentControlType::COURIER_SAVE,
+				TransactionManagerType::StdTransactionManager,
+				ThreadBindStrategyType::NUMABind,
+				StorageManagerType::Simple_PMEMDATA_PMEMLOG>;
+
+//! @brief Every round should recover a consistent state, whenever the crash happens.
+int main() {
+	constexpr uint32_t ROUND_NUM = 4;
+
+	ptm::crash_bench<GlobalConfig> crash_bench;
+	const uint32_t consistent_num = crash_bench.run(ROUND_NUM, 4, 500);
+	assert(consistent_num == ROUND_NUM);
+	return 0;
+}
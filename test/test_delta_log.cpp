@@ -0,0 +1,65 @@
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <vector>
+
+#include <util/random_generator.h>
+#include <concurrent_control/delta_log.h>
+
+//! @brief Encode a delta and replay it on the pre-image, which should give the new content.
+void test_round_trip(const std::vector<uint8_t> &new_content, const std::vector<uint8_t> &old_content) {
+	const auto size = static_cast<uint32_t>(new_content.size());
+	std::vector<uint8_t> delta(cc::get_max_delta_size(size));
+
+	const uint32_t delta_size = cc::encode_delta(delta.data(), new_content.data(), old_content.data(), size);
+	assert(delta_size <= cc::get_max_delta_size(size));
+
+	// Runs are ordered, disjoint and cover all changed bytes
+	uint32_t next_offset = 0, changed_num = 0;
+	cc::for_each_delta_run(delta.data(), delta_size, [&](uint32_t offset, uint32_t run_size, const uint8_t *run_ptr) {
+		assert(run_size > 0);
+		assert(offset >= next_offset && offset + run_size <= size);
+		assert(std::memcmp(run_ptr, new_content.data() + offset, run_size) == 0);
+		for (uint32_t idx = offset; idx < offset + run_size; ++idx) {
+			changed_num += new_content[idx] != old_content[idx];
+		}
+		next_offset = offset + run_size;
+	});
+	uint32_t expect_changed_num = 0;
+	for (uint32_t idx = 0; idx < size; ++idx) {
+		expect_changed_num += new_content[idx] != old_content[idx];
+	}
+	assert(changed_num == expect_changed_num);
+	if (expect_changed_num == 0) { assert(delta_size == 0); }
+
+	// Replaying is idempotent
+	std::vector<uint8_t> content = old_content;
+	cc::apply_delta(content.data(), delta.data(), delta_size);
+	assert(content == new_content);
+	cc::apply_delta(content.data(), delta.data(), delta_size);
+	assert(content == new_content);
+}
+
+int main() {
+	for (uint32_t round = 0; round < 100'000; ++round) {
+		const auto size = util::rander.rand_range<uint32_t>(1, 512);
+		std::vector<uint8_t> old_content(size), new_content(size);
+		for (uint8_t &byte: old_content) {
+			byte = static_cast<uint8_t>(util::rander.rand_range<uint32_t>(0, 255));
+		}
+
+		// Changes range from none to all bytes, scattered or clustered
+		new_content = old_content;
+		const auto change_percent = util::rander.rand_range<uint32_t>(0, 100);
+		const bool clustered = util::rander.rand_range<uint32_t>(0, 1) == 0;
+		const auto cluster_start = util::rander.rand_range<uint32_t>(0, size - 1);
+		for (uint32_t idx = 0; idx < size; ++idx) {
+			if (clustered && (idx < cluster_start || idx >= cluster_start + size * change_percent / 100)) { continue; }
+			if (!clustered && util::rander.rand_range<uint32_t>(1, 100) > change_percent) { continue; }
+			new_content[idx] = static_cast<uint8_t>(old_content[idx] + util::rander.rand_range<uint32_t>(1, 255));
+		}
+
+		test_round_trip(new_content, old_content);
+	}
+	return 0;
+}
@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <cassert>
+#include <string>
+#include <sstream>
+#include <thread>
+
+#include <util/event_tracer.h>
+
+static_assert(util::ENABLE_EVENT_TRACE, "Event tracing should be switched on for test");
+
+using util::EventTracer;
+
+//! @brief Count occurrences of a pattern in the dumped trace.
+uint64_t count_pattern(const std::string &trace, const std::string &pattern) {
+	uint64_t count = 0;
+	for (size_t pos = trace.find(pattern); pos != std::string::npos; pos = trace.find(pattern, pos + 1)) {
+		++count;
+	}
+	return count;
+}
+
+std::string dump_trace() {
+	std::ostringstream os;
+	EventTracer::dump_json(os);
+	return os.str();
+}
+
+//! @brief The ring keeps the latest events, with the oldest ones overwritten.
+void test_wraparound() {
+	constexpr uint64_t OVERWRITTEN_NUM = 1000;
+
+	std::thread worker([] {
+		for (uint64_t idx = 0; idx < EventTracer::EVENT_CAPACITY + OVERWRITTEN_NUM; ++idx) {
+			const char *name = idx < OVERWRITTEN_NUM ? "overwritten" : "kept";
+			EventTracer::record(name, idx * 10, idx * 10 + 5);
+		}
+	});
+	worker.join();
+
+	const std::string trace = dump_trace();
+	assert(count_pattern(trace, "\"ph\": \"X\"") == EventTracer::EVENT_CAPACITY);
+	assert(count_pattern(trace, "\"name\": \"kept\"") == EventTracer::EVENT_CAPACITY);
+	assert(count_pattern(trace, "\"name\": \"overwritten\"") == 0);
+	// Events are dumped from the oldest kept one, which time is relative to
+	assert(trace.find("\"name\": \"kept\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, \"ts\": 0.000,") != std::string::npos);
+}
+
+//! @brief Nothing is kept after clearing, and the buffer of an exited thread is reused.
+void test_clear() {
+	EventTracer::clear();
+	assert(count_pattern(dump_trace(), "\"ph\": \"X\"") == 0);
+
+	std::thread worker([] { EventTracer::record("reused", 1, 2); });
+	worker.join();
+
+	const std::string trace = dump_trace();
+	assert(count_pattern(trace, "\"ph\": \"X\"") == 1);
+	assert(count_pattern(trace, "\"ph\": \"M\"") == 1);
+	assert(count_pattern(trace, "\"tid\": 0") == 2);
+}
+
+//! @brief Nothing is recorded while disabled.
+void test_disable() {
+	EventTracer::clear();
+	EventTracer::disable();
+	EventTracer::record("disabled", 1, 2);
+	assert(count_pattern(dump_trace(), "\"ph\": \"X\"") == 0);
+	EventTracer::enable();
+}
+
+int main() {
+	EventTracer::enable();
+	test_wraparound();
+	test_clear();
+	test_disable();
+	return 0;
+}
@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+#include <util/latency_histogram.h>
+#include <util/random_generator.h>
+
+using Histogram = util::LatencyHistogram<>;
+
+/// The maximum relative error of a recorded value
+constexpr double MAX_RELATIVE_ERROR = 1.0 / Histogram::HALF_SUB_BUCKET_NUM;
+
+//! @brief Each value lies in its bucket, whose width is bounded by the relative error.
+void test_bucket_bound(uint64_t value) {
+	const uint64_t index = Histogram::get_bucket_index(value);
+	assert(index < Histogram::BUCKET_NUM);
+
+	const uint64_t lower_bound = Histogram::get_bucket_lower_bound(index);
+	const uint64_t upper_bound = Histogram::get_bucket_upper_bound(index);
+	assert(lower_bound <= value && value <= upper_bound);
+	if (value < Histogram::SUB_BUCKET_NUM) {
+		assert(lower_bound == value && upper_bound == value);
+	}
+	// The last bucket is open, holding values clamped
+	else if (index + 1 != Histogram::BUCKET_NUM) {
+		assert(static_cast<double>(upper_bound - value) <= static_cast<double>(value) * MAX_RELATIVE_ERROR);
+	}
+}
+
+void test_bucket() {
+	// Buckets are contiguous
+	for (uint64_t index = 0; index + 2 < Histogram::BUCKET_NUM; ++index) {
+		assert(Histogram::get_bucket_upper_bound(index) + 1 == Histogram::get_bucket_lower_bound(index + 1));
+		assert(Histogram::get_bucket_index(Histogram::get_bucket_lower_bound(index)) == index);
+		assert(Histogram::get_bucket_index(Histogram::get_bucket_upper_bound(index)) == index);
+	}
+
+	for (uint64_t value = 0; value < (1UL << 16); ++value) {
+		test_bucket_bound(value);
+	}
+	for (uint32_t i = 0; i < 1'000'000; ++i) {
+		test_bucket_bound(util::rander.rand_range<uint64_t>(0, (1UL << 40) - 1));
+	}
+
+	// Values out of range are clamped into the last bucket
+	assert(Histogram::get_bucket_index(1UL << 40) == Histogram::BUCKET_NUM - 1);
+	assert(Histogram::get_bucket_index(UINT64_MAX) == Histogram::BUCKET_NUM - 1);
+}
+
+void test_percentile() {
+	constexpr uint64_t VALUE_NUM = 1'000'000;
+
+	Histogram histogram;
+	assert(histogram.get_latency_summary(99.0) == 0);
+
+	for (uint64_t value = 1; value <= VALUE_NUM; ++value) {
+		histogram.add_latency(value);
+	}
+	assert(histogram.get_count() == VALUE_NUM);
+	assert(histogram.get_min() == 1);
+	assert(histogram.get_max() == VALUE_NUM);
+	assert(histogram.get_time_summary() == VALUE_NUM * (VALUE_NUM + 1) / 2);
+
+	// The exact percentile is the value ranked there
+	for (double percentile: { 0.0, 1.0, 50.0, 90.0, 99.0, 99.9, 99.99, 100.0 }) {
+		const auto rank     = std::max<uint64_t>(static_cast<uint64_t>(VALUE_NUM * percentile / 100.0 + 0.5), 1);
+		const uint64_t res  = histogram.get_latency_summary(percentile);
+		assert(res >= rank && res <= VALUE_NUM);
+		assert(static_cast<double>(res - rank) <= static_cast<double>(rank) * MAX_RELATIVE_ERROR);
+	}
+
+	// The maximum is kept exactly even if clamped
+	histogram.add_latency(1UL << 50);
+	assert(histogram.get_max() == (1UL << 50));
+	assert(histogram.get_latency_summary(100.0) == (1UL << 50));
+}
+
+void test_combine() {
+	Histogram histogram_a, histogram_b, histogram_all;
+	for (uint32_t i = 0; i < 100'000; ++i) {
+		const uint64_t value = util::rander.rand_range<uint64_t>(0, 1'000'000);
+		(i % 2 == 0 ? histogram_a : histogram_b).add_latency(value);
+		histogram_all.add_latency(value);
+	}
+	histogram_a.combine(histogram_b);
+	assert(histogram_a.get_count() == histogram_all.get_count());
+	assert(histogram_a.get_min() == histogram_all.get_min());
+	assert(histogram_a.get_max() == histogram_all.get_max());
+	for (double percentile: { 50.0, 99.0, 99.9 }) {
+		assert(histogram_a.get_latency_summary(percentile) == histogram_all.get_latency_summary(percentile));
+	}
+
+	// Adding several data at once equals adding them one by one
+	Histogram histogram_batch, histogram_single;
+	histogram_batch.add_latency(12345, 10);
+	histogram_batch.add_latency(7, 0);
+	for (uint32_t i = 0; i < 10; ++i) { histogram_single.add_latency(12345); }
+	assert(histogram_batch.get_count() == histogram_single.get_count());
+	assert(histogram_batch.get_time_summary() == histogram_single.get_time_summary());
+	assert(histogram_batch.get_min() == histogram_single.get_min());
+	assert(histogram_batch.get_latency_summary(50.0) == histogram_single.get_latency_summary(50.0));
+}
+
+int main() {
+	test_bucket();
+	test_percentile();
+	test_combine();
+	return 0;
+}
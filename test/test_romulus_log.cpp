@@ -0,0 +1,195 @@
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <array>
+#include <vector>
+#include <thread>
+#include <functional>
+#include <unordered_map>
+
+#include <thread/thread.h>
+#include <concurrent_control/romulus_log/romulus_log.h>
+
+//! @brief Row of counters, each field of which is updated on its own.
+struct CounterRow {
+	static constexpr uint32_t FIELD_NUM = 4;
+
+	std::array<uint64_t, FIELD_NUM> field;
+
+	uint64_t get_element(uint32_t field_idx) const { return field[field_idx]; }
+
+	void set_element(uint32_t field_idx, uint64_t value) { field[field_idx] = value; }
+
+	auto operator<=>(const CounterRow &other) const = default;
+};
+
+//! @brief Minimal workload in the callback form applied by RomulusLog
+struct CounterWorkload {
+	using KeyType   = uint64_t;
+	using FieldType = uint32_t;
+	using ValueType = uint64_t;
+	using RowType   = CounterRow;
+
+	static constexpr uint32_t ALL_FIELD = CounterRow::FIELD_NUM;
+
+	struct Transaction {
+		enum class Type {
+			Insert,
+			Increase,
+			Read
+		};
+
+		Type type;
+
+		KeyType key;
+
+		FieldType field;
+
+		/// Output of read-only transaction
+		CounterRow result;
+
+		bool run(auto &read_func, auto &write_func, auto &, auto &insert_func) {
+			switch (type) {
+				case Type::Insert:
+					return insert_func(key, ALL_FIELD, CounterRow{});
+				case Type::Increase: {
+					CounterRow row;
+					if (!read_func(key, ALL_FIELD, &row)) { return false; }
+					row.set_element(field, row.get_element(field) + 1);
+					return write_func(key, field, std::move(row));
+				}
+				case Type::Read:
+					return read_func(key, ALL_FIELD, &result);
+			}
+			return false;
+		}
+
+		bool is_only_read() const { return type == Type::Read; }
+	};
+};
+
+//! @brief Storage manager emulating PMEM on DRAM, with the single-table interface RomulusLog relies on.
+class CounterStorageManager {
+public:
+	using DataKeyType         = uint64_t;
+
+	using DataTupleHeaderType = uint64_t;
+
+	using TupleType           = cc::romulus::DataTuple<CounterRow>;
+
+	using IndexTupleType      = cc::romulus::IndexTuple<CounterRow>;
+
+private:
+	std::mutex lock_;
+
+	std::unordered_map<DataKeyType, IndexTupleType> index_;
+
+public:
+	~CounterStorageManager() {
+		for (auto &[key, index_tuple]: index_) { delete index_tuple.get_data_ptr(); }
+	}
+
+public:
+	bool add_data_index_tuple(uint32_t, DataKeyType key, const IndexTupleType &index_tuple) { return add_data(key, index_tuple); }
+
+	bool delete_data_index_tuple(uint32_t, DataKeyType key) {
+		std::lock_guard guard(lock_);
+		return index_.erase(key) != 0;
+	}
+
+	bool read_data_index_tuple(uint32_t, DataKeyType key, IndexTupleType &index_tuple) { return read_data(key, index_tuple); }
+
+	std::pair<DataTupleHeaderType *, void *> allocate_data_and_header(uint32_t) { return { nullptr, nullptr }; }
+
+	void *allocate_data(uint32_t) { return nullptr; }
+
+	DataTupleHeaderType *allocate_header(uint32_t) { return nullptr; }
+
+	void deallocate_data_and_header(uint32_t, void *) {}
+
+	void deallocate_data(uint32_t, void *) {}
+
+	void deallocate_header(uint32_t, DataTupleHeaderType *) {}
+
+	void register_data_deallocate_func(std::function<void(void *)>, uint32_t) {}
+
+	void pwb_range(const void *, size_t) {}
+
+	void fence() {}
+
+public: // Interface used by RomulusLog
+	bool read_data(DataKeyType key, IndexTupleType &index_tuple) {
+		std::lock_guard guard(lock_);
+		auto iter = index_.find(key);
+		if (iter == index_.end()) { return false; }
+		index_tuple = iter->second;
+		return true;
+	}
+
+	bool add_data(DataKeyType key, const IndexTupleType &index_tuple) {
+		std::lock_guard guard(lock_);
+		return index_.emplace(key, index_tuple).second;
+	}
+
+	TupleType *allocate_data(const CounterRow &row) { return new TupleType(row); }
+
+	void deallocate_data(TupleType *tuple_ptr) { delete tuple_ptr; }
+
+	void register_data_deallocate_func(auto &&) {}
+};
+
+using RomulusLogType = cc::romulus::RomulusLog<CounterWorkload, CounterStorageManager>;
+using Transaction    = CounterWorkload::Transaction;
+
+int main() {
+	constexpr uint32_t KEY_NUM      = 16;
+	constexpr uint32_t THREAD_NUM   = 4;
+	constexpr uint32_t INCREASE_NUM = 10'000;
+
+	CounterStorageManager storage_manager;
+	RomulusLogType romulus_log(&storage_manager);
+
+	thread::THREAD_CONTEXT.bind_tid(0);
+	for (uint64_t key = 0; key < KEY_NUM; ++key) {
+		Transaction tx{ .type = Transaction::Type::Insert, .key = key, .field = 0, .result = {} };
+		romulus_log.run_transaction(tx);
+	}
+	thread::THREAD_CONTEXT.deallocate_tid();
+
+	// Mutations of concurrent threads are applied by flat combining
+	std::vector<std::thread> thread_list;
+	for (uint32_t tid = 0; tid < THREAD_NUM; ++tid) {
+		thread_list.emplace_back([&romulus_log, tid] {
+			thread::THREAD_CONTEXT.bind_tid(static_cast<int>(tid));
+			for (uint32_t idx = 0; idx < INCREASE_NUM; ++idx) {
+				Transaction tx{
+					.type = Transaction::Type::Increase,
+					.key = idx % KEY_NUM,
+					.field = tid % CounterRow::FIELD_NUM,
+					.result = {}
+				};
+				romulus_log.run_transaction(tx);
+			}
+			thread::THREAD_CONTEXT.deallocate_tid();
+		});
+	}
+	for (auto &thread: thread_list) { thread.join(); }
+
+	// Every increment is applied once, and backed up to the back copy
+	thread::THREAD_CONTEXT.bind_tid(0);
+	uint64_t total = 0;
+	for (uint64_t key = 0; key < KEY_NUM; ++key) {
+		Transaction tx{ .type = Transaction::Type::Read, .key = key, .field = 0, .result = {} };
+		romulus_log.run_transaction(tx);
+		for (uint32_t field = 0; field < CounterRow::FIELD_NUM; ++field) { total += tx.result.get_element(field); }
+
+		CounterStorageManager::IndexTupleType index_tuple;
+		assert(storage_manager.read_data(key, index_tuple));
+		assert(*index_tuple.get_main_data_ptr() == *index_tuple.get_back_data_ptr());
+		assert(*index_tuple.get_main_data_ptr() == tx.result);
+	}
+	assert(total == static_cast<uint64_t>(THREAD_NUM) * INCREASE_NUM);
+	thread::THREAD_CONTEXT.deallocate_tid();
+
+	return 0;
+}
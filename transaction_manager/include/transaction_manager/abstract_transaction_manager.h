@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <chrono>
+#include <array>
 
 #include <thread_allocator/abstract_thread_allocator.h>
 #include <transaction_manager/task_error.h>
@@ -15,6 +16,31 @@ namespace transaction {
 
 	using ThreadBindStrategy     = allocator::ThreadBindStrategy;
 
+	//! @brief Information about transactions of a type.
+	struct TransactionTypeInfo {
+		uint64_t total_tx_{0};
+
+		uint64_t abort_tx_{0};
+
+		uint64_t latency_50_{0};
+
+		uint64_t latency_99_{0};
+
+		uint64_t latency_max_{0};
+	};
+
+	//! @brief Information about aborted attempts of a reason.
+	struct AbortReasonInfo {
+		uint64_t abort_tx_{0};
+
+		/// Wasted time(ns) of an aborted attempt
+		uint64_t wasted_time_50_{0};
+
+		uint64_t wasted_time_99_{0};
+
+		uint64_t total_wasted_time_{0};
+	};
+
 	//! @brief Information about transaction execution.
 	struct TransactionManagerInfo {
 	public:
@@ -28,6 +54,26 @@ namespace transaction {
 
 		uint64_t abort_tx_;
 
+		uint64_t retry_tx_;
+
+		uint64_t defer_tx_;
+
+		/// Deferred transactions dropped when workers stop
+		uint64_t unfinished_defer_tx_;
+
+		/// Routed transactions left in inbound queues when workers stop
+		uint64_t unfinished_route_tx_;
+
+		uint64_t wasted_time_;
+
+		uint64_t backoff_time_;
+
+		uint64_t early_abort_tx_;
+
+		uint64_t log_size_;
+
+		uint64_t raw_log_size_;
+
 		uint64_t running_latency_;
 
 		uint64_t commit_latency_;
@@ -42,6 +88,16 @@ namespace transaction {
 
 		uint64_t total_transaction_latency_;
 
+		uint64_t total_transaction_latency_50_;
+
+		uint64_t total_transaction_latency_999_;
+
+		uint64_t total_transaction_latency_max_;
+
+		uint64_t persist_log_latency_max_;
+
+		uint64_t early_validate_latency_;
+
 		uint64_t running_time_;
 
 		uint64_t commit_time_;
@@ -56,12 +112,45 @@ namespace transaction {
 
 		uint64_t persist_data_time_;
 
+		uint64_t early_validate_time_;
+
+		std::array<TransactionTypeInfo, cc::MAX_TRANSACTION_TYPE_NUM> type_info_;
+
+		std::array<AbortReasonInfo, cc::ABORT_REASON_NUM> reason_info_;
+
+		/// Offered load(txn/s) in open-loop mode, 0 for closed-loop mode
+		double offered_load_;
+
+		uint64_t response_latency_50_;
+
+		uint64_t response_latency_99_;
+
+		uint64_t response_latency_999_;
+
+		uint64_t response_latency_max_;
+
+		/// Cache lines flushed in each phase, the last one for those out of any phase
+		std::array<uint64_t, cc::RECORD_EVENT_NUM + 1> persist_flush_line_num_;
+		/// Fences issued in each phase, the last one for those out of any phase
+		std::array<uint64_t, cc::RECORD_EVENT_NUM + 1> persist_fence_num_;
+		/// Hardware events in each phase, estimated from sampled transactions
+		std::array<std::array<uint64_t, util::listener::PAPICounter::EVENT_NUM>, cc::RECORD_EVENT_NUM> papi_event_num_;
+
 	public:
 		TransactionManagerInfo():   total_running_time_(1),
 									total_thread_num_(0),
 									worker_thread_num_(0),
 									total_tx_(0),
 									abort_tx_(0),
+									retry_tx_(0),
+									defer_tx_(0),
+									unfinished_defer_tx_(0),
+									unfinished_route_tx_(0),
+									wasted_time_(0),
+									backoff_time_(0),
+									early_abort_tx_(0),
+									log_size_(0),
+									raw_log_size_(0),
 									running_latency_(0),
 									commit_latency_(0),
 									index_latency_(0),
@@ -69,13 +158,29 @@ namespace transaction {
 									persist_log_latency_(0),
 									persist_data_latency_(0),
 									total_transaction_latency_(0),
+									total_transaction_latency_50_(0),
+									total_transaction_latency_999_(0),
+									total_transaction_latency_max_(0),
+									persist_log_latency_max_(0),
+									early_validate_latency_(0),
 									running_time_(0),
 									commit_time_(0),
 									index_time_(0),
 									transaction_interface_time_(0),
 									validate_time_(0),
 									persist_log_time_(0),
-									persist_data_time_(0) {}
+									persist_data_time_(0),
+									early_validate_time_(0),
+									type_info_{},
+									reason_info_{},
+									offered_load_(0),
+									response_latency_50_(0),
+									response_latency_99_(0),
+									response_latency_999_(0),
+									response_latency_max_(0),
+									persist_flush_line_num_{},
+									persist_fence_num_{},
+									papi_event_num_{} {}
 
 		TransactionManagerInfo(std::chrono::milliseconds running_time,
 		                       uint64_t total_thread_num,
@@ -86,6 +191,15 @@ namespace transaction {
 				worker_thread_num_(worker_thread_num),
 				total_tx_(cc_message.total_tx),
 				abort_tx_(cc_message.abort_tx),
+				retry_tx_(cc_message.retry_tx),
+				defer_tx_(cc_message.defer_tx),
+				unfinished_defer_tx_(cc_message.unfinished_defer_tx),
+				unfinished_route_tx_(0),
+				wasted_time_(cc_message.wasted_time),
+				backoff_time_(cc_message.backoff_time),
+				early_abort_tx_(cc_message.early_abort_tx),
+				log_size_(cc_message.log_size),
+				raw_log_size_(cc_message.raw_log_size),
 				running_latency_(cc_message.get_total_running_latency(99)),
 				commit_latency_(cc_message.get_total_commit_latency(99)),
 				index_latency_(cc_message.get_total_index_latency(99)),
@@ -93,14 +207,60 @@ namespace transaction {
 				persist_log_latency_(cc_message.get_total_persist_log_latency(99)),
 				persist_data_latency_(cc_message.get_total_persist_data_latency(99)),
 				total_transaction_latency_(cc_message.get_total_total_latency(99)),
+				total_transaction_latency_50_(cc_message.get_total_total_latency(50)),
+				total_transaction_latency_999_(cc_message.get_total_total_latency(99.9)),
+				total_transaction_latency_max_(cc_message.get_max_total_latency()),
+				persist_log_latency_max_(cc_message.get_max_persist_log_latency()),
+				early_validate_latency_(cc_message.get_total_early_validate_latency(99)),
 				running_time_(cc_message.get_total_running_time()),
 				commit_time_(cc_message.get_total_commit_time()),
 				index_time_(cc_message.get_total_index_time()),
 				validate_time_(cc_message.get_total_validate_time()),
 				persist_log_time_(cc_message.get_total_persist_log_time()),
-				persist_data_time_(cc_message.get_total_persist_data_time()) {
+				persist_data_time_(cc_message.get_total_persist_data_time()),
+				early_validate_time_(cc_message.get_total_early_validate_time()),
+				reason_info_{},
+				offered_load_(0),
+				response_latency_50_(cc_message.get_response_latency(50)),
+				response_latency_99_(cc_message.get_response_latency(99)),
+				response_latency_999_(cc_message.get_response_latency(99.9)),
+				response_latency_max_(cc_message.get_max_response_latency()),
+				persist_flush_line_num_{},
+				persist_fence_num_{},
+				papi_event_num_{} {
 
 			transaction_interface_time_    = running_time_ - index_time_;
+
+			for (uint32_t type_tag = 0; type_tag < cc::MAX_TRANSACTION_TYPE_NUM; ++type_tag) {
+				type_info_[type_tag] = TransactionTypeInfo {
+					.total_tx_    = cc_message.get_type_total_tx(type_tag),
+					.abort_tx_    = cc_message.get_type_abort_tx(type_tag),
+					.latency_50_  = cc_message.get_type_latency(type_tag, 50),
+					.latency_99_  = cc_message.get_type_latency(type_tag, 99),
+					.latency_max_ = cc_message.get_type_max_latency(type_tag)
+				};
+			}
+
+			for (uint32_t reason = 0; reason < cc::ABORT_REASON_NUM; ++reason) {
+				reason_info_[reason] = AbortReasonInfo {
+					.abort_tx_          = cc_message.get_reason_abort_tx(reason),
+					.wasted_time_50_    = cc_message.get_reason_wasted_time(reason, 50),
+					.wasted_time_99_    = cc_message.get_reason_wasted_time(reason, 99),
+					.total_wasted_time_ = cc_message.get_reason_total_wasted_time(reason)
+				};
+			}
+
+			for (uint32_t phase = 0; phase <= cc::RECORD_EVENT_NUM; ++phase) {
+				const uint32_t counter_phase = phase < cc::RECORD_EVENT_NUM ? phase : PersistCounter::NO_PHASE;
+				persist_flush_line_num_[phase] = cc_message.get_persist_flush_line_num(counter_phase);
+				persist_fence_num_[phase]      = cc_message.get_persist_fence_num(counter_phase);
+			}
+
+			for (uint32_t phase = 0; phase < cc::RECORD_EVENT_NUM; ++phase) {
+				for (uint32_t event = 0; event < util::listener::PAPICounter::EVENT_NUM; ++event) {
+					papi_event_num_[phase][event] = cc_message.get_papi_event_num(phase, event);
+				}
+			}
 		}
 
 		TransactionManagerInfo(const TransactionManagerInfo &other) = default;
@@ -119,6 +279,21 @@ namespace transaction {
 		{ executor.commit() } -> std::same_as<bool>;
 	};
 
+	//! @brief Concept about concurrent control able to execute transactions scheduled deterministically
+	//! @tparam ConcurrentControl
+	template<class ConcurrentControl>
+	concept DeterministicConcurrentControlConcept = ConcurrentControlConcept<ConcurrentControl>
+	        && requires(ConcurrentControl cc,
+			ConcurrentControl::ExecutorType::AbKeyType key,
+			uint32_t payload_size) {
+
+		// Executor of transactions whose conflicts are excluded in advance
+		{ cc.get_scheduled_executor() } -> std::same_as<typename ConcurrentControl::ExecutorType>;
+
+		// Read data without recording it
+		{ cc.peek(key, payload_size) } -> std::convertible_to<const void *>;
+	};
+
 
 	//! @brief Concept about transaction manager
 	//! @tparam TxManager
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <deque>
+#include <bit>
+
+#include <util/random_generator.h>
+#include <util/event_tracer.h>
+#include <thread/thread.h>
+#include <workload/workload.h>
+
+namespace transaction {
+
+	//! @brief Strategy adopted when a transaction is aborted.
+	enum class ContentionStrategy {
+		/// Retry immediately (the original behaviour)
+		Immediate,
+		/// Retry after randomized exponential backoff
+		Backoff,
+		/// Retry after backoff, and put transactions aborted repeatedly behind fresh ones
+		BackoffDefer
+	};
+
+	template<ContentionStrategy Strategy>
+	struct ContentionConfig {};
+
+	template<>
+	struct ContentionConfig<ContentionStrategy::Immediate> {
+		/// Whether to back off before retrying
+		static constexpr bool ENABLE_BACKOFF             = false;
+		/// Whether to defer transactions aborted repeatedly
+		static constexpr bool ENABLE_DEFER               = false;
+		/// The minimal window of backoff in nanoseconds
+		static constexpr uint64_t MIN_BACKOFF_NS         = 0;
+		/// The maximal window of backoff in nanoseconds
+		static constexpr uint64_t MAX_BACKOFF_NS         = 0;
+		/// The number of consecutive aborts before deferring a transaction
+		static constexpr uint32_t DEFER_ABORT_THRESHOLD  = 0;
+		/// The maximal number of deferred transactions per thread
+		static constexpr uint32_t DEFER_QUEUE_SIZE       = 0;
+		/// The number of fresh transactions executed before a deferred one is picked up
+		static constexpr uint32_t DEFER_FRESH_INTERVAL   = 0;
+	};
+
+	template<>
+	struct ContentionConfig<ContentionStrategy::Backoff> {
+		/// Whether to back off before retrying
+		static constexpr bool ENABLE_BACKOFF             = true;
+		/// Whether to defer transactions aborted repeatedly
+		static constexpr bool ENABLE_DEFER               = false;
+		/// The minimal window of backoff in nanoseconds
+		static constexpr uint64_t MIN_BACKOFF_NS         = 256;
+		/// The maximal window of backoff in nanoseconds
+		static constexpr uint64_t MAX_BACKOFF_NS         = 64 * 1024;
+		/// The number of consecutive aborts before deferring a transaction
+		static constexpr uint32_t DEFER_ABORT_THRESHOLD  = 0;
+		/// The maximal number of deferred transactions per thread
+		static constexpr uint32_t DEFER_QUEUE_SIZE       = 0;
+		/// The number of fresh transactions executed before a deferred one is picked up
+		static constexpr uint32_t DEFER_FRESH_INTERVAL   = 0;
+	};
+
+	template<>
+	struct ContentionConfig<ContentionStrategy::BackoffDefer> {
+		/// Whether to back off before retrying
+		static constexpr bool ENABLE_BACKOFF             = true;
+		/// Whether to defer transactions aborted repeatedly
+		static constexpr bool ENABLE_DEFER               = true;
+		/// The minimal window of backoff in nanoseconds
+		static constexpr uint64_t MIN_BACKOFF_NS         = 256;
+		/// The maximal window of backoff in nanoseconds
+		static constexpr uint64_t MAX_BACKOFF_NS         = 32 * 1024;
+		/// The number of consecutive aborts before deferring a transaction
+		static constexpr uint32_t DEFER_ABORT_THRESHOLD  = 3;
+		/// The maximal number of deferred transactions per thread
+		static constexpr uint32_t DEFER_QUEUE_SIZE       = 8;
+		/// The number of fresh transactions executed before a deferred one is picked up
+		static constexpr uint32_t DEFER_FRESH_INTERVAL   = 4;
+	};
+
+	//! @brief Choose contention strategy for each workload.
+	//! Hot-spot YCSB suffers most from immediate retries, so transactions keep failing
+	//! there are deferred. TPCC and SmallBank only back off.
+	template<class Workload>
+	struct ContentionConfigManager {
+		using Config = ContentionConfig<ContentionStrategy::Backoff>;
+	};
+
+	template<class WorkloadConfig>
+	struct ContentionConfigManager<workload::YCSB<WorkloadConfig>> {
+		using Config = ContentionConfig<ContentionStrategy::BackoffDefer>;
+	};
+
+	template<class WorkloadConfig>
+	struct ContentionConfigManager<workload::TPCC<WorkloadConfig>> {
+		using Config = ContentionConfig<ContentionStrategy::Backoff>;
+	};
+
+	template<class WorkloadConfig>
+	struct ContentionConfigManager<workload::SmallBank<WorkloadConfig>> {
+		using Config = ContentionConfig<ContentionStrategy::Backoff>;
+	};
+
+	//! @brief Thread-local contention manager.
+	//! It keeps a short abort history of the thread, decides how long to back off after an abort
+	//! and whether the aborted transaction should be put behind fresh ones.
+	//! @tparam Transaction Type of transaction to defer
+	//! @tparam Config Contention configuration
+	template<class Transaction, class Config>
+	class ContentionManager {
+	public:
+		using TransactionType = Transaction;
+
+		using ConfigType      = Config;
+
+		/// Length of abort history (bits of history_)
+		static constexpr uint32_t HISTORY_LENGTH   = 64;
+
+		/// Exponent limit to avoid overflow of backoff window
+		static constexpr uint32_t MAX_EXPONENT     = 20;
+
+	private:
+		struct DeferredTransaction {
+			TransactionType transaction;
+			/// Intended start time(cycle) of the first attempt, 0 in closed-loop mode
+			uint64_t intended_start;
+		};
+
+	private:
+		/// Recent results of attempts, where bit 1 indicates an abort
+		uint64_t history_;
+		/// The number of consecutive aborts of current transaction
+		uint32_t consecutive_abort_;
+		/// The number of fresh transactions since the last deferred one is picked up
+		uint32_t fresh_since_defer_;
+
+		std::deque<DeferredTransaction> defer_queue_;
+
+	public:
+		ContentionManager(): history_(0), consecutive_abort_(0), fresh_since_defer_(0) {}
+
+	public:
+		//! @brief Record a successful commit.
+		void on_commit() {
+			history_ <<= 1;
+			consecutive_abort_ = 0;
+		}
+
+		//! @brief Record an abort.
+		void on_abort() {
+			history_ = (history_ << 1) | 1;
+			++consecutive_abort_;
+		}
+
+		//! @brief Get the number of aborts in recent history.
+		uint32_t get_recent_abort_num() const {
+			return std::popcount(history_);
+		}
+
+		/*!
+		 * @brief Spin for a random period after an abort. The window grows exponentially with consecutive aborts,
+		 * and one more step when more than half of recent attempts aborted.
+		 * @return Time spent on backoff in nanoseconds
+		 */
+		uint64_t backoff() {
+			if constexpr (!ConfigType::ENABLE_BACKOFF) {
+				return 0;
+			}
+			else {
+				uint32_t exponent = consecutive_abort_ - 1;
+				if (get_recent_abort_num() > HISTORY_LENGTH / 2) { ++exponent; }
+				exponent = std::min(exponent, MAX_EXPONENT);
+
+				const uint64_t window = std::min(ConfigType::MIN_BACKOFF_NS << exponent, ConfigType::MAX_BACKOFF_NS);
+				const uint64_t delay  = util::rander.rand_range<uint64_t>(window / 2, window);
+
+				util::TraceScope trace_scope("backoff");
+
+				const auto start_time = std::chrono::steady_clock::now();
+				const auto deadline   = start_time + std::chrono::nanoseconds(delay);
+				auto cur_time = start_time;
+				while (cur_time < deadline) {
+					thread::pause();
+					cur_time = std::chrono::steady_clock::now();
+				}
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(cur_time - start_time).count();
+			}
+		}
+
+		//! @brief Whether the current transaction should be deferred instead of retried.
+		bool should_defer() const {
+			if constexpr (!ConfigType::ENABLE_DEFER) {
+				return false;
+			}
+			else {
+				return consecutive_abort_ >= ConfigType::DEFER_ABORT_THRESHOLD
+				       && defer_queue_.size() < ConfigType::DEFER_QUEUE_SIZE;
+			}
+		}
+
+		//! @brief Get the number of transactions waiting in the defer queue.
+		uint32_t get_defer_num() const {
+			return defer_queue_.size();
+		}
+
+		/*!
+		 * @brief Put transaction behind fresh ones.
+		 * @param intended_start Intended start time(cycle) of its first attempt, kept for latency measurement
+		 */
+		void defer(TransactionType &&transaction, uint64_t intended_start) {
+			defer_queue_.emplace_back(DeferredTransaction{std::move(transaction), intended_start});
+			consecutive_abort_ = 0;
+		}
+
+		//! @brief Record the current transaction handed over to another worker instead of retried.
+		void on_hand_off() {
+			consecutive_abort_ = 0;
+		}
+
+		//! @brief Whether the next transaction is a deferred one, which takes no new arrival in open-loop mode.
+		bool is_deferred_next() const {
+			if constexpr (!ConfigType::ENABLE_DEFER) {
+				return false;
+			}
+			else {
+				return !defer_queue_.empty() && fresh_since_defer_ >= ConfigType::DEFER_FRESH_INTERVAL;
+			}
+		}
+
+		/*!
+		 * @brief Get next transaction to execute, which is either a deferred one or a fresh one from generator.
+		 * @param generate_func Function generating fresh transaction
+		 * @param intended_start Intended start time(cycle) of a fresh one,
+		 * which is replaced by that of the first attempt for a deferred one
+		 * @return Transaction to execute
+		 */
+		template<class Func>
+		TransactionType next_transaction(Func &&generate_func, uint64_t &intended_start) {
+			if constexpr (ConfigType::ENABLE_DEFER) {
+				if (is_deferred_next()) {
+					DeferredTransaction deferred{std::move(defer_queue_.front())};
+					defer_queue_.pop_front();
+					fresh_since_defer_ = 0;
+					intended_start = deferred.intended_start;
+					return std::move(deferred.transaction);
+				}
+				++fresh_since_defer_;
+			}
+			return generate_func();
+		}
+	};
+
+}
@@ -0,0 +1,713 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <optional>
+#include <algorithm>
+#include <unordered_map>
+#include <tbb/concurrent_queue.h>
+#include <spdlog/spdlog.h>
+
+#include <util/simple_hash.h>
+#include <util/random_generator.h>
+#include <thread/epoch_manager.h>
+#include <workload/abstract_workload.h>
+#include <thread_allocator/thread_allocator.h>
+#include <transaction_manager/abstract_transaction_manager.h>
+
+namespace transaction {
+
+	namespace deterministic {
+
+		//! @brief Access to a data tuple recorded by reconnaissance
+		struct KeyAccess {
+			uint32_t type;
+
+			uint64_t main_key;
+
+			bool     is_write;
+
+			friend bool operator< (const KeyAccess &a, const KeyAccess &b) {
+				return a.type < b.type || (a.type == b.type && a.main_key < b.main_key);
+			}
+		};
+
+		//! @brief Key of lock queue
+		struct LockKey {
+			uint32_t type;
+
+			uint64_t main_key;
+
+			friend bool operator== (const LockKey &a, const LockKey &b) = default;
+		};
+
+		struct LockKeyHash {
+			size_t operator() (const LockKey &key) const {
+				return util::fnvhash(key.main_key ^ (static_cast<uint64_t>(key.type) << 48));
+			}
+		};
+
+		//! @brief Lock queue of a data tuple in the current batch.
+		struct LockQueue {
+			static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+			/// The last transaction writing the tuple
+			uint32_t last_writer = INVALID_INDEX;
+			/// Transactions reading the tuple after the last writer
+			std::vector<uint32_t> reader_list;
+		};
+
+		//! @brief A transaction in the batch
+		template<class Transaction>
+		struct BatchSlot {
+			using RandomEngine = std::remove_cvref_t<decltype(util::rander.get_engine())>;
+
+			/// Transaction to execute, generated when the batch is filled
+			std::optional<Transaction> tx;
+			/// Snapshot of random engine before reconnaissance, which makes non-reentrant transactions replayable
+			RandomEngine engine;
+			/// Sorted tuples accessed in reconnaissance
+			std::vector<KeyAccess> access_set;
+			/// Transactions waiting for this one
+			std::vector<uint32_t> successor_list;
+			/// The number of transactions to wait for
+			std::atomic<uint32_t> pending{0};
+			/// Whether the transaction failed and has to be restarted in the next batch
+			bool restart = false;
+
+		public:
+			//! @brief Sort access set and merge accesses to the same tuple
+			void normalize() {
+				std::sort(access_set.begin(), access_set.end());
+				auto dst = access_set.begin();
+				for (auto src = access_set.begin(); src != access_set.end(); ++src) {
+					if (dst != access_set.begin() && !(*(dst - 1) < *src)) {
+						(dst - 1)->is_write |= src->is_write;
+					}
+					else {
+						*dst++ = *src;
+					}
+				}
+				access_set.erase(dst, access_set.end());
+			}
+
+			bool contains(uint32_t type, uint64_t main_key, bool is_write) const {
+				const KeyAccess target{type, main_key, is_write};
+				auto iter = std::lower_bound(access_set.begin(), access_set.end(), target);
+				return iter != access_set.end() && !(target < *iter) && (!is_write || iter->is_write);
+			}
+		};
+
+		/*!
+		 * @brief Executor getting the access set of transaction without concurrency control.
+		 * Writes are kept in local buffers, while reads peek at data committed by former batches,
+		 * which is stable as no transaction commits during reconnaissance.
+		 */
+		template<class CC, class Slot, class AbKey>
+		class ReconnaissanceExecutor {
+		public:
+			using CCType    = CC;
+
+			using AbKeyType = AbKey;
+
+		private:
+			//! @brief Tuple written by the transaction
+			struct LocalTuple {
+				AbKeyType key;
+
+				uint32_t size;
+
+				std::unique_ptr<uint8_t[]> data;
+			};
+
+			CCType &cc_;
+
+			Slot &slot_;
+
+			std::vector<LocalTuple> local_tuple_list_;
+
+			/// Keep tuples peeked at from being freed by migration
+			thread::EpochGuard epoch_guard_;
+
+		public:
+			ReconnaissanceExecutor(CCType &cc, Slot &slot): cc_(cc), slot_(slot) {
+				epoch_guard_.enter();
+			}
+
+		public:
+			template<class Data>
+				requires workload::FineGranularityExecutorConcept<typename CC::ExecutorType, AbKey>
+			const Data *read(const AbKeyType &key) {
+				record(key, false);
+				uint32_t payload_size;
+				return static_cast<const Data *>(peek(key, payload_size));
+			}
+
+			bool read(const AbKeyType &key, void *output_ptr, size_t size, size_t offset) {
+				record(key, false);
+				uint32_t payload_size;
+				const auto *data_ptr = static_cast<const uint8_t *>(peek(key, payload_size));
+				if (data_ptr == nullptr) { return false; }
+				if (offset < payload_size) {
+					std::memcpy(output_ptr, data_ptr + offset, std::min<size_t>(size, payload_size - offset));
+				}
+				return true;
+			}
+
+			template<class Data>
+				requires workload::FineGranularityExecutorConcept<typename CC::ExecutorType, AbKey>
+			Data *update(const AbKeyType &key) {
+				record(key, true);
+				return reinterpret_cast<Data *>(local_copy(key, 0));
+			}
+
+			template<class Data>
+				requires workload::FineGranularityExecutorConcept<typename CC::ExecutorType, AbKey>
+			Data *update(const AbKeyType &key, uint32_t size, uint32_t offset) {
+				record(key, true);
+				return reinterpret_cast<Data *>(local_copy(key, size + offset));
+			}
+
+			bool update(const AbKeyType &key, const void *row_ptr, uint32_t size, uint32_t offset) {
+				record(key, true);
+				uint8_t *data_ptr = local_copy(key, size + offset);
+				if (data_ptr == nullptr) { return false; }
+				std::memcpy(data_ptr + offset, static_cast<const uint8_t *>(row_ptr) + offset, size);
+				return true;
+			}
+
+			bool insert(const AbKeyType &key, const void *row, uint32_t size) {
+				record(key, true);
+				uint32_t payload_size;
+				if (peek(key, payload_size) != nullptr) { return false; }
+				LocalTuple &tuple = local_tuple_list_.emplace_back(LocalTuple{key, size, std::make_unique<uint8_t[]>(size)});
+				std::memcpy(tuple.data.get(), row, size);
+				return true;
+			}
+
+			bool remove(const AbKeyType &key) {
+				record(key, true);
+				uint32_t payload_size;
+				return peek(key, payload_size) != nullptr;
+			}
+
+		private:
+			void record(const AbKeyType &key, bool is_write) {
+				slot_.access_set.emplace_back(KeyAccess{
+					.type     = static_cast<uint32_t>(key.get_type_ino()),
+					.main_key = static_cast<uint64_t>(key.get_main_key()),
+					.is_write = is_write
+				});
+			}
+
+			LocalTuple *find_local(const AbKeyType &key) {
+				for (LocalTuple &tuple: local_tuple_list_) {
+					if (tuple.key == key) { return &tuple; }
+				}
+				return nullptr;
+			}
+
+			//! @brief Get the latest data of a tuple, written by the transaction itself or committed.
+			const void *peek(const AbKeyType &key, uint32_t &payload_size) {
+				if (LocalTuple *tuple_ptr = find_local(key); tuple_ptr != nullptr) {
+					payload_size = tuple_ptr->size;
+					return tuple_ptr->data.get();
+				}
+				return cc_.peek(key, payload_size);
+			}
+
+			//! @brief Get local copy of a tuple to write, which holds no less than min_size bytes.
+			uint8_t *local_copy(const AbKeyType &key, uint32_t min_size) {
+				LocalTuple *tuple_ptr = find_local(key);
+				if (tuple_ptr == nullptr) {
+					uint32_t payload_size;
+					const void *data_ptr = cc_.peek(key, payload_size);
+					if (data_ptr == nullptr) { return nullptr; }
+					tuple_ptr = &local_tuple_list_.emplace_back(
+							LocalTuple{key, payload_size, std::make_unique<uint8_t[]>(payload_size)}
+					);
+					std::memcpy(tuple_ptr->data.get(), data_ptr, payload_size);
+				}
+				// Variable-length payload may grow
+				if (tuple_ptr->size < min_size) {
+					auto new_data = std::make_unique<uint8_t[]>(min_size);
+					std::memcpy(new_data.get(), tuple_ptr->data.get(), tuple_ptr->size);
+					tuple_ptr->data = std::move(new_data);
+					tuple_ptr->size = min_size;
+				}
+				return tuple_ptr->data.get();
+			}
+		};
+
+		/*!
+		 * @brief Wrapper of executor, which confines execution to the access set got by reconnaissance.
+		 * @note Keys of insertion are derived from tuples locked already (e.g. order id from district),
+		 * thus they are never refused.
+		 */
+		template<class Executor, class Slot, class AbKey>
+		class DeterministicExecutor {
+		public:
+			using ExecutorType = Executor;
+
+			using AbKeyType    = AbKey;
+
+		private:
+			ExecutorType &executor_;
+
+			const Slot &slot_;
+
+			/// Whether the transaction accessed tuples out of its access set
+			bool escaped_;
+
+		public:
+			DeterministicExecutor(ExecutorType &executor, const Slot &slot):
+					executor_(executor), slot_(slot), escaped_(false) {}
+
+		public:
+			template<class Data>
+				requires workload::FineGranularityExecutorConcept<Executor, AbKey>
+			const Data *read(const AbKeyType &key) {
+				if (!admit(key, false)) { return nullptr; }
+				return executor_.template read<Data>(key);
+			}
+
+			bool read(const AbKeyType &key, void *output_ptr, size_t size, size_t offset) {
+				if (!admit(key, false)) { return false; }
+				return executor_.read(key, output_ptr, size, offset);
+			}
+
+			template<class Data>
+				requires workload::FineGranularityExecutorConcept<Executor, AbKey>
+			Data *update(const AbKeyType &key) {
+				if (!admit(key, true)) { return nullptr; }
+				return executor_.template update<Data>(key);
+			}
+
+			template<class Data>
+				requires workload::FineGranularityExecutorConcept<Executor, AbKey>
+			Data *update(const AbKeyType &key, uint32_t size, uint32_t offset) {
+				if (!admit(key, true)) { return nullptr; }
+				return executor_.template update<Data>(key, size, offset);
+			}
+
+			bool update(const AbKeyType &key, const void *row_ptr, uint32_t size, uint32_t offset) {
+				if (!admit(key, true)) { return false; }
+				return executor_.update(key, row_ptr, size, offset);
+			}
+
+			bool insert(const AbKeyType &key, const void *row, uint32_t size) {
+				return executor_.insert(key, row, size);
+			}
+
+			bool remove(const AbKeyType &key) {
+				if (!admit(key, true)) { return false; }
+				return executor_.remove(key);
+			}
+
+		public:
+			bool is_escaped() const { return escaped_; }
+
+		private:
+			bool admit(const AbKeyType &key, bool is_write) {
+				if (slot_.contains(static_cast<uint32_t>(key.get_type_ino()), static_cast<uint64_t>(key.get_main_key()), is_write)) {
+					return true;
+				}
+				escaped_ = true;
+				return false;
+			}
+		};
+
+	}
+
+	/*!
+	 * @brief Transaction manager executing transactions in deterministic batches (Calvin-like).
+	 * Each batch goes through three steps:
+	 * 1. Every worker generates transactions for its part of batch, and reconnoiters them against
+	 * committed data to get their access sets, without involving concurrency control.
+	 * 2. The sequencer(the completion of barrier) builds per-tuple lock queues in the order of batch,
+	 * which turns into a dependency graph among transactions.
+	 * 3. Workers execute transactions whose predecessors have finished by scheduled executors,
+	 * which skip validation, and persist their works as a group.
+	 *
+	 * Transactions of TPCC and SmallBank draw parameters during execution, so the random engine is snapshot
+	 * before reconnaissance and restored before execution. Access set relying on data (e.g. delivery) may
+	 * still change, in which case the transaction is refused and restarted in the next batch (like OLLP).
+	 * Execution never aborts otherwise, except for tuples moved by a migrator of storage.
+	 */
+	template<class Workload, class CC>
+			requires workload::WorkloadConcept<Workload>
+			        && DeterministicConcurrentControlConcept<CC>
+	class DeterministicStdTransactionManager {
+	public:
+		using Self               = DeterministicStdTransactionManager<Workload, CC>;
+
+		using ThreadAllocator    = allocator::StdThreadAllocator;
+
+		using WorkloadType       = Workload;
+
+		using TransactionType    = WorkloadType::Transaction;
+
+		using AbKeyType          = WorkloadType::AbKeyType;
+
+		using CCType             = CC;
+
+		using ExecutorType       = CC::ExecutorType;
+
+		using SlotType           = deterministic::BatchSlot<TransactionType>;
+
+		using DetExecutorType    = deterministic::DeterministicExecutor<ExecutorType, SlotType, AbKeyType>;
+
+		using ReconExecutorType  = deterministic::ReconnaissanceExecutor<CCType, SlotType, AbKeyType>;
+
+		using LockTable          = std::unordered_map<deterministic::LockKey, deterministic::LockQueue, deterministic::LockKeyHash>;
+
+		//! @brief Completion of batch barrier, run by the last thread arriving.
+		struct BatchCompletion {
+			Self *manager_ptr;
+
+			void operator() () noexcept { manager_ptr->complete_phase(); }
+		};
+
+		using BatchBarrier       = std::barrier<BatchCompletion>;
+
+		static constexpr uint32_t INIT_THREAD_NUM = std::min(24U, thread::get_max_tid());
+
+		/// The number of transactions contributed by each worker to a batch
+		static constexpr uint32_t BATCH_SIZE_PER_THREAD = 64;
+
+		static constexpr uint32_t DEFAULT_WARN_UP_MILLI_SEC = 3'000;
+
+	private:
+		TransactionManagerInfo info_;
+
+		ThreadAllocator thread_allocator_;
+
+		WorkloadType workload_;
+
+		CCType concurrent_control_;
+
+		// ------ Batch state
+
+		std::unique_ptr<SlotType[]> batch_;
+
+		uint32_t batch_size_;
+
+		LockTable lock_table_;
+
+		tbb::concurrent_queue<uint32_t> ready_queue_;
+
+		/// The number of transactions unfinished in current batch
+		std::atomic<uint32_t> remaining_;
+
+		std::unique_ptr<BatchBarrier> batch_barrier_ptr_;
+
+		/// Whether the next barrier completes reconnaissance rather than execution
+		bool sequence_phase_;
+
+		/// Whether workers should exit after current batch
+		bool batch_stop_;
+
+		std::atomic_flag *stop_flag_ptr_;
+
+	public:
+		template<class ...Args>
+		explicit DeterministicStdTransactionManager(ThreadBindStrategy bind_strategy, Args &&...args):
+				info_(), thread_allocator_(bind_strategy),
+				concurrent_control_(std::forward<Args>(args)...),
+				batch_size_(0), remaining_(0),
+				sequence_phase_(true), batch_stop_(false),
+				stop_flag_ptr_(nullptr) {};
+
+		TransactionManagerInfo get_manager_info() const {
+			return info_;
+		}
+
+	public:
+		void init() {
+			// Get new transaction from workload
+			auto init_tx_list = workload_.initialize_insert();
+
+			thread_allocator_.reserve(INIT_THREAD_NUM)
+			                 .run_tasks([this, &init_tx_list](int id) { init_work(id, init_tx_list); })
+			                 .wait_all_tasks()
+			                 .clear_all_tasks();
+		}
+
+		void warm_up(const uint32_t num_thread) {
+			auto run_time = std::chrono::milliseconds{DEFAULT_WARN_UP_MILLI_SEC};
+			std::barrier barrier{num_thread + 1};
+			std::atomic_flag stop_flag{false};
+
+			reset_batch(num_thread, stop_flag);
+			thread_allocator_.reserve(num_thread)
+			                 .run_tasks([&](int id) { exec_work(id, barrier); });
+
+			barrier.arrive_and_wait();
+			auto start_time = std::chrono::steady_clock::now();
+			auto end_time = start_time;
+			while (!stop_flag.test()) {
+				thread::pause();
+				end_time = std::chrono::steady_clock::now();
+				if (end_time - start_time >= run_time) { break; }
+			}
+			stop_flag.test_and_set();
+
+			thread_allocator_.wait_all_tasks();
+		}
+
+		void run(const uint32_t num_thread, const std::chrono::milliseconds run_time) {
+			std::barrier barrier{num_thread + 1};
+			std::atomic_flag stop_flag{false};
+
+			reset_batch(num_thread, stop_flag);
+			thread_allocator_.reserve(num_thread)
+			                 .run_tasks([&](int id) { exec_work(id, barrier); });
+
+			barrier.arrive_and_wait();
+
+			auto start_time = std::chrono::steady_clock::now();
+			auto end_time = start_time;
+			while (!stop_flag.test()) {
+				thread::pause();
+				end_time = std::chrono::steady_clock::now();
+				if (end_time - start_time >= run_time) { break; }
+			}
+			stop_flag.test_and_set();
+
+			thread_allocator_.clear_all_tasks();
+
+			info_ = TransactionManagerInfo(std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time), num_thread, num_thread,
+			                               concurrent_control_.get_concurrent_control_message());
+		}
+
+	private:
+		void init_work(int id, auto &init_tx_list) {
+			auto  handle = inner_init_work(id, init_tx_list).handle;
+			auto &handle_promise = handle.promise();
+
+			// Start execute function
+			while (!handle.done()) {
+				handle();
+				// Get task error code and deal with it
+				TaskError &error = handle_promise.task_error;
+				running_task_error_handler(error);
+				error = TaskError::None;
+			}
+
+			// Get final error code and deal with it
+			TaskError &final_error = handle_promise.task_error;
+			final_task_error_handler(final_error);
+			final_error = TaskError::None;
+		}
+
+		void exec_work(int id, std::barrier<> &barrier) {
+			barrier.arrive_and_wait();
+
+			auto  handle = inner_exec_work(id).handle;
+			auto &handle_promise = handle.promise();
+
+			// Workers are synchronized by batch barrier, so they can only stop at the end of a batch.
+			while (!handle.done()) {
+				handle();
+				// Get task error code and deal with it
+				TaskError &error = handle_promise.task_error;
+				running_task_error_handler(error);
+				error = TaskError::None;
+			}
+
+			// Get final error code and deal with it
+			TaskError &final_error = handle_promise.task_error;
+			final_task_error_handler(final_error);
+			final_error = TaskError::None;
+		}
+
+	private:
+		ThreadTaskReturnObject inner_init_work(int id, auto &init_tx_list) {
+			for (uint64_t i = id; i < init_tx_list.size(); i += INIT_THREAD_NUM) {
+				// Get new transaction from workload
+				auto transaction = init_tx_list[i];
+				// Get new context for tx execution
+				auto executor = concurrent_control_.get_executor();
+				// Run transaction.
+				while (true) {
+					if (transaction.run(executor) && executor.commit()) { break; }
+
+					co_yield TaskError::AssertFault;
+
+					executor.abort();
+					executor.reset();
+				}
+				// Expect not to suspend after a init transaction
+				co_await std::suspend_never{};
+			}
+			// Finish all uncompleted works.
+			concurrent_control_.flush_all_works();
+			// Exit
+			co_return TaskError::None;
+		}
+
+		ThreadTaskReturnObject inner_exec_work(int id) {
+			auto &thread_message = cc::ConcurrentControlMessage::get_thread_message();
+			auto &random_engine  = util::rander.get_engine();
+
+			SlotType *segment = batch_.get() + id * BATCH_SIZE_PER_THREAD;
+
+			while (true) {
+				// 1. Fill own segment of batch and reconnoiter transactions.
+				for (uint32_t i = 0; i < BATCH_SIZE_PER_THREAD; ++i) {
+					SlotType &slot = segment[i];
+					// Transactions failed in the last batch go first
+					if (!slot.restart) {
+						slot.tx.emplace(workload_.generate_transaction());
+					}
+					slot.restart = false;
+					slot.access_set.clear();
+					slot.engine  = random_engine;
+					{
+						ReconExecutorType recon_executor{concurrent_control_, slot};
+						slot.tx->run(recon_executor);
+					}
+					slot.normalize();
+				}
+
+				// 2. The sequencer builds dependency graph in the completion of barrier.
+				batch_barrier_ptr_->arrive_and_wait();
+
+				// 3. Execute transactions whose predecessors have finished.
+				while (remaining_.load(std::memory_order::acquire) != 0) {
+					uint32_t index;
+					if (!ready_queue_.try_pop(index)) {
+						thread::pause();
+						continue;
+					}
+					SlotType &slot = batch_[index];
+					TransactionType &transaction = *slot.tx;
+					// Replay the random engine of reconnaissance, and give back our own one afterwards.
+					const auto own_engine = random_engine;
+					random_engine = slot.engine;
+					thread_message.set_transaction_type(transaction.get_type_tag());
+					{
+						// Lock queues have excluded conflicts, so the transaction runs only once in this batch.
+						auto executor = concurrent_control_.get_scheduled_executor();
+						DetExecutorType det_executor{executor, slot};
+						const bool run_success = transaction.run(det_executor);
+						if (!(run_success && executor.commit())) {
+							if (det_executor.is_escaped()) {
+								thread_message.set_abort_reason(cc::AbortReason::AccessSetChanged);
+							}
+							else if (!run_success) {
+								thread_message.set_default_abort_reason(cc::AbortReason::Execution);
+							}
+							// Suspend and return error after abort a transaction.
+							co_yield TaskError::Retry;
+							// Abort the transaction.
+							executor.abort();
+							// Restart in the next batch with a new access set.
+							slot.restart = true;
+							thread_message.retry_transaction(0, 0, true);
+						}
+					}
+					random_engine = own_engine;
+					// Wake up successors
+					for (uint32_t successor: slot.successor_list) {
+						if (batch_[successor].pending.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+							ready_queue_.push(successor);
+						}
+					}
+					remaining_.fetch_sub(1, std::memory_order::release);
+					// Suspend after finishing a transaction
+					co_await std::suspend_always{};
+				}
+				// Persist works of the whole batch together
+				concurrent_control_.flush_all_works();
+
+				batch_barrier_ptr_->arrive_and_wait();
+				if (batch_stop_) { break; }
+			}
+
+			co_return TaskError::None;
+		}
+
+	private:
+		void reset_batch(uint32_t num_thread, std::atomic_flag &stop_flag) {
+			batch_size_        = num_thread * BATCH_SIZE_PER_THREAD;
+			batch_             = std::make_unique<SlotType[]>(batch_size_);
+			batch_barrier_ptr_ = std::make_unique<BatchBarrier>(num_thread, BatchCompletion{this});
+			stop_flag_ptr_     = &stop_flag;
+			sequence_phase_    = true;
+			batch_stop_        = false;
+			lock_table_.clear();
+		}
+
+		void complete_phase() {
+			if (sequence_phase_) {
+				sequence_batch();
+			}
+			else {
+				batch_stop_ = stop_flag_ptr_->test();
+			}
+			sequence_phase_ = !sequence_phase_;
+		}
+
+		//! @brief Build lock queues in the order of batch, and push transactions without predecessor into ready queue.
+		void sequence_batch() {
+			for (uint32_t i = 0; i < batch_size_; ++i) {
+				batch_[i].successor_list.clear();
+				batch_[i].pending.store(0, std::memory_order::relaxed);
+			}
+
+			auto add_dependency = [this](uint32_t from, uint32_t to) {
+				batch_[from].successor_list.push_back(to);
+				batch_[to].pending.fetch_add(1, std::memory_order::relaxed);
+			};
+
+			lock_table_.clear();
+			for (uint32_t i = 0; i < batch_size_; ++i) {
+				SlotType &slot = batch_[i];
+				for (const deterministic::KeyAccess &access: slot.access_set) {
+					deterministic::LockQueue &queue = lock_table_[{access.type, access.main_key}];
+					if (access.is_write) {
+						if (!queue.reader_list.empty()) {
+							for (uint32_t reader: queue.reader_list) { add_dependency(reader, i); }
+							queue.reader_list.clear();
+						}
+						else if (queue.last_writer != deterministic::LockQueue::INVALID_INDEX) {
+							add_dependency(queue.last_writer, i);
+						}
+						queue.last_writer = i;
+					}
+					else {
+						if (queue.last_writer != deterministic::LockQueue::INVALID_INDEX) {
+							add_dependency(queue.last_writer, i);
+						}
+						queue.reader_list.push_back(i);
+					}
+				}
+			}
+
+			remaining_.store(batch_size_, std::memory_order::relaxed);
+			for (uint32_t i = 0; i < batch_size_; ++i) {
+				if (batch_[i].pending.load(std::memory_order::relaxed) == 0) {
+					ready_queue_.push(i);
+				}
+			}
+		}
+
+	private:
+		//! @brief Error handler during running
+		static void running_task_error_handler(const TaskError &error) {
+			if (error != TaskError::None && error != TaskError::Retry) {
+				spdlog::error("Error unexpected: {}", static_cast<uint32_t>(error));
+			}
+		};
+
+		//! @brief Error handler after everything
+		static void final_task_error_handler(const TaskError &error) {
+			if (error != TaskError::None) {
+				spdlog::error("Error unexpected: {}", static_cast<uint32_t>(error));
+			}
+		};
+	};
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+#include <util/random_generator.h>
+#include <util/tsc_clock.h>
+
+namespace transaction {
+
+	//! @brief Process of transaction arrival in open-loop mode.
+	enum class ArrivalProcess {
+		/// Arrive at a fixed interval
+		Constant,
+		/// Arrive with exponentially distributed intervals
+		Poisson
+	};
+
+	//! @brief Arrival process adopted when an offered load is set.
+	inline constexpr ArrivalProcess ARRIVAL_PROCESS = ArrivalProcess::Poisson;
+
+	/*!
+	 * @brief Schedule of intended start time of transactions for a worker in open-loop mode.
+	 * The offered load is split evenly among workers. Since superposition of Poisson processes is still
+	 * a Poisson process, the global arrival follows the same process as each worker.
+	 * Intended start time advances regardless of completion, so that latency measured from it includes
+	 * queueing delay and is free from coordinated omission.
+	 */
+	class ArrivalScheduler {
+	private:
+		/// Mean interval between arrivals(cycle), 0 for closed-loop mode
+		double mean_interval_;
+
+		/// Intended start time of next arrival(cycle)
+		uint64_t next_arrival_;
+
+	public:
+		/*!
+		 * @param offered_load Offered load(txn/s) of all workers, 0 for closed-loop mode
+		 * @param thread_num The number of workers sharing the load
+		 */
+		ArrivalScheduler(double offered_load, uint32_t thread_num):
+				mean_interval_(offered_load <= 0.0 ? 0.0 : 1e9 * thread_num / offered_load / util::TSCClock::get_ns_per_cycle()),
+				next_arrival_(0) {}
+
+	public:
+		bool is_open_loop() const {
+			return mean_interval_ != 0.0;
+		}
+
+		//! @brief Start the schedule from now, with a random phase so that workers do not arrive in step.
+		void start() {
+			next_arrival_ = util::TSCClock::now()
+			                + static_cast<uint64_t>(mean_interval_ * util::rander.rand_double());
+		}
+
+		//! @brief Whether the next arrival is due.
+		bool is_due() const {
+			return util::TSCClock::now() >= next_arrival_;
+		}
+
+		//! @brief Take the next arrival, which should be due.
+		//! @return Intended start time(cycle)
+		uint64_t take_arrival() {
+			const uint64_t intended_start = next_arrival_;
+			next_arrival_ += get_next_interval();
+			return intended_start;
+		}
+
+	private:
+		uint64_t get_next_interval() {
+			if constexpr (ARRIVAL_PROCESS == ArrivalProcess::Poisson) {
+				std::exponential_distribution<double> interval_dis(1.0 / mean_interval_);
+				return static_cast<uint64_t>(interval_dis(util::rander.get_engine()));
+			}
+			else {
+				return static_cast<uint64_t>(mean_interval_);
+			}
+		}
+	};
+
+}
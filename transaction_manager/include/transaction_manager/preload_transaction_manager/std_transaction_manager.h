@@ -189,12 +189,18 @@ namespace transaction {
 		}
 
 		ThreadTaskReturnObject inner_exec_work(std::vector<TransactionType> &preload_transaction_vector) {
+			auto &thread_message = cc::ConcurrentControlMessage::get_thread_message();
 			for (TransactionType &transaction: preload_transaction_vector) {
+				thread_message.set_transaction_type(transaction.get_type_tag());
 				// Get new context for tx execution
 				auto executor = concurrent_control_.get_executor();
 				// Run transaction.
 				while (true) {
-					if (transaction.run(executor) && executor.commit()) { break; }
+					const bool run_success = transaction.run(executor);
+					if (run_success && executor.commit()) { break; }
+					if (!run_success) {
+						thread_message.set_default_abort_reason(cc::AbortReason::Execution);
+					}
 					// Suspend and return error after abort a transaction.
 					co_yield TaskError::Retry;
 					// Abort the transaction and retry.
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <tbb/concurrent_queue.h>
+
+#include <concurrent_control/conflict_tracker.h>
+#include <transaction_manager/simple_transaction_manager/std_transaction_manager.h>
+
+namespace transaction {
+
+	/*!
+	 * @brief Router of transactions by conflicting keys.
+	 * Once a transaction aborts on a key that is hot for the current worker, it is forwarded
+	 * to the worker owning that key. Transactions colliding on the same hot key are thus executed
+	 * serially by a single worker instead of aborting each other across cores.
+	 * Forwarded transactions are carried by slots preallocated for each worker, so that routing
+	 * never allocates. A worker running out of slots leaves the transaction to its contention manager.
+	 * @tparam Transaction Type of transaction to forward
+	 */
+	template<class Transaction>
+	class ConflictRouter {
+	public:
+		using TransactionType    = Transaction;
+
+		//! @brief Carrier of a forwarded transaction, returned to its origin worker once taken.
+		struct RouteSlot {
+			std::optional<TransactionType> transaction;
+			/// Intended start time(cycle) of the first attempt, 0 in closed-loop mode
+			uint64_t intended_start;
+			/// The worker owning this slot
+			uint32_t origin;
+		};
+
+		using RouteQueue         = tbb::concurrent_queue<RouteSlot *>;
+
+		/// The number of slots for forwarding owned by each worker
+		static constexpr uint32_t ROUTE_SLOT_NUM = 64;
+
+	private:
+		/// Inbound queues of routed transactions, one per worker
+		std::unique_ptr<RouteQueue[]> route_queue_array_;
+		/// Free slots of each worker
+		std::unique_ptr<RouteQueue[]> free_slot_queue_array_;
+
+		std::unique_ptr<RouteSlot[]> route_slot_array_;
+
+		uint32_t route_queue_num_;
+
+	public:
+		ConflictRouter(): route_queue_num_(0) {}
+
+	public:
+		//! @brief Drop transactions left in queues, and preallocate slots for workers.
+		void reset(uint32_t num_thread) {
+			route_queue_array_      = std::make_unique<RouteQueue[]>(num_thread);
+			free_slot_queue_array_  = std::make_unique<RouteQueue[]>(num_thread);
+			route_slot_array_       = std::make_unique<RouteSlot[]>(num_thread * ROUTE_SLOT_NUM);
+			route_queue_num_        = num_thread;
+			for (uint32_t i = 0; i < num_thread * ROUTE_SLOT_NUM; ++i) {
+				RouteSlot &slot = route_slot_array_[i];
+				slot.origin = i / ROUTE_SLOT_NUM;
+				free_slot_queue_array_[slot.origin].push(&slot);
+			}
+		}
+
+		/*!
+		 * @brief Take a transaction routed to the worker, and give its slot back to the origin.
+		 * @param intended_start Replaced by the intended start time of the routed transaction
+		 * @return Routed transaction, or nothing if none is waiting
+		 */
+		std::optional<TransactionType> receive(uint32_t id, uint64_t &intended_start) {
+			RouteSlot *slot_ptr = nullptr;
+			if (!route_queue_array_[id].try_pop(slot_ptr)) { return std::nullopt; }
+
+			std::optional<TransactionType> transaction{std::move(slot_ptr->transaction)};
+			slot_ptr->transaction.reset();
+			intended_start = slot_ptr->intended_start;
+			free_slot_queue_array_[slot_ptr->origin].push(slot_ptr);
+			return transaction;
+		}
+
+		//! @brief Forget the conflict of the last attempt, which should be called before each attempt.
+		void clear_last_conflict() {
+			cc::ConflictTracker::get_thread_tracker().clear_last_conflict();
+		}
+
+		/*!
+		 * @brief Forward an aborted transaction to the owner of the hot key it conflicted on.
+		 * @param intended_start Intended start time(cycle) of its first attempt, kept for latency measurement
+		 * @return Whether the transaction is moved into the queue of another worker
+		 */
+		bool forward(uint32_t id, TransactionType &transaction, uint64_t intended_start) {
+			auto &conflict_tracker = cc::ConflictTracker::get_thread_tracker();
+			if (!conflict_tracker.is_last_conflict_hot()) { return false; }
+
+			// High bits of FNV hash are better mixed than low ones
+			const uint32_t owner = (conflict_tracker.get_last_conflict().hash >> 32) % route_queue_num_;
+			RouteSlot *slot_ptr = nullptr;
+			if (owner == id || !free_slot_queue_array_[id].try_pop(slot_ptr)) { return false; }
+
+			slot_ptr->transaction.emplace(std::move(transaction));
+			slot_ptr->intended_start = intended_start;
+			route_queue_array_[owner].push(slot_ptr);
+			return true;
+		}
+
+		//! @brief Count transactions left in inbound queues, which should be called when no worker is running.
+		uint64_t get_unfinished_num() const {
+			uint64_t unfinished_num = 0;
+			for (uint32_t i = 0; i < route_queue_num_; ++i) {
+				unfinished_num += route_queue_array_[i].unsafe_size();
+			}
+			return unfinished_num;
+		}
+	};
+
+	//! @brief Transaction manager routing transactions by conflicting keys, sharing the worker loop of StdTransactionManager.
+	template<class Workload, class CC>
+	using RouteStdTransactionManager = StdTransactionManager<Workload, CC, ConflictRouter<typename Workload::Transaction>>;
+
+}
@@ -5,20 +5,31 @@
 
 #pragma once
 
+#include <optional>
+#include <variant>
+#include <type_traits>
 #include <spdlog/spdlog.h>
 
 #include <workload/abstract_workload.h>
 #include <thread_allocator/thread_allocator.h>
 #include <transaction_manager/abstract_transaction_manager.h>
+#include <transaction_manager/contention_manager.h>
+#include <transaction_manager/time_series.h>
+#include <transaction_manager/load_generator.h>
+#include <recovery/abstract_recovery.h>
 
 namespace transaction {
 
-	template<class Workload, class CC>
+	/*!
+	 * @brief Transaction manager running fresh transactions on each worker, with contention management.
+	 * @tparam Router Router handing aborted transactions over to other workers, or void for none
+	 */
+	template<class Workload, class CC, class Router = void>
 			requires workload::WorkloadConcept<Workload>
 			        && ConcurrentControlConcept<CC>
 	class StdTransactionManager {
 	public:
-		using Self               = StdTransactionManager<Workload, CC>;
+		using Self               = StdTransactionManager<Workload, CC, Router>;
 
 		using ThreadAllocator    = allocator::StdThreadAllocator;
 
@@ -28,6 +39,16 @@ namespace transaction {
 
 		using ExecutorType       = CC::ExecutorType;
 
+		using TransactionType    = Workload::Transaction;
+
+		using ContentionConfig   = ContentionConfigManager<Workload>::Config;
+
+		using ContentionManagerType = ContentionManager<TransactionType, ContentionConfig>;
+
+		static constexpr bool ENABLE_ROUTE = !std::is_void_v<Router>;
+
+		using RouterType         = std::conditional_t<ENABLE_ROUTE, Router, std::monostate>;
+
 		static constexpr uint32_t INIT_THREAD_NUM = std::min(24U, thread::get_max_tid());
 
 		static constexpr uint32_t DEFAULT_WARN_UP_MILLI_SEC = 3'000;
@@ -41,16 +62,42 @@ namespace transaction {
 
 		CCType concurrent_control_;
 
+		TimeSeriesReporter time_series_;
+
+		/// Offered load(txn/s) of all workers in open-loop mode, 0 for closed-loop mode
+		double offered_load_;
+
+		/// The number of workers running
+		uint32_t running_thread_num_;
+
+		[[no_unique_address]] RouterType router_;
+
 	public:
 		template<class ...Args>
 		explicit StdTransactionManager(ThreadBindStrategy bind_strategy, Args &&...args):
 				info_(), thread_allocator_(bind_strategy),
-				concurrent_control_(std::forward<Args>(args)...) {};
+				concurrent_control_(std::forward<Args>(args)...), time_series_(0),
+				offered_load_(0), running_thread_num_(0) {};
 
 		TransactionManagerInfo get_manager_info() const {
 			return info_;
 		}
 
+		/*!
+		 * @brief Run in open-loop mode with a target arrival rate of all workers.
+		 * Transactions are started at intended time regardless of completion, and latency is measured
+		 * from the intended start.
+		 * @param offered_load Offered load(txn/s), 0 for closed-loop mode
+		 */
+		void set_offered_load(double offered_load) {
+			offered_load_ = offered_load;
+		}
+
+		//! @brief Get throughput and latency sampled during the last run.
+		const TimeSeriesReporter &get_time_series() const {
+			return time_series_;
+		}
+
 	public:
 		void init() {
 //			auto init_tx_list = concurrent_control_.recovery();
@@ -67,11 +114,63 @@ namespace transaction {
 			spdlog::info("Recovery - Replay Time: {} ms", duration.count());
 		}
 
+		/*!
+		 * @brief Recover from persistent memory left by a crashed process, instead of initialization.
+		 * Updates of committed transactions are replayed by a single thread in order of timestamp.
+		 */
+		recovery::RecoveryStatistics recover() {
+			recovery::RecoveryStatistics statistics;
+			if constexpr (requires { concurrent_control_.recovery(); concurrent_control_.get_recovery_statistics(); }) {
+				auto recovery_tx_list = concurrent_control_.recovery();
+
+				auto start_time = std::chrono::steady_clock::now();
+				thread_allocator_.reserve(1)
+				                 .run_tasks([this, &recovery_tx_list](int id) { init_work(id, recovery_tx_list, 1); })
+				                 .wait_all_tasks()
+				                 .clear_all_tasks();
+				auto end_time = std::chrono::steady_clock::now();
+				auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+				spdlog::info("Recovery - Replay Time: {} ms", duration.count());
+
+				statistics = concurrent_control_.get_recovery_statistics();
+				statistics.replay_time       = duration.count();
+				statistics.replay_update_num = recovery_tx_list.size();
+			}
+			else {
+				spdlog::warn("Recovery is not supported by the concurrent control");
+			}
+			return statistics;
+		}
+
+		//! @brief Check invariants of the workload, which should be called when no worker is running.
+		bool check_consistency() {
+			if constexpr (requires (ExecutorType &executor) { workload_.check_consistency(executor); }) {
+				bool consistent = false;
+				thread_allocator_.reserve(1)
+				                 .run_tasks([this, &consistent](int id) {
+					                 auto executor = concurrent_control_.get_executor();
+					                 consistent = workload_.check_consistency(executor);
+					                 executor.commit();
+				                 })
+				                 .wait_all_tasks()
+				                 .clear_all_tasks();
+				return consistent;
+			}
+			else {
+				spdlog::warn("Consistency check is not supported by the workload");
+				return true;
+			}
+		}
+
 		void warm_up(const uint32_t num_thread) {
 			auto run_time = std::chrono::milliseconds{DEFAULT_WARN_UP_MILLI_SEC};
+			running_thread_num_ = num_thread;
 			std::barrier barrier{num_thread + 1};
 			std::atomic_flag stop_flag{false};
 
+			if constexpr (ENABLE_ROUTE) {
+				router_.reset(num_thread);
+			}
 			thread_allocator_.reserve(num_thread)
 							 .run_tasks([&](int id) { exec_work(id, barrier, stop_flag); });
 
@@ -90,17 +189,40 @@ namespace transaction {
 		}
 
 		void run(const uint32_t num_thread, const std::chrono::milliseconds run_time) {
+			running_thread_num_ = num_thread;
 			std::barrier barrier{num_thread + 1};
 			std::atomic_flag stop_flag{false};
 
+			if constexpr (ENABLE_ROUTE) {
+				router_.reset(num_thread);
+			}
 			thread_allocator_.reserve(num_thread)
 							 .run_tasks([&](int id) { exec_work(id, barrier, stop_flag); });
 
+			time_series_ = TimeSeriesReporter(num_thread);
+			time_series_.start();
+
 			barrier.arrive_and_wait();
 			auto start_time = std::chrono::steady_clock::now();
 			auto end_time = start_time;
 
-			{
+			if constexpr (ENABLE_TIME_SERIES) {
+				// Sample progress of workers periodically, and draw the process bar meanwhile
+				std::string process_bar = "[                    ]";
+				auto next_sample_time = start_time + TIME_SERIES_INTERVAL;
+				while (next_sample_time - start_time <= run_time) {
+					std::this_thread::sleep_until(next_sample_time);
+					time_series_.sample();
+					next_sample_time += TIME_SERIES_INTERVAL;
+
+					const auto percent = (std::chrono::steady_clock::now() - start_time) * 20 / run_time;
+					for (int i = 1; i <= std::min<int>(percent, 20); ++i) { process_bar[i] = '='; }
+					std::cout << "\r[" << std::min<int>(percent * 5, 100) << "%]" << process_bar;
+					std::fflush(stdout);
+				}
+				std::cout << '\r';
+			}
+			else {
 				std::string process_bar = "[                    ]";
 				for (int i = 1; i <= 20; ++i) {
 					std::this_thread::sleep_for(run_time / 20);
@@ -121,11 +243,15 @@ namespace transaction {
 
 			info_ = TransactionManagerInfo(std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time), num_thread, num_thread,
 			                               concurrent_control_.get_concurrent_control_message());
+			info_.offered_load_ = offered_load_;
+			if constexpr (ENABLE_ROUTE) {
+				info_.unfinished_route_tx_ = router_.get_unfinished_num();
+			}
 		}
 
 	private:
-		void init_work(int id, auto &init_tx_list) {
-			auto  handle = inner_init_work(id, init_tx_list).handle;
+		void init_work(int id, auto &init_tx_list, uint32_t thread_num = INIT_THREAD_NUM) {
+			auto  handle = inner_init_work(id, init_tx_list, thread_num).handle;
 			auto &handle_promise = handle.promise();
 
 			// Start execute function
@@ -146,7 +272,7 @@ namespace transaction {
 		void exec_work(int id, std::barrier<> &barrier, std::atomic_flag &stop_flag) {
 			barrier.arrive_and_wait();
 
-			auto  handle = inner_exec_work().handle;
+			auto  handle = inner_exec_work(id).handle;
 			auto &handle_promise = handle.promise();
 
 			// Start execute function
@@ -165,8 +291,8 @@ namespace transaction {
 		}
 
 	private:
-		ThreadTaskReturnObject inner_init_work(int id, auto &init_tx_list) {
-			for (uint64_t i = id; i < init_tx_list.size(); i += INIT_THREAD_NUM) {
+		ThreadTaskReturnObject inner_init_work(int id, auto &init_tx_list, uint32_t thread_num) {
+			for (uint64_t i = id; i < init_tx_list.size(); i += thread_num) {
 				// Get new transaction from workload
 				auto &transaction = init_tx_list[i];
 				// Get new context for tx execution
@@ -190,29 +316,117 @@ namespace transaction {
 			co_return TaskError::None;
 		}
 
-		ThreadTaskReturnObject inner_exec_work() {
+		ThreadTaskReturnObject inner_exec_work(int id) {
+			// Thread-local state for contention management
+			ContentionManagerType contention_manager;
+			auto &thread_message = cc::ConcurrentControlMessage::get_thread_message();
+			auto &thread_progress = ThreadProgress::get_thread_progress();
+			ArrivalScheduler arrival_scheduler(offered_load_, running_thread_num_);
+			arrival_scheduler.start();
+
 			while (true) {
+				uint64_t intended_start_cycle = 0;
+				// Transactions routed to this worker go ahead of deferred and fresh ones.
+				std::optional<TransactionType> routed_transaction{receive_routed_transaction(id, intended_start_cycle)};
+				const bool routed = routed_transaction.has_value();
+				// Wait for the next arrival in open-loop mode, suspending so that the worker can be stopped.
+				// A deferred or routed transaction has arrived already and keeps its intended start time.
+				if (arrival_scheduler.is_open_loop() && !routed && !contention_manager.is_deferred_next()) {
+					while (!arrival_scheduler.is_due()) {
+						thread::pause();
+						co_await std::suspend_always{};
+					}
+					intended_start_cycle = arrival_scheduler.take_arrival();
+				}
 //				if (thread::get_cpu_numa_id() != 0) [[unlikely]] {
 //					std::this_thread::sleep_for(std::chrono::microseconds(200));
 //				}
-				// Get new transaction from workload
-				auto transaction{workload_.generate_transaction()};
+				// Get new transaction from workload, or a deferred one
+				auto transaction{routed ? std::move(*routed_transaction) : contention_manager.next_transaction(
+						[this]() { return workload_.generate_transaction(); }, intended_start_cycle)};
+				thread_message.set_transaction_type(transaction.get_type_tag());
+				if constexpr (ContentionManagerType::ConfigType::ENABLE_DEFER) {
+					thread_message.set_deferred_transaction_num(contention_manager.get_defer_num());
+				}
 				// Get new context for tx execution
 				auto executor = concurrent_control_.get_executor();
+				// Time the latency of transactions timed by the message recorder for the time series
+				uint64_t tx_start_cycle = 0;
+				if (ENABLE_TIME_SERIES && cc::ConcurrentControlPortableMessage::is_thread_sampled()) {
+					tx_start_cycle = intended_start_cycle != 0 ? intended_start_cycle : util::TSCClock::now();
+				}
 				// Run transaction.
+				bool handed_off = false;
 				while (true) {
-					if (transaction.run(executor) && executor.commit()) { break; }
+					if constexpr (ENABLE_ROUTE) {
+						router_.clear_last_conflict();
+					}
+					// Time the attempt only when recording, in case it is wasted
+					const uint64_t attempt_start_cycle = cc::ConcurrentControlMessage::is_recording() ? util::TSCClock::now() : 0;
+					const bool run_success = transaction.run(executor);
+					if (run_success && executor.commit()) {
+						contention_manager.on_commit();
+						if (intended_start_cycle != 0) {
+							thread_message.record_response(util::TSCClock::now() - intended_start_cycle);
+						}
+						if constexpr (ENABLE_TIME_SERIES) {
+							thread_progress.commit(tx_start_cycle == 0 ? 0 : util::TSCClock::now() - tx_start_cycle);
+						}
+						break;
+					}
+					if (!run_success) {
+						thread_message.set_default_abort_reason(cc::AbortReason::Execution);
+					}
+					if constexpr (ENABLE_TIME_SERIES) {
+						thread_progress.abort();
+					}
+					const uint64_t wasted_time = attempt_start_cycle == 0 ? 0 : util::TSCClock::to_ns(util::TSCClock::now() - attempt_start_cycle);
 					// Suspend and return error after abort a transaction.
 					co_yield TaskError::Retry;
-					// Abort the transaction and retry.
+					// Abort the transaction.
 					executor.abort();
+					contention_manager.on_abort();
+					// Forward the transaction to the worker owning the key it conflicted on. Routed transactions
+					// are never forwarded again, avoiding ping-pong between workers.
+					if constexpr (ENABLE_ROUTE) {
+						if (!routed && router_.forward(id, transaction, intended_start_cycle)) {
+							thread_message.retry_transaction(wasted_time, 0, false);
+							contention_manager.on_hand_off();
+							handed_off = true;
+							break;
+						}
+					}
+					// Put the transaction behind fresh ones if it keeps failing.
+					if (contention_manager.should_defer()) {
+						thread_message.retry_transaction(wasted_time, 0, true);
+						contention_manager.defer(std::move(transaction), intended_start_cycle);
+						// Count it as unfinished until picked up, in case the worker stops before that
+						thread_message.set_deferred_transaction_num(contention_manager.get_defer_num());
+						handed_off = true;
+						break;
+					}
+					// Back off and retry.
+					uint64_t backoff_time = contention_manager.backoff();
+					thread_message.retry_transaction(wasted_time, backoff_time, false);
 					executor.reset();
 				}
+				// Pick up another transaction at once if the current one is deferred or forwarded.
+				if (handed_off) { continue; }
 				// Suspend after finishing a transaction
 				co_await std::suspend_always{};
 			}
 		}
 
+	private:
+		std::optional<TransactionType> receive_routed_transaction(int id, uint64_t &intended_start) {
+			if constexpr (ENABLE_ROUTE) {
+				return router_.receive(id, intended_start);
+			}
+			else {
+				return std::nullopt;
+			}
+		}
+
 	public:
 		//! @brief Error handler during running
 		static void running_task_error_handler(const TaskError &error) {
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <array>
+#include <vector>
+#include <chrono>
+#include <ostream>
+
+#include <thread/thread.h>
+#include <util/latency_histogram.h>
+#include <util/tsc_clock.h>
+
+namespace transaction {
+
+	//! @brief Switch of time-series sampling during benchmark runs.
+	inline constexpr bool ENABLE_TIME_SERIES = false;
+
+	//! @brief Interval between two samples of the time series.
+	inline constexpr std::chrono::milliseconds TIME_SERIES_INTERVAL{100};
+
+	/*!
+	 * @brief Progress of a worker thread, published to the time-series reporter without locks.
+	 * Counters are published under a sequence lock, so that a snapshot of commit and abort amount is consistent.
+	 * Latency buckets are single-writer counters, which are monotonic and read individually.
+	 * Only transactions timed by the message recorder of concurrent control carry latency.
+	 */
+	class alignas(64) ThreadProgress {
+	public:
+		/// Only bucketing of the histogram is used, the same as that of the message recorder
+		using Bucketing = util::LatencyHistogram<>;
+
+		static constexpr uint64_t BUCKET_NUM = Bucketing::BUCKET_NUM;
+
+		struct Snapshot {
+			uint64_t commit_tx;
+
+			uint64_t abort_tx;
+
+			/// Latency in TSC cycles
+			std::array<uint64_t, BUCKET_NUM> latency_bucket;
+		};
+
+	private:
+		/// Odd while being modified
+		std::atomic<uint64_t> seq_{0};
+
+		std::atomic<uint64_t> commit_tx_{0};
+
+		std::atomic<uint64_t> abort_tx_{0};
+
+		std::array<std::atomic<uint64_t>, BUCKET_NUM> latency_bucket_{};
+
+	public:
+		static ThreadProgress &get_thread_progress(uint32_t tid) {
+			static ThreadProgress progress_array[thread::get_max_tid()];
+			return progress_array[tid];
+		}
+
+		static ThreadProgress &get_thread_progress() {
+			return get_thread_progress(thread::get_tid());
+		}
+
+	public:
+		//! @brief Record a committed transaction.
+		//! @param latency_cycles Latency in TSC cycles, and 0 if not sampled
+		void commit(uint64_t latency_cycles) {
+			write_counter(commit_tx_);
+			if (latency_cycles != 0) {
+				auto &bucket = latency_bucket_[Bucketing::get_bucket_index(latency_cycles)];
+				bucket.store(bucket.load(std::memory_order::relaxed) + 1, std::memory_order::relaxed);
+			}
+		}
+
+		void abort() {
+			write_counter(abort_tx_);
+		}
+
+		void read(Snapshot &snapshot) const {
+			while (true) {
+				const uint64_t seq = seq_.load(std::memory_order::acquire);
+				if (seq & 1) [[unlikely]] { thread::pause(); continue; }
+
+				snapshot.commit_tx = commit_tx_.load(std::memory_order::relaxed);
+				snapshot.abort_tx  = abort_tx_.load(std::memory_order::relaxed);
+
+				std::atomic_thread_fence(std::memory_order::acquire);
+				if (seq_.load(std::memory_order::relaxed) == seq) { break; }
+			}
+			for (uint64_t i = 0; i < BUCKET_NUM; ++i) {
+				snapshot.latency_bucket[i] = latency_bucket_[i].load(std::memory_order::relaxed);
+			}
+		}
+
+		//! @brief Reset progress, which should be called when no worker is running.
+		void clear() {
+			seq_.store(0, std::memory_order::relaxed);
+			commit_tx_.store(0, std::memory_order::relaxed);
+			abort_tx_.store(0, std::memory_order::relaxed);
+			for (auto &bucket: latency_bucket_) { bucket.store(0, std::memory_order::relaxed); }
+		}
+
+	private:
+		void write_counter(std::atomic<uint64_t> &counter) {
+			const uint64_t seq = seq_.load(std::memory_order::relaxed);
+			seq_.store(seq + 1, std::memory_order::relaxed);
+			std::atomic_thread_fence(std::memory_order::release);
+			counter.store(counter.load(std::memory_order::relaxed) + 1, std::memory_order::relaxed);
+			seq_.store(seq + 2, std::memory_order::release);
+		}
+	};
+
+	/*!
+	 * @brief Reporter sampling progress of all workers periodically.
+	 * Each sample holds the throughput and latency within the last interval.
+	 */
+	class TimeSeriesReporter {
+	public:
+		struct Sample {
+			/// Time since start(ms)
+			uint64_t time;
+
+			uint64_t commit_tx;
+
+			uint64_t abort_tx;
+			/// Committed transactions per second
+			uint64_t throughput;
+			/// Latency(ns) of committed transactions
+			uint64_t latency_50;
+
+			uint64_t latency_99;
+
+			uint64_t latency_max;
+		};
+
+	private:
+		uint32_t thread_num_;
+
+		std::chrono::steady_clock::time_point start_time_;
+
+		std::chrono::steady_clock::time_point last_time_;
+
+		/// Accumulated progress of all workers at the last sample
+		ThreadProgress::Snapshot last_snapshot_;
+
+		std::vector<Sample> samples_;
+
+	public:
+		explicit TimeSeriesReporter(uint32_t thread_num): thread_num_(thread_num), last_snapshot_{} {}
+
+		//! @brief Clear progress of workers and start timing.
+		void start() {
+			for (uint32_t tid = 0; tid < thread::get_max_tid(); ++tid) {
+				ThreadProgress::get_thread_progress(tid).clear();
+			}
+			last_snapshot_ = {};
+			samples_.clear();
+			start_time_ = last_time_ = std::chrono::steady_clock::now();
+		}
+
+		//! @brief Take a sample of the last interval.
+		void sample() {
+			const auto now_time = std::chrono::steady_clock::now();
+
+			ThreadProgress::Snapshot total{}, thread_snapshot;
+			for (uint32_t tid = 0; tid < thread::get_max_tid(); ++tid) {
+				ThreadProgress::get_thread_progress(tid).read(thread_snapshot);
+				total.commit_tx += thread_snapshot.commit_tx;
+				total.abort_tx  += thread_snapshot.abort_tx;
+				for (uint64_t i = 0; i < ThreadProgress::BUCKET_NUM; ++i) {
+					total.latency_bucket[i] += thread_snapshot.latency_bucket[i];
+				}
+			}
+
+			const auto interval = std::chrono::duration_cast<std::chrono::microseconds>(now_time - last_time_).count();
+			Sample sample {
+				.time        = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now_time - start_time_).count()),
+				.commit_tx   = total.commit_tx - last_snapshot_.commit_tx,
+				.abort_tx    = total.abort_tx - last_snapshot_.abort_tx,
+				.throughput  = 0,
+				.latency_50  = 0,
+				.latency_99  = 0,
+				.latency_max = 0
+			};
+			sample.throughput = sample.commit_tx * 1'000'000 / std::max<uint64_t>(interval, 1);
+
+			// Each bucket is represented by its lower bound, within the error of the histogram
+			ThreadProgress::Bucketing interval_latency;
+			for (uint64_t i = 0; i < ThreadProgress::BUCKET_NUM; ++i) {
+				interval_latency.add_latency(ThreadProgress::Bucketing::get_bucket_lower_bound(i),
+				                             total.latency_bucket[i] - last_snapshot_.latency_bucket[i]);
+			}
+			sample.latency_50  = util::TSCClock::to_ns(interval_latency.get_latency_summary(50.0));
+			sample.latency_99  = util::TSCClock::to_ns(interval_latency.get_latency_summary(99.0));
+			sample.latency_max = util::TSCClock::to_ns(interval_latency.get_max());
+
+			samples_.emplace_back(sample);
+			last_snapshot_ = total;
+			last_time_     = now_time;
+		}
+
+		const std::vector<Sample> &get_samples() const {
+			return samples_;
+		}
+
+		void dump_csv(std::ostream &os) const {
+			os << "thread_num,time_ms,commit_tx,abort_tx,throughput,latency_50_ns,latency_99_ns,latency_max_ns\n";
+			for (const Sample &sample: samples_) {
+				os << thread_num_ << ',' << sample.time << ',' << sample.commit_tx << ',' << sample.abort_tx << ','
+				   << sample.throughput << ',' << sample.latency_50 << ',' << sample.latency_99 << ',' << sample.latency_max << '\n';
+			}
+		}
+
+		void dump_json(std::ostream &os) const {
+			os << "{\"thread_num\": " << thread_num_
+			   << ", \"interval_ms\": " << TIME_SERIES_INTERVAL.count() << ", \"samples\": [";
+			for (size_t i = 0; i < samples_.size(); ++i) {
+				const Sample &sample = samples_[i];
+				os << (i == 0 ? "\n" : ",\n")
+				   << "  {\"time_ms\": " << sample.time
+				   << ", \"commit_tx\": " << sample.commit_tx
+				   << ", \"abort_tx\": " << sample.abort_tx
+				   << ", \"throughput\": " << sample.throughput
+				   << ", \"latency_50_ns\": " << sample.latency_50
+				   << ", \"latency_99_ns\": " << sample.latency_99
+				   << ", \"latency_max_ns\": " << sample.latency_max << "}";
+			}
+			os << "\n]}\n";
+		}
+	};
+
+}
@@ -9,12 +9,16 @@
 
 #include <transaction_manager/simple_transaction_manager/std_transaction_manager.h>
 #include <transaction_manager/preload_transaction_manager/std_transaction_manager.h>
+#include <transaction_manager/route_transaction_manager/std_transaction_manager.h>
+#include <transaction_manager/deterministic_transaction_manager/std_transaction_manager.h>
 
 namespace transaction {
 
 	enum class TransactionManagerType {
 		StdTransactionManager,
-		PreloadStdTransactionManager
+		PreloadStdTransactionManager,
+		RouteStdTransactionManager,
+		DeterministicStdTransactionManager
 	};
 
 	// ------ Register transaction manager public.
@@ -37,4 +41,18 @@ namespace transaction {
 
 		static_assert(TransactionManagerConcept<TransactionManager>);
 	};
+
+	template<class Workload, class CC>
+	struct TransactionManagerManager<TransactionManagerType::RouteStdTransactionManager, Workload, CC> {
+		using TransactionManager = RouteStdTransactionManager<Workload, CC>;
+
+		static_assert(TransactionManagerConcept<TransactionManager>);
+	};
+
+	template<class Workload, class CC>
+	struct TransactionManagerManager<TransactionManagerType::DeterministicStdTransactionManager, Workload, CC> {
+		using TransactionManager = DeterministicStdTransactionManager<Workload, CC>;
+
+		static_assert(TransactionManagerConcept<TransactionManager>);
+	};
 }
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <pthread.h>
+#include <papi.h>
+
+namespace util::listener {
+
+	//! @brief Switch of hardware counters of each phase, read by every worker thread at phase boundaries.
+	inline constexpr bool ENABLE_PAPI_COUNTER = false;
+
+	/*!
+	 * @brief Thread-local hardware counters, attributed to the current phase.
+	 * Each thread owns an event set created on first use. Counters are read whenever the phase changes,
+	 * and the difference is added to the phase left. Events out of any phase are not counted.
+	 * PAPIListener shuts the library down on destruction, thus it should not be used together.
+	 */
+	class PAPICounter {
+	public:
+		/// The maximum number of phases, including NO_PHASE
+		static constexpr uint32_t MAX_PHASE_NUM = 16;
+
+		static constexpr uint32_t NO_PHASE      = MAX_PHASE_NUM - 1;
+
+		static constexpr int EVENT_CODE[] = {
+				PAPI_TOT_INS, PAPI_L1_DCM, PAPI_L2_DCM, PAPI_LD_INS, PAPI_SR_INS
+		};
+
+		static constexpr const char *EVENT_NAME[] = {
+				"TOT_INS", "L1_DCM", "L2_DCM", "LD_INS", "SR_INS"
+		};
+
+		static constexpr uint32_t EVENT_NUM = std::size(EVENT_CODE);
+
+		/// The number of events of each phase
+		using Counter = std::array<std::array<uint64_t, EVENT_NUM>, MAX_PHASE_NUM>;
+
+	private:
+		struct ThreadEventSet {
+			int event_set;
+			/// False if PAPI or any event is unsupported, in which case nothing is counted
+			bool available;
+
+			ThreadEventSet(): event_set(PAPI_NULL), available(false) {
+				if (!init_library()) { return; }
+				if (PAPI_register_thread() != PAPI_OK) { return; }
+				if (PAPI_create_eventset(&event_set) != PAPI_OK) { return; }
+				for (int event_code: EVENT_CODE) {
+					if (PAPI_add_event(event_set, event_code) != PAPI_OK) { return; }
+				}
+				available = PAPI_start(event_set) == PAPI_OK;
+			}
+
+			~ThreadEventSet() {
+				if (event_set == PAPI_NULL) { return; }
+				std::array<long long, EVENT_NUM> value;
+				if (available) { PAPI_stop(event_set, value.data()); }
+				PAPI_cleanup_eventset(event_set);
+				PAPI_destroy_eventset(&event_set);
+				PAPI_unregister_thread();
+			}
+		};
+
+		static inline thread_local uint32_t phase_ = NO_PHASE;
+
+		static inline thread_local std::array<long long, EVENT_NUM> last_value_{};
+
+		static inline thread_local Counter counter_{};
+
+	public:
+		//! @brief Attribute events of this thread since the last change to the phase left, and enter a new one.
+		static void set_phase(uint32_t phase) {
+			if constexpr (ENABLE_PAPI_COUNTER) {
+				ThreadEventSet &thread_event_set = get_thread_event_set();
+				if (!thread_event_set.available) [[unlikely]] { return; }
+
+				std::array<long long, EVENT_NUM> value;
+				PAPI_read(thread_event_set.event_set, value.data());
+				if (phase_ != NO_PHASE) {
+					for (uint32_t i = 0; i < EVENT_NUM; ++i) {
+						counter_[phase_][i] += value[i] - last_value_[i];
+					}
+				}
+				last_value_ = value;
+				phase_      = phase < MAX_PHASE_NUM ? phase : NO_PHASE;
+			}
+		}
+
+		static uint32_t get_phase() {
+			return phase_;
+		}
+
+		//! @brief Get counters of this thread.
+		static Counter &get_thread_counter() {
+			return counter_;
+		}
+
+		static void clear_thread_counter() {
+			for (auto &phase_counter: counter_) { phase_counter.fill(0); }
+		}
+
+	private:
+		static ThreadEventSet &get_thread_event_set() {
+			static thread_local ThreadEventSet thread_event_set;
+			return thread_event_set;
+		}
+
+		static bool init_library() {
+			static const bool initialized = PAPI_library_init(PAPI_VER_CURRENT) == PAPI_VER_CURRENT
+			                                && PAPI_thread_init(get_thread_id) == PAPI_OK;
+			return initialized;
+		}
+
+		static unsigned long get_thread_id() {
+			return static_cast<unsigned long>(pthread_self());
+		}
+	};
+
+}
@@ -31,9 +31,10 @@ namespace util::listener {
 			PAPI_add_event(event_set, PAPI_L2_DCM);
 			PAPI_add_event(event_set, PAPI_LD_INS);
 			PAPI_add_event(event_set, PAPI_SR_INS);
+			PAPI_add_event(event_set, PAPI_TLB_DM);
 
-			start_value_.resize(5, 0);
-			end_value_.resize(5, 0);
+			start_value_.resize(6, 0);
+			end_value_.resize(6, 0);
 		}
 
 		~PAPIListener() override {
@@ -46,7 +47,8 @@ namespace util::listener {
 										std::make_tuple("PAPI_L1_DCM", end_value_[1] - start_value_[1], ""),
 										std::make_tuple("PAPI_L2_DCM", end_value_[2] - start_value_[2], ""),
 										std::make_tuple("PAPI_LD_INS", end_value_[3] - start_value_[3], ""),
-										std::make_tuple("PAPI_SR_INS", end_value_[4] - start_value_[4], "")
+										std::make_tuple("PAPI_SR_INS", end_value_[4] - start_value_[4], ""),
+										std::make_tuple("PAPI_TLB_DM", end_value_[5] - start_value_[5], "")
 			);
 	    }
 
@@ -361,6 +361,10 @@ namespace util::listener {
 			return std::chrono::duration_cast<std::chrono::milliseconds>(end_timer_ - start_timer_).count();
 		}
 
+		const std::vector<DIMMObj> &get_dimm_info() const {
+			return dimm_info_list_;
+		}
+
 		DIMMData get_data() {
 			DIMMData res_data = {0, 0, 0, 0};
 			for (auto &dimm_info: dimm_info_list_) {
@@ -405,4 +409,58 @@ namespace util::listener {
 			data_collector_.end_record();
 		}
 	};
+
+	/*!
+	 * @brief Listener of DIMM data grouped by socket(NUMA node), reporting bandwidth of each node.
+	 * The socket is encoded in bits 12-15 of DIMM handle, e.g. DIMM 0x1021 is on socket 1.
+	 */
+	class PMMNodeListener: public AbstractListener {
+	public:
+		/// Bytes per media access
+		static constexpr uint64_t MEDIA_ACCESS_SIZE = 64;
+
+	private:
+		PMMDataCollector data_collector_;
+
+	public:
+		PMMNodeListener(): data_collector_(false) {}
+
+		~PMMNodeListener() override {
+			data_collector_.calculate_record();
+			const auto res_time = std::max<uint64_t>(data_collector_.get_listen_time(), 1);
+
+			std::vector<DIMMData> node_data;
+			for (const DIMMObj &dimm_info: data_collector_.get_dimm_info()) {
+				const uint32_t node_id = (std::stoul(dimm_info.dimm_id_, nullptr, 16) >> 12) & 0xF;
+				if (node_data.size() <= node_id) { node_data.resize(node_id + 1, {0, 0, 0, 0}); }
+				node_data[node_id] += dimm_info.data_;
+			}
+
+			auto to_bandwidth = [res_time](uint64_t access_num) {
+				return static_cast<double>(access_num * MEDIA_ACCESS_SIZE) / 1024 / 1024 * 1000 / res_time;
+			};
+			for (uint32_t node_id = 0; node_id < node_data.size(); ++node_id) {
+				DIMMData &res_data = node_data[node_id];
+				res_data.imc_read -= res_data.imc_write;
+				util::print_property(std::string("PMMListener(node ") + std::to_string(node_id) + ')',
+				                     std::make_tuple("Time", res_time, "ms"),
+				                     std::make_tuple("Media read", res_data.media_read, ""),
+				                     std::make_tuple("Media write", res_data.media_write, ""),
+				                     std::make_tuple("Media read bandwidth", to_bandwidth(res_data.media_read), "MB/s"),
+				                     std::make_tuple("Media write bandwidth", to_bandwidth(res_data.media_write), "MB/s"),
+				                     std::make_tuple("IMC read bandwidth", to_bandwidth(res_data.imc_read), "MB/s"),
+				                     std::make_tuple("IMC write bandwidth", to_bandwidth(res_data.imc_write), "MB/s")
+				);
+			}
+		}
+
+	public:
+		void start_record() override {
+			data_collector_.start_record();
+		}
+
+		void end_record() override {
+			data_collector_.end_record();
+		}
+	};
 }
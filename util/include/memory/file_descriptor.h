@@ -6,16 +6,160 @@
 #pragma once
 
 #include <cassert>
+#include <cerrno>
+#include <span>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
 #include <filesystem>
 
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 
+#include <thread/thread.h>
 #include <memory/memory_config.h>
 
 inline namespace util_mem {
 
+	//! @brief Page size which the mapped range is aligned to
+	enum class MapPageSize {
+		Default,
+		Huge2MB,
+		Huge1GB
+	};
+
+	//! @brief Options of mapping files
+	struct MapOption {
+		/// Alignment of address and size, so that DAX/tmpfs is able to map the range with huge pages
+		MapPageSize page_size;
+		/// Use MAP_SYNC on DAX files, falling back to ordinary shared mapping on other file systems
+		bool sync;
+		/// The number of threads prefaulting the range, 0 for one per cpu and 1 for MAP_POPULATE
+		uint32_t prefault_thread_num;
+	};
+
+	//! @brief Ordinary shared mapping populated by MAP_POPULATE
+	inline constexpr MapOption DEFAULT_MAP_OPTION = {
+		.page_size           = MapPageSize::Default,
+		.sync                = false,
+		.prefault_thread_num = 1
+	};
+
+	//! @brief Mapping of large PMEM data pools, which benefit from huge pages and parallel prefaulting
+	inline constexpr MapOption PMEM_DATA_MAP_OPTION = {
+		.page_size           = MapPageSize::Huge2MB,
+		.sync                = true,
+		.prefault_thread_num = 0
+	};
+
+	inline constexpr size_t get_map_align_size(MapPageSize page_size) {
+		switch (page_size) {
+			case MapPageSize::Huge2MB: return 2_MB;
+			case MapPageSize::Huge1GB: return 1_GB;
+			default:                   return MEM_PAGE_SIZE;
+		}
+	}
+
+	//! @brief Get the directory where files are actually created, which is redirected to DRAM while PMEM is emulated.
+	inline std::string get_mapped_dir(std::string_view dir_name) {
+		if constexpr (is_pmem_emulated()) {
+			return NVMEmulator::get_emulated_dir(dir_name);
+		}
+		else {
+			return std::string(dir_name);
+		}
+	}
+
+	/*!
+	 * @brief Reserve an address range aligned to align_size, which will be covered by MAP_FIXED afterwards.
+	 * Only the aligned part of the reservation is kept.
+	 */
+	inline uint8_t *reserve_aligned_range(size_t size, size_t align_size) {
+		const size_t reserve_size = size + align_size;
+		auto *reserve_ptr = (uint8_t *)mmap(NULL, reserve_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (reserve_ptr == MAP_FAILED) {
+			perror("ERROR: mmap() is not working !!! ");
+			exit(-1);
+		}
+		auto *aligned_ptr = (uint8_t *)(((uintptr_t)reserve_ptr + align_size - 1) & ~(align_size - 1));
+		if (aligned_ptr != reserve_ptr) {
+			munmap(reserve_ptr, aligned_ptr - reserve_ptr);
+		}
+		if (aligned_ptr + size != reserve_ptr + reserve_size) {
+			munmap(aligned_ptr + size, reserve_ptr + reserve_size - (aligned_ptr + size));
+		}
+		return aligned_ptr;
+	}
+
+	/*!
+	 * @brief Map a file into the reserved range.
+	 * @return Whether MAP_SYNC takes effect
+	 */
+	inline bool map_file_fixed(uint8_t *addr, size_t size, int fd, const MapOption &option) {
+		int flags = MAP_SHARED | MAP_FIXED;
+		if (option.prefault_thread_num == 1) {
+			// MAP_POPULATE avoid running-time page fault
+			flags |= MAP_POPULATE;
+		}
+
+		void *ptr   = MAP_FAILED;
+		bool synced = false;
+#ifdef MAP_SYNC
+		if (option.sync) {
+			// Only DAX files support MAP_SYNC, others reject it with EOPNOTSUPP
+			ptr    = mmap(addr, size, (PROT_READ | PROT_WRITE), flags | MAP_SHARED_VALIDATE | MAP_SYNC, fd, 0);
+			synced = (ptr != MAP_FAILED);
+		}
+#endif
+		if (!synced) {
+			ptr = mmap(addr, size, (PROT_READ | PROT_WRITE), flags, fd, 0);
+		}
+		if (ptr == MAP_FAILED) {
+			perror("ERROR: mmap() is not working !!! ");
+			exit(-1);
+		}
+
+		if (option.page_size != MapPageSize::Default) {
+			// Hint for tmpfs, while DAX maps huge pages once the range is aligned
+			madvise(addr, size, MADV_HUGEPAGE);
+		}
+		return synced;
+	}
+
+	/*!
+	 * @brief Fault in all pages of a mapped range with multiple threads.
+	 * Each thread takes contiguous chunks aligned to the page size of mapping.
+	 */
+	inline void prefault_range(uint8_t *start_ptr, size_t size, const MapOption &option) {
+		if (option.prefault_thread_num == 1) { return; }
+
+		const uint32_t thread_num = option.prefault_thread_num == 0 ?
+				std::max(1U, thread::get_num_cpus()) : option.prefault_thread_num;
+		const size_t align_size = get_map_align_size(option.page_size);
+		const size_t chunk_size = std::max(align_size, (size / thread_num + align_size - 1) & ~(align_size - 1));
+
+		auto task_func = [start_ptr, size, chunk_size](size_t offset) {
+			uint8_t *chunk_ptr   = start_ptr + offset;
+			const size_t length = std::min(chunk_size, size - offset);
+#ifdef MADV_POPULATE_WRITE
+			if (madvise(chunk_ptr, length, MADV_POPULATE_WRITE) == 0) { return; }
+#endif
+			// Fall back to reading each page, which maps it without dirtying
+			for (size_t i = 0; i < length; i += MEM_PAGE_SIZE) {
+				(void)*(volatile const uint8_t *)(chunk_ptr + i);
+			}
+		};
+
+		std::vector<std::thread> thread_vec;
+		for (size_t offset = chunk_size; offset < size; offset += chunk_size) {
+			thread_vec.emplace_back(task_func, offset);
+		}
+		task_func(0);
+		for (auto &t: thread_vec) { t.join(); }
+	}
+
 	struct FileDescriptor {
 
 	public:
@@ -27,30 +171,38 @@ inline namespace util_mem {
 		uint8_t *start_ptr;
 		/// The total size of mapped area
 		uint64_t total_size;
+		/// Whether the file is mapped with MAP_SYNC
+		bool synced;
+		/// Time spent on mapping and prefaulting
+		std::chrono::milliseconds map_time;
 
 	public:
-		FileDescriptor(std::string_view dir_name, std::string_view path, size_t alloc_size):
-				fd(0), file_path(std::string(dir_name) + '/' + path.data()), start_ptr(nullptr), total_size(alloc_size)  {
+		FileDescriptor(std::string_view dir_name, std::string_view path, size_t alloc_size,
+		               const MapOption &option = DEFAULT_MAP_OPTION):
+				fd(0), file_path(get_mapped_dir(dir_name) + '/' + path.data()), start_ptr(nullptr), synced(false), map_time(0) {
+			const auto start_time   = std::chrono::steady_clock::now();
+			const size_t align_size = get_map_align_size(option.page_size);
+			total_size = (alloc_size + align_size - 1) & ~(align_size - 1);
+
 			// Create directories of the path
-			if (!std::filesystem::exists(dir_name)) {
-				std::filesystem::create_directories(dir_name);
+			if (!std::filesystem::exists(file_path.parent_path())) {
+				std::filesystem::create_directories(file_path.parent_path());
 			}
 
 			// Open file and truncate the size of file
 			fd = open(file_path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
-			int td = ftruncate(fd, alloc_size);
+			int td = ftruncate(fd, total_size);
 			if (fd < 0 || td < 0) {
 				perror("Unable to create file");
 				exit(-1);
 			}
 
 			// mmap() memory range
-			// MAP_POPULATE avoid running-time page fault
-			start_ptr = (uint8_t *)mmap(NULL, alloc_size, (PROT_READ | PROT_WRITE), MAP_SHARED | MAP_POPULATE, fd, 0);
-			if (start_ptr == MAP_FAILED) {
-				perror("ERROR: mmap() is not working !!! ");
-				exit(-1);
-			}
+			start_ptr = reserve_aligned_range(total_size, align_size);
+			synced    = map_file_fixed(start_ptr, total_size, fd, option);
+			prefault_range(start_ptr, total_size, option);
+
+			map_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
 		}
 
 		~FileDescriptor() {
@@ -60,6 +212,91 @@ inline namespace util_mem {
 		}
 	};
 
+	/*!
+	 * @brief Files on several directories(e.g. PMEM namespaces on different NUMA nodes) mapped into
+	 * one contiguous address range. Stripe i occupies [start_ptr + i * stripe_size, start_ptr + (i + 1) * stripe_size)
+	 * and is backed by the file in the i-th directory.
+	 */
+	struct StripedFileDescriptor {
+	public:
+		/// Alignment of each stripe, which keeps stripes on huge page boundary
+		static constexpr size_t STRIPE_ALIGN_SIZE = 2UL * 1024 * 1024;
+
+	public:
+		/// File descriptors of each stripe
+		std::vector<int> fd_array;
+		/// The pathnames of files
+		std::vector<std::filesystem::path> file_path_array;
+		/// The start pointer of mapped area
+		uint8_t *start_ptr;
+		/// The total size of mapped area
+		uint64_t total_size;
+		/// The size of each stripe
+		uint64_t stripe_size;
+		/// The number of stripes
+		uint32_t stripe_num;
+		/// Whether all stripes are mapped with MAP_SYNC
+		bool synced;
+		/// Time spent on mapping and prefaulting
+		std::chrono::milliseconds map_time;
+
+	public:
+		StripedFileDescriptor(std::span<const char * const> dir_array, std::string_view path, size_t alloc_size,
+		                      const MapOption &option = DEFAULT_MAP_OPTION):
+				start_ptr(nullptr), total_size(0), stripe_size(0), stripe_num(dir_array.size()), synced(true), map_time(0) {
+
+			assert(stripe_num > 0);
+			const auto start_time   = std::chrono::steady_clock::now();
+			const size_t align_size = std::max(STRIPE_ALIGN_SIZE, get_map_align_size(option.page_size));
+			stripe_size = (alloc_size + stripe_num - 1) / stripe_num;
+			stripe_size = (stripe_size + align_size - 1) & ~(align_size - 1);
+			total_size  = stripe_size * stripe_num;
+
+			// Reserve contiguous address range, then map files into it.
+			start_ptr = reserve_aligned_range(total_size, align_size);
+
+			for (uint32_t i = 0; i < stripe_num; ++i) {
+				const std::string dir_name = get_mapped_dir(dir_array[i]);
+				// Create directories of the path
+				if (!std::filesystem::exists(dir_name)) {
+					std::filesystem::create_directories(dir_name);
+				}
+
+				auto &file_path = file_path_array.emplace_back(dir_name + '/' + path.data());
+				int fd = open(file_path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+				int td = ftruncate(fd, stripe_size);
+				if (fd < 0 || td < 0) {
+					perror("Unable to create file");
+					exit(-1);
+				}
+				fd_array.push_back(fd);
+
+				synced &= map_file_fixed(start_ptr + i * stripe_size, stripe_size, fd, option);
+			}
+			prefault_range(start_ptr, total_size, option);
+
+			map_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
+		}
+
+		StripedFileDescriptor(const StripedFileDescriptor &other) = delete;
+
+		~StripedFileDescriptor() {
+			munmap(start_ptr, total_size);
+			for (int fd: fd_array) { close(fd); }
+		}
+
+	public:
+		//! @brief Get the address range of a stripe
+		std::span<uint8_t> get_stripe(uint32_t stripe_idx) const {
+			return { start_ptr + stripe_idx * stripe_size, stripe_size };
+		}
+
+		//! @brief Get the index of stripe containing the address
+		uint32_t get_stripe_index(const void *ptr) const {
+			return ((const uint8_t *)ptr - start_ptr) / stripe_size;
+		}
+	};
+
 	/*!
 	 * @brief Allocate a unique id for file
 	 */
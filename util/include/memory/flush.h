@@ -8,7 +8,10 @@
 #include <cstdint>
 #include <immintrin.h>
 
+#include <util/event_tracer.h>
 #include <memory/cache_config.h>
+#include <memory/persist_counter.h>
+#include <memory/nvm_emulation.h>
 
 inline namespace util_mem {
 
@@ -20,48 +23,83 @@ inline namespace util_mem {
 	enum class Flush {
 		CLWB,
 		CLFLUSH,
-		CLFLUSHOPT
+		CLFLUSHOPT,
+		/// CLWB on DRAM with latency and bandwidth of PMEM emulated
+		EMULATE
 	};
 
 	inline constexpr Flush get_current_pwb_type() {
 		return PWB_ENUM;
 	}
 
+	//! @brief Whether latency and bandwidth of PMEM are emulated by flush and fence helpers below.
+	inline constexpr bool is_pmem_emulated() {
+		return PWB_ENUM == Flush::EMULATE;
+	}
+
 	__attribute__((always_inline)) inline void clwb(void *target) {
+		const uint64_t trace_start = util::EventTracer::now();
 		_mm_clwb(target);
+		PersistCounter::on_flush();
+		if constexpr (is_pmem_emulated()) { NVMEmulator::on_flush(); }
+		util::EventTracer::record("pwb", trace_start);
 	}
 
 	__attribute__((always_inline)) inline void clflush(void *target) {
+		const uint64_t trace_start = util::EventTracer::now();
 		_mm_clflush(target);
+		PersistCounter::on_flush();
+		if constexpr (is_pmem_emulated()) { NVMEmulator::on_flush(); }
+		util::EventTracer::record("pwb", trace_start);
 	}
 
 	__attribute__((always_inline)) inline void clflushopt(void *target) {
+		const uint64_t trace_start = util::EventTracer::now();
 		_mm_clflushopt(target);
+		PersistCounter::on_flush();
+		if constexpr (is_pmem_emulated()) { NVMEmulator::on_flush(); }
+		util::EventTracer::record("pwb", trace_start);
 	}
 
 	__attribute__((always_inline)) inline void clwb_range(void *start_ptr, uint32_t size) {
+		const uint64_t trace_start = util::EventTracer::now();
 		uint8_t *target = static_cast<uint8_t *>(start_ptr);
 		for (uint32_t i = 0; i < size; i += CACHE_LINE_SIZE) {
 			_mm_clwb(target + i);
 		}
+		PersistCounter::on_flush((size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE);
+		if constexpr (is_pmem_emulated()) { NVMEmulator::on_flush((size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE); }
+		util::EventTracer::record("pwb", trace_start);
 	}
 
 	__attribute__((always_inline)) inline void clflush_range(void *start_ptr, uint32_t size) {
+		const uint64_t trace_start = util::EventTracer::now();
 		uint8_t *target = static_cast<uint8_t *>(start_ptr);
 		for (uint32_t i = 0; i < size; i += CACHE_LINE_SIZE) {
 			_mm_clflush(target + i);
 		}
+		PersistCounter::on_flush((size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE);
+		if constexpr (is_pmem_emulated()) { NVMEmulator::on_flush((size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE); }
+		util::EventTracer::record("pwb", trace_start);
 	}
 
 	__attribute__((always_inline)) inline void clflushopt_range(void *start_ptr, uint32_t size) {
+		const uint64_t trace_start = util::EventTracer::now();
 		uint8_t *target = static_cast<uint8_t *>(start_ptr);
 		for (uint32_t i = 0; i < size; i += CACHE_LINE_SIZE) {
 			_mm_clflushopt(target + i);
 		}
+		PersistCounter::on_flush((size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE);
+		if constexpr (is_pmem_emulated()) { NVMEmulator::on_flush((size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE); }
+		util::EventTracer::record("pwb", trace_start);
 	}
 
 	__attribute__((always_inline)) inline void sfence() {
+		const uint64_t trace_start = util::EventTracer::now();
 		asm volatile("sfence" ::: "memory");
+		PersistCounter::on_fence();
+		if constexpr (is_pmem_emulated()) { NVMEmulator::on_fence(); }
+		util::EventTracer::record("fence", trace_start);
 	}
 
 	__attribute__((always_inline)) inline void lfence() {
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <memory/flush.h>
+#include <memory/nvm_emulation.h>
 
 inline namespace util_mem {
 
@@ -21,7 +22,10 @@ inline namespace util_mem {
 		}
 
 		static inline void fence() {
+			const uint64_t trace_start = util::EventTracer::now();
 			std::atomic_thread_fence(std::memory_order::acq_rel);
+			PersistCounter::on_fence();
+			util::EventTracer::record("fence", trace_start);
 		}
 	};
 
@@ -37,7 +41,7 @@ inline namespace util_mem {
 		}
 
 		static inline void fence() {
-			asm volatile("sfence\n" : :);
+			sfence();
 		}
 	};
 
@@ -68,7 +72,26 @@ inline namespace util_mem {
 		}
 
 		static inline void fence() {
-			asm volatile("sfence\n" : :);
+			sfence();
+		}
+	};
+
+	template<>
+	struct NVMConfig<Flush::EMULATE> {
+
+		// Emulated latency and bandwidth are charged by helpers in flush.h,
+		// so that callers using them directly are throttled as well.
+
+		static inline void pwb(void *target) {
+			clwb(target);
+		}
+
+		static inline void pwb_range(void *start_ptr, uint32_t size) {
+			clwb_range(start_ptr, size);
+		}
+
+		static inline void fence() {
+			sfence();
 		}
 	};
 
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <x86intrin.h>
+
+#include <arch/arch.h>
+#include <util/log_table.h>
+#include <util/tsc_clock.h>
+#include <thread/thread.h>
+#include <memory/cache_config.h>
+
+inline namespace util_mem {
+
+	/*!
+	 * @brief Parameters of emulated persistent memory.
+	 * Write-backs are asynchronous, so the latency of each flushed line is charged at the next fence
+	 * together with a fixed fence latency. Bytes drained by fences are throttled by the write bandwidth
+	 * of the NUMA node where the thread runs.
+	 */
+	struct NVMEmulationConfig {
+		/// Directory backing emulated persistent memory
+		static constexpr const char *EMULATION_ROOT_DIR = "/dev/shm";
+		/// Extra latency of each flushed cache line
+		static constexpr uint64_t FLUSH_LATENCY_NS      = 100;
+		/// Extra latency of each fence
+		static constexpr uint64_t FENCE_LATENCY_NS      = 50;
+		/// Write bandwidth of each node, 0 for unlimited
+		static constexpr uint64_t NODE_WRITE_BANDWIDTH_MB = 8 * 1024;
+		/// The maximum number of emulated nodes
+		static constexpr uint32_t MAX_NODE_NUM          = 8;
+	};
+
+	//! @brief Write queue and statistics of an emulated node
+	struct alignas(CACHE_LINE_SIZE) NVMEmulationNodeState {
+		/// The time (in tsc) when the write queue of this node drains
+		std::atomic<uint64_t> drain_tsc{0};
+		/// The number of flushed cache lines
+		std::atomic<uint64_t> flush_line_num{0};
+		/// The number of fences
+		std::atomic<uint64_t> fence_num{0};
+		/// Total injected delay
+		std::atomic<uint64_t> delay_ns{0};
+	};
+
+	//! @brief Emulation of latency and bandwidth of persistent memory on DRAM.
+	class NVMEmulator {
+	public:
+		using Config    = NVMEmulationConfig;
+
+		using NodeState = NVMEmulationNodeState;
+
+	private:
+		inline static thread_local uint64_t pending_line_num_ = 0;
+
+		inline static NodeState node_state_array_[Config::MAX_NODE_NUM];
+
+	public:
+		//! @brief Record a flushed line
+		static void on_flush(uint32_t line_num = 1) {
+			pending_line_num_ += line_num;
+		}
+
+		//! @brief Drain flushed lines of this thread, and wait for the emulated latency.
+		static void on_fence() {
+			const uint64_t line_num = pending_line_num_;
+			pending_line_num_ = 0;
+
+			NodeState &node = node_state_array_[get_node_index()];
+			const uint64_t start_tsc = __rdtsc();
+			uint64_t end_tsc = start_tsc + ns_to_tsc(Config::FENCE_LATENCY_NS + line_num * Config::FLUSH_LATENCY_NS);
+
+			if constexpr (Config::NODE_WRITE_BANDWIDTH_MB != 0) {
+				if (line_num != 0) {
+					// Reserve a slot on the write queue of node
+					const uint64_t drain_cost = ns_to_tsc(line_num * CACHE_LINE_SIZE * 1'000'000'000UL
+					                                      / (Config::NODE_WRITE_BANDWIDTH_MB * 1024 * 1024));
+					uint64_t drain_tsc = node.drain_tsc.load(std::memory_order::relaxed);
+					uint64_t new_drain_tsc;
+					do {
+						new_drain_tsc = std::max(drain_tsc, start_tsc) + drain_cost;
+					} while (!node.drain_tsc.compare_exchange_weak(drain_tsc, new_drain_tsc, std::memory_order::relaxed));
+					end_tsc = std::max(end_tsc, new_drain_tsc);
+				}
+			}
+
+			while (__rdtsc() < end_tsc) { _mm_pause(); }
+
+			node.flush_line_num.fetch_add(line_num, std::memory_order::relaxed);
+			node.fence_num.fetch_add(1, std::memory_order::relaxed);
+			node.delay_ns.fetch_add(tsc_to_ns(end_tsc - start_tsc), std::memory_order::relaxed);
+		}
+
+		//! @brief Get the directory where a file of persistent memory is emulated.
+		static std::string get_emulated_dir(std::string_view dir_name) {
+			if (dir_name.starts_with(Config::EMULATION_ROOT_DIR)) {
+				return std::string(dir_name);
+			}
+			return std::string(Config::EMULATION_ROOT_DIR) + (dir_name.starts_with('/') ? "" : "/") + std::string(dir_name);
+		}
+
+	public:
+		static uint64_t get_flush_line_num() {
+			uint64_t res = 0;
+			for (auto &node: node_state_array_) { res += node.flush_line_num.load(); }
+			return res;
+		}
+
+		//! @brief Clear all statistics, which should be called while no thread is running.
+		static void clear_up() {
+			for (auto &node: node_state_array_) {
+				node.drain_tsc      = 0;
+				node.flush_line_num = 0;
+				node.fence_num      = 0;
+				node.delay_ns       = 0;
+			}
+		}
+
+		static void print_summary() {
+			uint64_t flush_line_num = 0, fence_num = 0, delay_ns = 0;
+			for (auto &node: node_state_array_) {
+				flush_line_num += node.flush_line_num.load();
+				fence_num      += node.fence_num.load();
+				delay_ns       += node.delay_ns.load();
+			}
+			util::print_property("PMEM Emulation",
+			                     std::make_tuple("Flushed Lines", flush_line_num, ""),
+			                     std::make_tuple("Flushed Bytes", flush_line_num * CACHE_LINE_SIZE, "B"),
+			                     std::make_tuple("Fences", fence_num, ""),
+			                     std::make_tuple("Injected Delay", delay_ns, "ns"));
+		}
+
+	private:
+		static uint32_t get_node_index() {
+			if (!thread::is_registered()) { return 0; }
+			return static_cast<uint32_t>(thread::get_cpu_numa_id()) % Config::MAX_NODE_NUM;
+		}
+
+		static uint64_t ns_to_tsc(uint64_t ns) {
+			return static_cast<uint64_t>(static_cast<double>(ns) / util::TSCClock::get_ns_per_cycle());
+		}
+
+		static uint64_t tsc_to_ns(uint64_t tsc) {
+			return util::TSCClock::to_ns(tsc);
+		}
+	};
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+
+inline namespace util_mem {
+
+	//! @brief Switch of software counting of flushed cache lines and fences.
+	inline constexpr bool ENABLE_PERSIST_COUNTER = false;
+
+	/*!
+	 * @brief Thread-local counters of persistence instructions, attributed to the current phase.
+	 * Phases are plain tags set by the caller, so that the counter is independent of who defines them.
+	 * Instructions issued out of any phase are attributed to NO_PHASE.
+	 */
+	class PersistCounter {
+	public:
+		/// The maximum number of phases, including NO_PHASE
+		static constexpr uint32_t MAX_PHASE_NUM = 16;
+
+		static constexpr uint32_t NO_PHASE      = MAX_PHASE_NUM - 1;
+
+		struct Counter {
+			/// The number of flushed cache lines of each phase
+			std::array<uint64_t, MAX_PHASE_NUM> flush_line_num;
+			/// The number of fences of each phase
+			std::array<uint64_t, MAX_PHASE_NUM> fence_num;
+		};
+
+	private:
+		static inline thread_local uint32_t phase_ = NO_PHASE;
+
+		static inline thread_local Counter counter_{};
+
+	public:
+		__attribute__((always_inline)) static inline void on_flush(uint32_t line_num = 1) {
+			if constexpr (ENABLE_PERSIST_COUNTER) {
+				counter_.flush_line_num[phase_] += line_num;
+			}
+		}
+
+		__attribute__((always_inline)) static inline void on_fence() {
+			if constexpr (ENABLE_PERSIST_COUNTER) {
+				++counter_.fence_num[phase_];
+			}
+		}
+
+		//! @brief Attribute instructions issued by this thread afterward to the phase.
+		static void set_phase(uint32_t phase) {
+			phase_ = phase < MAX_PHASE_NUM ? phase : NO_PHASE;
+		}
+
+		static uint32_t get_phase() {
+			return phase_;
+		}
+
+		//! @brief Get counters of this thread.
+		static Counter &get_thread_counter() {
+			return counter_;
+		}
+
+		static void clear_thread_counter() {
+			counter_.flush_line_num.fill(0);
+			counter_.fence_num.fill(0);
+		}
+	};
+
+}
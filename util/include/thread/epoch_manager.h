@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <utility>
+
+#include <memory/cache_config.h>
+#include <thread/thread.h>
+
+namespace thread {
+
+	/*!
+	 * @brief Epoch-based reclamation for blocks unlinked while optimistic readers may still access them.
+	 * A reader announces the global epoch before accessing shared blocks, and withdraws the announcement
+	 * once it holds no reference. A block unlinked by a writer is stamped by retire_epoch(), which also
+	 * moves the global epoch forward. It is safe to free once every announced epoch is later than its stamp,
+	 * since readers announcing later epochs are ordered after the unlinking.
+	 *
+	 * Each registered thread owns a slot, and nested sections(e.g. interleaved coroutines) keep the epoch
+	 * of the outermost one. Threads without tid share a slot under a lock.
+	 */
+	class EpochManager {
+	public:
+		/// Epoch of a thread holding no reference
+		static constexpr uint64_t QUIESCENT_EPOCH = std::numeric_limits<uint64_t>::max();
+
+	private:
+		struct alignas(CACHE_LINE_SIZE) EpochSlot {
+			std::atomic<uint64_t> epoch{QUIESCENT_EPOCH};
+			/// The number of nested sections, only accessed by the owner
+			uint32_t nest_num{0};
+		};
+
+	private:
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> global_epoch_{1};
+
+		std::array<EpochSlot, MAX_TID> slot_array_;
+
+		/// Slot shared by threads without tid
+		EpochSlot shared_slot_;
+
+		std::mutex shared_slot_lock_;
+
+	public:
+		//! @brief Announce current epoch before accessing shared blocks.
+		void enter() {
+			if (!is_registered()) [[unlikely]] {
+				std::lock_guard<std::mutex> guard(shared_slot_lock_);
+				enter_slot(shared_slot_);
+				return;
+			}
+			enter_slot(slot_array_[get_tid()]);
+		}
+
+		//! @brief Withdraw the announcement after all references are dropped.
+		void leave() {
+			if (!is_registered()) [[unlikely]] {
+				std::lock_guard<std::mutex> guard(shared_slot_lock_);
+				leave_slot(shared_slot_);
+				return;
+			}
+			leave_slot(slot_array_[get_tid()]);
+		}
+
+		/*!
+		 * @brief Stamp blocks which have been unlinked, which should be called after unlinking.
+		 * @return Stamp of blocks, which are safe to free once get_min_epoch() exceeds it
+		 */
+		uint64_t retire_epoch() {
+			return global_epoch_.fetch_add(1, std::memory_order::seq_cst);
+		}
+
+		/*!
+		 * @brief Get the earliest epoch announced, blocks stamped before which are unreachable.
+		 * It is bounded by current global epoch, so that it stays valid for blocks retired afterwards.
+		 */
+		uint64_t get_min_epoch() const {
+			uint64_t res = global_epoch_.load(std::memory_order::seq_cst);
+			res = std::min(res, shared_slot_.epoch.load(std::memory_order::seq_cst));
+			for (const EpochSlot &slot: slot_array_) {
+				res = std::min(res, slot.epoch.load(std::memory_order::seq_cst));
+			}
+			return res;
+		}
+
+	private:
+		void enter_slot(EpochSlot &slot) {
+			if (slot.nest_num++ != 0) { return; }
+			slot.epoch.store(global_epoch_.load(std::memory_order::seq_cst), std::memory_order::seq_cst);
+			// Announcement should be visible before any shared block is read
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+		}
+
+		static void leave_slot(EpochSlot &slot) {
+			DEBUG_ASSERT(slot.nest_num > 0);
+			if (--slot.nest_num != 0) { return; }
+			slot.epoch.store(QUIESCENT_EPOCH, std::memory_order::release);
+		}
+	};
+
+	inline EpochManager EPOCH_MANAGER;
+
+	/*!
+	 * @brief Section of a reader announcing its epoch, which can be entered and left repeatedly
+	 * and leaves on destruction.
+	 */
+	class EpochGuard {
+	private:
+		bool entered_{false};
+
+	public:
+		EpochGuard() = default;
+
+		EpochGuard(const EpochGuard &) = delete;
+
+		EpochGuard &operator= (const EpochGuard &) = delete;
+
+		EpochGuard(EpochGuard &&other) noexcept: entered_(std::exchange(other.entered_, false)) {}
+
+		~EpochGuard() { leave(); }
+
+	public:
+		void enter() {
+			if (entered_) { return; }
+			EPOCH_MANAGER.enter();
+			entered_ = true;
+		}
+
+		void leave() {
+			if (!entered_) { return; }
+			EPOCH_MANAGER.leave();
+			entered_ = false;
+		}
+	};
+
+	/*!
+	 * @brief Blocks retired by one thread, freed in order once no reader may hold them.
+	 * @tparam T Handle of retired block
+	 */
+	template<class T>
+	class EpochRetireList {
+	private:
+		struct RetiredItem {
+			uint64_t stamp;
+			T item;
+		};
+
+		std::deque<RetiredItem> retired_list_;
+
+		/// The latest min epoch observed, saving scans of slots
+		uint64_t safe_epoch_{0};
+
+	public:
+		//! @brief Retire a block having been unlinked.
+		void retire(const T &item) {
+			retired_list_.push_back({ EPOCH_MANAGER.retire_epoch(), item });
+		}
+
+		//! @brief Retire blocks having been unlinked, sharing one stamp.
+		template<class Iter>
+		void retire(Iter begin, Iter end) {
+			if (begin == end) { return; }
+			const uint64_t stamp = EPOCH_MANAGER.retire_epoch();
+			for (; begin != end; ++begin) {
+				retired_list_.push_back({ stamp, *begin });
+			}
+		}
+
+		//! @brief Free blocks which no reader may hold.
+		template<class Func>
+		void reclaim(Func &&free_func) {
+			if (retired_list_.empty()) { return; }
+			if (retired_list_.front().stamp >= safe_epoch_) {
+				safe_epoch_ = EPOCH_MANAGER.get_min_epoch();
+			}
+			while (!retired_list_.empty() && retired_list_.front().stamp < safe_epoch_) {
+				free_func(retired_list_.front().item);
+				retired_list_.pop_front();
+			}
+		}
+
+		//! @brief Free all blocks, when no reader is running.
+		template<class Func>
+		void drain(Func &&free_func) {
+			for (RetiredItem &retired_item: retired_list_) {
+				free_func(retired_item.item);
+			}
+			retired_list_.clear();
+		}
+
+		[[nodiscard]] size_t size() const {
+			return retired_list_.size();
+		}
+	};
+}
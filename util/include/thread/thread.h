@@ -252,6 +252,10 @@ namespace thread {
 		return THREAD_CONTEXT.get_tid() != -1;
 	}
 
+	inline constexpr uint32_t get_num_cpus() {
+		return ThreadConfig::get_cpu_num();
+	}
+
 	inline constexpr int get_num_nodes() {
 		return ThreadConfig::get_num_numa_node();
 	}
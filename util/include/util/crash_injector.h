@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <csignal>
+#include <atomic>
+#include <string_view>
+
+namespace util {
+
+	#ifndef ENABLE_CRASH_INJECTION_DEFINED
+		#define ENABLE_CRASH_INJECTION_DEFINED false
+	#endif
+
+	//! @brief Switch of crash points, which cost a relaxed load each while disarmed.
+	inline constexpr bool ENABLE_CRASH_INJECTION = ENABLE_CRASH_INJECTION_DEFINED;
+
+	/*!
+	 * @brief Injection of crashes at named points, for testing recovery.
+	 * Once armed, the process is killed by SIGKILL at the n-th hit of the point among all threads,
+	 * so that neither destructors nor buffered write-backs are executed, just like a power failure.
+	 * Stores having reached the page cache survive, thus a crash on DRAM-emulated PMEM is
+	 * optimistic about cache lines which have not been flushed.
+	 */
+	class CrashInjector {
+	private:
+		inline static std::atomic<bool> armed_{false};
+
+		inline static std::atomic<uint64_t> countdown_{0};
+
+		inline static std::string_view point_;
+
+		/// Whether the process restarts on persistent memory left by a crashed one
+		inline static bool restarted_{false};
+
+	public:
+		/*!
+		 * @brief Arm a crash point.
+		 * @param point Name of crash point
+		 * @param hit_num Crash at the hit_num-th hit, no less than 1
+		 */
+		static void arm(std::string_view point, uint64_t hit_num) {
+			point_ = point;
+			countdown_.store(hit_num, std::memory_order::relaxed);
+			armed_.store(true, std::memory_order::release);
+		}
+
+		static void disarm() {
+			armed_.store(false, std::memory_order::relaxed);
+		}
+
+		//! @brief Pass a crash point, crashing if it is armed and its countdown reaches zero.
+		__attribute__((always_inline)) static inline void hit(std::string_view point) {
+			if constexpr (ENABLE_CRASH_INJECTION) {
+				if (armed_.load(std::memory_order::relaxed)) [[unlikely]] {
+					hit_armed(point);
+				}
+			}
+		}
+
+		//! @brief Crash immediately.
+		[[noreturn]] static void crash() {
+			std::raise(SIGKILL);
+			__builtin_unreachable();
+		}
+
+		/*!
+		 * @brief Mark that the process restarts after crash, so that persistent structures should be
+		 * recovered instead of formatted.
+		 */
+		static void set_restarted(bool restarted) {
+			restarted_ = restarted;
+		}
+
+		static bool is_restarted() {
+			return restarted_;
+		}
+
+	private:
+		static void hit_armed(std::string_view point) {
+			std::atomic_thread_fence(std::memory_order::acquire);
+			if (point != point_) { return; }
+			if (countdown_.fetch_sub(1, std::memory_order::relaxed) == 1) {
+				crash();
+			}
+		}
+	};
+
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <ostream>
+#include <format>
+#include <algorithm>
+
+#include <util/tsc_clock.h>
+
+namespace util {
+
+	#ifndef ENABLE_EVENT_TRACE_DEFINED
+		#define ENABLE_EVENT_TRACE_DEFINED false
+	#endif
+
+	//! @brief Switch of event tracing, which costs two TSC reads and a store into ring buffer per event.
+	inline constexpr bool ENABLE_EVENT_TRACE = ENABLE_EVENT_TRACE_DEFINED;
+
+	/*!
+	 * @brief Timeline of events of each thread, dumped in Chrome trace format which Perfetto reads as well.
+	 * Each thread writes into its own ring buffer without any synchronization, keeping the latest
+	 * EVENT_CAPACITY events. An event is recorded on its end as a complete event with its start time,
+	 * so that nesting holds even if events abandoned by abortion are closed out of order.
+	 * Names should be string literals, since only pointers are kept.
+	 * Dumping and clearing should be done while no thread is recording.
+	 */
+	class EventTracer {
+	public:
+		/// The number of events kept by each thread, power of 2
+		static constexpr uint32_t EVENT_CAPACITY = 1U << 18;
+
+		static_assert((EVENT_CAPACITY & (EVENT_CAPACITY - 1)) == 0);
+
+		struct Event {
+			const char *name;
+			/// Start time(cycle)
+			uint64_t start;
+			/// End time(cycle)
+			uint64_t end;
+		};
+
+	private:
+		struct ThreadBuffer {
+			/// The number of events recorded, only written by the owner
+			std::atomic<uint64_t> event_num{0};
+			/// Whether the buffer is owned by a living thread
+			bool owned{true};
+
+			std::array<Event, EVENT_CAPACITY> event_array;
+		};
+
+		//! @brief Handle of buffer of a thread, which releases the buffer on thread exit.
+		struct ThreadHandle {
+			ThreadBuffer *buffer_ptr{nullptr};
+
+			~ThreadHandle() {
+				if (buffer_ptr == nullptr) { return; }
+				std::lock_guard<std::mutex> lock(get_mutex());
+				buffer_ptr->owned = false;
+			}
+		};
+
+		inline static std::atomic<bool> enabled_{false};
+
+		/// Buffer of this thread, kept apart from its handle so that access is free from TLS guard
+		static inline thread_local ThreadBuffer *buffer_ptr_ = nullptr;
+
+	public:
+		static void enable() {
+			enabled_.store(true, std::memory_order::relaxed);
+		}
+
+		static void disable() {
+			enabled_.store(false, std::memory_order::relaxed);
+		}
+
+		static uint64_t now() {
+			if constexpr (ENABLE_EVENT_TRACE) { return TSCClock::now(); }
+			else { return 0; }
+		}
+
+		/*!
+		 * @brief Record an event of this thread.
+		 * @param name Name of event with static storage duration
+		 * @param start Start time(cycle) got by now()
+		 * @param end End time(cycle) got by now()
+		 */
+		__attribute__((always_inline)) static inline void record(const char *name, uint64_t start, uint64_t end) {
+			if constexpr (ENABLE_EVENT_TRACE) {
+				if (!enabled_.load(std::memory_order::relaxed)) { return; }
+				ThreadBuffer *buffer_ptr = buffer_ptr_;
+				if (buffer_ptr == nullptr) [[unlikely]] { buffer_ptr = acquire_buffer(); }
+
+				const uint64_t event_num = buffer_ptr->event_num.load(std::memory_order::relaxed);
+				buffer_ptr->event_array[event_num & (EVENT_CAPACITY - 1)] = Event{ name, start, end };
+				buffer_ptr->event_num.store(event_num + 1, std::memory_order::release);
+			}
+		}
+
+		//! @brief Record an event lasting until now.
+		static void record(const char *name, uint64_t start) {
+			if constexpr (ENABLE_EVENT_TRACE) {
+				record(name, start, TSCClock::now());
+			}
+		}
+
+		/*!
+		 * @brief Dump events of all threads in Chrome trace format.
+		 * Threads are numbered by their buffers, and time is relative to the earliest event kept.
+		 */
+		static void dump_json(std::ostream &os) {
+			std::lock_guard<std::mutex> lock(get_mutex());
+			auto &buffer_array = get_buffer_array();
+
+			uint64_t base_time = UINT64_MAX;
+			for (const auto &buffer_ptr: buffer_array) {
+				for_each_event(*buffer_ptr, [&base_time](const Event &event) {
+					base_time = std::min(base_time, event.start);
+				});
+			}
+
+			const double us_per_cycle = TSCClock::get_ns_per_cycle() / 1000.0;
+			bool first = true;
+			os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+			for (uint32_t tid = 0; tid < buffer_array.size(); ++tid) {
+				if (buffer_array[tid]->event_num.load(std::memory_order::acquire) == 0) { continue; }
+				os << (first ? "\n" : ",\n")
+				   << std::format("  {{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": {}, \"args\": {{\"name\": \"thread {}\"}}}}", tid, tid);
+				first = false;
+				for_each_event(*buffer_array[tid], [&](const Event &event) {
+					os << std::format(",\n  {{\"name\": \"{}\", \"ph\": \"X\", \"pid\": 0, \"tid\": {}, \"ts\": {:.3f}, \"dur\": {:.3f}}}",
+					                  event.name, tid,
+					                  static_cast<double>(event.start - base_time) * us_per_cycle,
+					                  static_cast<double>(event.end - event.start) * us_per_cycle);
+				});
+			}
+			os << "\n]}\n";
+		}
+
+		//! @brief Drop all events recorded, and recycle buffers of exited threads.
+		static void clear() {
+			std::lock_guard<std::mutex> lock(get_mutex());
+			for (auto &buffer_ptr: get_buffer_array()) {
+				buffer_ptr->event_num.store(0, std::memory_order::relaxed);
+			}
+		}
+
+	private:
+		//! @brief Get a buffer for this thread, reusing an empty one released by an exited thread.
+		static ThreadBuffer *acquire_buffer() {
+			std::lock_guard<std::mutex> lock(get_mutex());
+			auto &buffer_array = get_buffer_array();
+
+			ThreadBuffer *buffer_ptr = nullptr;
+			for (auto &released_buffer_ptr: buffer_array) {
+				if (!released_buffer_ptr->owned && released_buffer_ptr->event_num.load(std::memory_order::relaxed) == 0) {
+					buffer_ptr = released_buffer_ptr.get();
+					break;
+				}
+			}
+			if (buffer_ptr == nullptr) {
+				buffer_ptr = buffer_array.emplace_back(std::make_unique<ThreadBuffer>()).get();
+			}
+			buffer_ptr->owned = true;
+
+			static thread_local ThreadHandle thread_handle;
+			thread_handle.buffer_ptr = buffer_ptr;
+			buffer_ptr_ = buffer_ptr;
+			return buffer_ptr;
+		}
+
+		//! @brief Visit events kept in a buffer from the oldest.
+		static void for_each_event(const ThreadBuffer &buffer, auto &&func) {
+			const uint64_t event_num = buffer.event_num.load(std::memory_order::acquire);
+			const uint64_t start_idx = event_num > EVENT_CAPACITY ? event_num - EVENT_CAPACITY : 0;
+			for (uint64_t idx = start_idx; idx < event_num; ++idx) {
+				func(buffer.event_array[idx & (EVENT_CAPACITY - 1)]);
+			}
+		}
+
+		static std::mutex &get_mutex() {
+			static std::mutex mutex;
+			return mutex;
+		}
+
+		static std::vector<std::unique_ptr<ThreadBuffer>> &get_buffer_array() {
+			static std::vector<std::unique_ptr<ThreadBuffer>> buffer_array;
+			return buffer_array;
+		}
+	};
+
+	//! @brief Record an event lasting for the scope.
+	class TraceScope {
+	private:
+		const char *name_;
+
+		uint64_t start_;
+
+	public:
+		explicit TraceScope(const char *name): name_(name), start_(EventTracer::now()) {}
+
+		~TraceScope() {
+			EventTracer::record(name_, start_);
+		}
+
+		TraceScope(const TraceScope &) = delete;
+
+		TraceScope &operator= (const TraceScope &) = delete;
+	};
+
+}
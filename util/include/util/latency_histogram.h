@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <bit>
+#include <algorithm>
+#include <limits>
+
+#include <util/utility_macro.h>
+
+namespace util {
+
+	/*!
+	 * @brief Log-linear latency histogram with bounded relative error.
+	 * Values smaller than 2^SubBucketBits are counted exactly. Each larger power-of-two range
+	 * is split into 2^(SubBucketBits - 1) buckets of equal width, so that the relative error of
+	 * any recorded value is no more than 2^(1 - SubBucketBits).
+	 * Values no smaller than 2^MaxBits are clamped into the last bucket, while the maximum is kept exactly.
+	 * @tparam SubBucketBits Precision of buckets, 6 for an error of about 3%
+	 * @tparam MaxBits Bits of the largest value distinguished, 40 for about 18 minutes in ns
+	 */
+	template<uint32_t SubBucketBits = 6, uint32_t MaxBits = 40>
+	class LatencyHistogram {
+	public:
+		static_assert(SubBucketBits >= 1 && SubBucketBits < MaxBits && MaxBits < 64);
+
+		static constexpr uint64_t SUB_BUCKET_NUM      = 1UL << SubBucketBits;
+
+		static constexpr uint64_t HALF_SUB_BUCKET_NUM = SUB_BUCKET_NUM / 2;
+
+		/// Exact buckets for [0, 2^SubBucketBits), then half of sub-buckets for each power of two above
+		static constexpr uint64_t BUCKET_NUM          = SUB_BUCKET_NUM + (MaxBits - SubBucketBits) * HALF_SUB_BUCKET_NUM;
+
+	private:
+		std::array<uint64_t, BUCKET_NUM> bucket_;
+
+		/// The number of values recorded
+		uint64_t count_;
+		/// The sum of all values recorded
+		uint64_t sum_;
+
+		uint64_t min_;
+
+		uint64_t max_;
+
+	public:
+		LatencyHistogram() { clear(); }
+
+		~LatencyHistogram() = default;
+
+	public:
+		//! @brief Add latency data into storage
+		inline void add_latency(uint64_t latency_time) {
+			++bucket_[get_bucket_index(latency_time)];
+			++count_;
+			sum_ += latency_time;
+			min_  = std::min(min_, latency_time);
+			max_  = std::max(max_, latency_time);
+		}
+
+		//! @brief Add several data of the same latency into storage
+		inline void add_latency(uint64_t latency_time, uint64_t amount) {
+			if (amount == 0) { return; }
+			bucket_[get_bucket_index(latency_time)] += amount;
+			count_ += amount;
+			sum_ += latency_time * amount;
+			min_  = std::min(min_, latency_time);
+			max_  = std::max(max_, latency_time);
+		}
+
+		/*!
+		 * @brief Get latency by percentile.
+		 * @param percentile Percentile in [0, 100], e.g. 99.9
+		 * @return The highest value equivalent to the bucket where the percentile lies, and 0 if empty
+		 */
+		inline uint64_t get_latency_summary(double percentile) const {
+			if (count_ == 0) { return 0; }
+			DEBUG_ASSERT(percentile >= 0.0 && percentile <= 100.0);
+
+			const auto level = std::max<uint64_t>(
+					static_cast<uint64_t>(static_cast<double>(count_) * percentile / 100.0 + 0.5), 1);
+			uint64_t accumulate = 0;
+			for (uint64_t i = 0; i < BUCKET_NUM; ++i) {
+				accumulate += bucket_[i];
+				if (accumulate >= level) {
+					return std::clamp(get_bucket_upper_bound(i), min_, max_);
+				}
+			}
+			return max_;
+		}
+
+		//! @brief Get the sum of all latency recorded.
+		inline uint64_t get_time_summary() const {
+			return sum_;
+		}
+
+		inline uint64_t get_count() const {
+			return count_;
+		}
+
+		inline uint64_t get_min() const {
+			return count_ == 0 ? 0 : min_;
+		}
+
+		inline uint64_t get_max() const {
+			return max_;
+		}
+
+		inline void combine(const LatencyHistogram &other) {
+			for (uint64_t i = 0; i < BUCKET_NUM; ++i) {
+				bucket_[i] += other.bucket_[i];
+			}
+			count_ += other.count_;
+			sum_   += other.sum_;
+			min_    = std::min(min_, other.min_);
+			max_    = std::max(max_, other.max_);
+		}
+
+		//! @brief Clear all things in storage
+		inline void clear() {
+			bucket_.fill(0);
+			count_ = sum_ = max_ = 0;
+			min_   = std::numeric_limits<uint64_t>::max();
+		}
+
+	public:
+		static constexpr uint64_t get_bucket_index(uint64_t value) {
+			if (value < SUB_BUCKET_NUM) { return value; }
+
+			const uint32_t msb = std::bit_width(value) - 1;
+			if (msb >= MaxBits) [[unlikely]] { return BUCKET_NUM - 1; }
+
+			// Keep SubBucketBits bits below the most significant one, whose top bit is always set
+			const uint32_t shift  = msb - (SubBucketBits - 1);
+			const uint64_t offset = (value >> shift) - HALF_SUB_BUCKET_NUM;
+			return SUB_BUCKET_NUM + (msb - SubBucketBits) * HALF_SUB_BUCKET_NUM + offset;
+		}
+
+		static constexpr uint64_t get_bucket_lower_bound(uint64_t index) {
+			if (index < SUB_BUCKET_NUM) { return index; }
+
+			const uint64_t group  = (index - SUB_BUCKET_NUM) / HALF_SUB_BUCKET_NUM;
+			const uint64_t offset = (index - SUB_BUCKET_NUM) % HALF_SUB_BUCKET_NUM;
+			const uint32_t shift  = group + 1;
+			return (HALF_SUB_BUCKET_NUM + offset) << shift;
+		}
+
+		static constexpr uint64_t get_bucket_upper_bound(uint64_t index) {
+			if (index + 1 == BUCKET_NUM) { return std::numeric_limits<uint64_t>::max(); }
+			return get_bucket_lower_bound(index + 1) - 1;
+		}
+	};
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <x86intrin.h>
+
+#include <arch/arch.h>
+
+namespace util {
+
+	/*!
+	 * @brief Low-overhead timer source based on the invariant TSC.
+	 * Timestamps are kept in cycles and only converted into nanoseconds on aggregation,
+	 * with a ratio calibrated against steady clock once.
+	 * ARCH_CPU_FREQUENCY(kHz) is taken instead if TSC fails to advance during calibration.
+	 */
+	class TSCClock {
+	public:
+		/// Time spent on calibration
+		static constexpr std::chrono::milliseconds CALIBRATE_TIME{20};
+
+	public:
+		//! @brief Read TSC after all previous instructions have been executed.
+		static inline uint64_t now() {
+			uint32_t aux;
+			return __rdtscp(&aux);
+		}
+
+		//! @brief Get nanoseconds per cycle, which is calibrated on the first call.
+		static double get_ns_per_cycle() {
+			static const double ns_per_cycle = calibrate();
+			return ns_per_cycle;
+		}
+
+		static uint64_t to_ns(uint64_t cycles) {
+			return static_cast<uint64_t>(static_cast<double>(cycles) * get_ns_per_cycle());
+		}
+
+		//! @brief Get the frequency of TSC(MHz).
+		static double get_frequency() {
+			return 1000.0 / get_ns_per_cycle();
+		}
+
+	private:
+		static double calibrate() {
+			const auto start_time  = std::chrono::steady_clock::now();
+			const uint64_t start_cycle = now();
+
+			auto end_time = start_time;
+			while (end_time - start_time < CALIBRATE_TIME) {
+				end_time = std::chrono::steady_clock::now();
+			}
+			const uint64_t end_cycle = now();
+
+			if (end_cycle <= start_cycle) [[unlikely]] { return 1'000'000.0 / ARCH_CPU_FREQUENCY; }
+
+			const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+			return static_cast<double>(duration.count()) / static_cast<double>(end_cycle - start_cycle);
+		}
+	};
+
+}
@@ -86,5 +86,15 @@ namespace workload {
 		[[nodiscard]] bool is_only_read() const {
 			return static_cast<const TransactionImpl *>(this)->is_only_read_impl();
 		}
+
+		//! @brief Get the tag of transaction type for statistics, 0 if the workload has only one kind.
+		[[nodiscard]] uint32_t get_type_tag() const {
+			if constexpr (requires(const TransactionImpl &tx) { tx.get_type_tag_impl(); }) {
+				return static_cast<const TransactionImpl *>(this)->get_type_tag_impl();
+			}
+			else {
+				return 0;
+			}
+		}
 	};
 }
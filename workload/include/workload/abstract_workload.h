@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <concepts>
 
 #include <workload/abstract_key.h>
@@ -38,6 +39,39 @@ namespace workload {
 	};
 
 
+	/*!
+	 * @brief Whether tuples of workload are variable-length, that is, the size of payload inserted or
+	 * updated may differ from the tuple size of table. It requires support from concurrent control.
+	 */
+	template<class Workload>
+	inline constexpr bool is_variable_length_workload() {
+		if constexpr (requires { Workload::VARIABLE_LENGTH_TUPLE; }) {
+			return Workload::VARIABLE_LENGTH_TUPLE;
+		}
+		return false;
+	}
+
+	//! @brief Per-table override of the index chosen globally.
+	enum class TableIndexHint {
+		/// Follow the global configuration
+		Default,
+		/// Direct-mapped array, for small tables with dense integral keys
+		Direct,
+		/// Hash index
+		Hash,
+		/// Ordered index
+		Ordered
+	};
+
+	//! @brief Per-table override of the media where tuples are placed.
+	enum class TableMediaHint {
+		/// Follow the storage manager
+		Default,
+		/// Volatile, tuples are lost after crash
+		DRAM,
+		PMEM
+	};
+
 	/*!
 	 * @brief The information about size and number of tuples.
 	 */
@@ -46,6 +80,26 @@ namespace workload {
 		size_t tuple_size;
 		/// The maximal number of this tuple
 		size_t max_tuple_num;
+		/// Index of this table
+		TableIndexHint index_hint = TableIndexHint::Default;
+		/// Media of this table
+		TableMediaHint media_hint = TableMediaHint::Default;
+	};
+
+	/*!
+	 * @brief A group of columns of a wide tuple, which is stored as a separate table.
+	 * The logical tuple keeps its layout, while each group covers bytes [OFFSET, OFFSET + SIZE) of it,
+	 * so that an update of hot columns never copies cold ones.
+	 */
+	template<size_t Offset, size_t Size>
+	struct ColumnGroup {
+		static constexpr size_t OFFSET = Offset;
+		static constexpr size_t SIZE   = Size;
+
+		//! @brief Whether bytes [offset, offset + size) of the logical tuple lie in this group.
+		static constexpr bool contain(size_t offset, size_t size) {
+			return OFFSET <= offset && offset + size <= OFFSET + SIZE;
+		}
 	};
 
 }
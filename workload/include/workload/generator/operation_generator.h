@@ -25,9 +25,10 @@ namespace workload {
 		}
 
 		OpeType get_next() {
-			uint32_t rand_num = util::rander.rand_percentage();
+			// Draw from [0, 100), so that operations with zero percentage are never chosen
+			uint32_t rand_num = util::rander.rand_range(0U, 99U);
 			uint32_t res = 0;
-			while (percentages_[res] < rand_num) {
+			while (percentages_[res] <= rand_num) {
 				rand_num -= percentages_[res];
 				++res;
 			}
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <cmath>
+
 #include <util/random_generator.h>
 
 #include <workload/abstract_key.h>
@@ -46,6 +48,11 @@ namespace workload {
 				TableScheme { sizeof(Checking), Config::NUM_CUSTOMER }
 		};
 
+		// Aware: The order of name should be the same Enumeration of transaction type.
+		static constexpr std::initializer_list<const char *> TransactionTypeNameDefinition = {
+				"TransactSavings", "DepositChecking", "SendPayment", "WriteCheck", "Amalgamate", "Query", "Initialize"
+		};
+
 	private:
 		RequestGenerator request_generator_;
 
@@ -80,7 +87,7 @@ namespace workload {
 						&bench_executor_,
 						customer_id1,
 						customer_id2,
-						balance_generator_.get_next()
+						get_next_amount()
 				};
 			}
 
@@ -95,7 +102,7 @@ namespace workload {
 					&bench_executor_,
 					customer_id1,
 					customer_id2,
-					balance_generator_.get_next()
+					get_next_amount()
 			};
 		}
 
@@ -110,10 +117,36 @@ namespace workload {
 									&bench_executor_,
 									i,
 									0,
-									balance_generator_.get_next()
+									get_initial_balance()
 				);
 			}
 			return res_tx;
 		}
+
+		/*!
+		 * @brief Check consistency of database, e.g. after recovery.
+		 * @param executor Executor from concurrent control, which is only used to read
+		 * @return Whether all conditions hold
+		 */
+		template<class Executor>
+		bool check_consistency(Executor &executor) {
+			return bench_executor_.do_check_consistency(executor);
+		}
+
+	private:
+		float get_next_amount() {
+			if constexpr (requires { Config::INITIAL_BALANCE; }) {
+				// Keep balances whole numbers
+				return std::floor(balance_generator_.get_next());
+			}
+			return balance_generator_.get_next();
+		}
+
+		float get_initial_balance() {
+			if constexpr (requires { Config::INITIAL_BALANCE; }) {
+				return Config::INITIAL_BALANCE;
+			}
+			return balance_generator_.get_next();
+		}
 	};
 }
@@ -30,7 +30,8 @@ namespace workload {
 
 		enum class SmallBankConfigType {
 			Light,
-			Normal
+			Normal,
+			Transfer
 		};
 
 		template<SmallBankConfigType Type>
@@ -52,5 +53,28 @@ namespace workload {
 			static constexpr uint32_t AMALGAMATE_PERCENTAGE       = 15;
 			static constexpr uint32_t QUERY_PERCENTAGE            = 15;
 		};
+
+		/*!
+		 * @brief Only transactions moving balance between accounts, so that the total balance is conserved
+		 * and can be checked after recovery. Balances and amounts are whole numbers, which floats hold exactly.
+		 */
+		template<>
+		struct SmallBankConfig<SmallBankConfigType::Transfer> {
+			/// The number of customers
+			static constexpr uint32_t NUM_CUSTOMER     = 100000;
+			/// The number of customers which is frequently operated
+			static constexpr uint32_t NUM_HOT_CUSTOMER = 4000;
+			/// The percentage of operating a hot account
+			static constexpr uint32_t HOT_PERCENTAGE   = 10;
+			/// Initial balance of each saving and checking
+			static constexpr float INITIAL_BALANCE     = 1000.0f;
+
+			static constexpr uint32_t TRANSACT_SAVING_PERCENTAGE  = 0;
+			static constexpr uint32_t DEPOSIT_CHECKING_PERCENTAGE = 0;
+			static constexpr uint32_t SEND_PAYMENT_PERCENTAGE     = 45;
+			static constexpr uint32_t WRITE_CHECK_PERCENTAGE      = 0;
+			static constexpr uint32_t AMALGAMATE_PERCENTAGE       = 10;
+			static constexpr uint32_t QUERY_PERCENTAGE            = 45;
+		};
 	}
 }
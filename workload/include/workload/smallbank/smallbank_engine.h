@@ -101,6 +101,24 @@ namespace workload {
 				return true;
 			}
 
+			/*!
+			 * @brief Sum up balance of all savings and checkings
+			 * @param total_balance Output of total balance
+			 * @return Whether all accounts are found
+			 */
+			bool sum_balance(double &total_balance) {
+				total_balance = 0;
+				for (KeyType customer_id = 0; customer_id < Config::NUM_CUSTOMER; ++customer_id) {
+					const Saving *saving = find_saving(customer_id);
+					if (saving == nullptr) { return false; }
+					const Checking *checking = find_checking(customer_id);
+					if (checking == nullptr) { return false; }
+
+					total_balance += static_cast<double>(saving->saving_balance) + checking->checking_balance;
+				}
+				return true;
+			}
+
 		public:
 			const Account *find_account(KeyType customer_id) {
 				SmallBankKey key{DurableTable::Account, customer_id};
@@ -204,7 +222,7 @@ namespace workload {
 				checking1.checking_balance -= amount;
 				checking2.checking_balance += amount;
 
-				if (!update_checking(customer_id1, checking1) && !update_checking(customer_id2, checking2)) { return false; }
+				if (!update_checking(customer_id1, checking1) || !update_checking(customer_id2, checking2)) { return false; }
 				return true;
 			}
 
@@ -238,7 +256,7 @@ namespace workload {
 				saving1.saving_balance = 0;
 				checking1.checking_balance = 0;
 
-				if (!update_checking(customer_id1, &checking1) && !update_checking(customer_id2, checking2) && !update_saving(customer_id1, saving1)) {
+				if (!update_checking(customer_id1, checking1) || !update_checking(customer_id2, checking2) || !update_saving(customer_id1, saving1)) {
 					return false;
 				}
 
@@ -247,14 +265,32 @@ namespace workload {
 
 			bool query(Executor &executor, KeyType customer_id) {
 				Checking checking;
-				if (!find_checking(customer_id, &checking)) { return false; }
+				if (!find_checking(customer_id, checking)) { return false; }
 				Saving saving;
-				if (!find_saving(customer_id, &saving)) { return false; }
+				if (!find_saving(customer_id, saving)) { return false; }
 
 				__attribute__((unused)) float res = saving.saving_balance + checking.checking_balance;
 				return true;
 			}
 
+			/*!
+			 * @brief Sum up balance of all savings and checkings
+			 * @param total_balance Output of total balance
+			 * @return Whether all accounts are found
+			 */
+			bool sum_balance(double &total_balance) {
+				total_balance = 0;
+				for (KeyType customer_id = 0; customer_id < Config::NUM_CUSTOMER; ++customer_id) {
+					Saving saving;
+					if (!find_saving(customer_id, saving)) { return false; }
+					Checking checking;
+					if (!find_checking(customer_id, checking)) { return false; }
+
+					total_balance += static_cast<double>(saving.saving_balance) + checking.checking_balance;
+				}
+				return true;
+			}
+
 		public:
 			bool find_account(KeyType customer_id, Account &account) {
 				SmallBankKey key{DurableTable::Account, customer_id};
@@ -68,6 +68,26 @@ namespace workload {
 				return engine.query(executor, customer_id);
 			}
 
+			/*!
+			 * @brief Check that all accounts exist, and that the total balance is conserved
+			 * if only transfers are executed.
+			 * @return Whether all conditions hold
+			 */
+			template<class Executor>
+			bool do_check_consistency(Executor &executor) {
+				SmallBankWorkloadEngine<Config, Executor> engine(&executor);
+
+				double total_balance;
+				if (!engine.sum_balance(total_balance)) { return false; }
+
+				if constexpr (requires { Config::INITIAL_BALANCE; }) {
+					static_assert(Config::TRANSACT_SAVING_PERCENTAGE == 0 && Config::DEPOSIT_CHECKING_PERCENTAGE == 0
+					              && Config::WRITE_CHECK_PERCENTAGE == 0, "Total balance is not conserved");
+					return total_balance == 2.0 * Config::NUM_CUSTOMER * Config::INITIAL_BALANCE;
+				}
+				return true;
+			}
+
 			template<class Executor>
 			bool do_initialize(Executor &executor, KeyType customer_id, float amount) {
 				SmallBankWorkloadEngine<Config, Executor> engine(&executor);
@@ -76,6 +76,10 @@ namespace workload {
 				}
 			}
 
+			[[nodiscard]] uint32_t get_type_tag_impl() const {
+				return static_cast<uint32_t>(type_);
+			}
+
 		};
 
 	}
@@ -36,17 +36,25 @@ namespace workload {
 			static_assert(OperationGeneratorConcept<RequestGenerator>);
 
 			// Aware: The order of table should be the same Enumeration of that.
+			// Small tables keyed by dense ids are indexed by direct-mapped arrays.
+			// Column groups of customer are stored as separate tables.
 			static constexpr std::initializer_list<TableScheme> TableSchemeSizeDefinition = {
-							TableScheme { sizeof(Item),         Config::NUM_ITEMS  },
-							TableScheme { sizeof(Warehouse),    Config::NUM_WAREHOUSES },
-							TableScheme { sizeof(District),     Config::NUM_WAREHOUSES * Config::DISTRICTS_PER_WAREHOUSE },
+							TableScheme { sizeof(Item),         Config::NUM_ITEMS, TableIndexHint::Direct },
+							TableScheme { sizeof(Warehouse),    Config::NUM_WAREHOUSES, TableIndexHint::Direct },
+							TableScheme { sizeof(District),     Config::NUM_WAREHOUSES * Config::DISTRICTS_PER_WAREHOUSE, TableIndexHint::Direct },
 							TableScheme { sizeof(Stock),        Config::NUM_WAREHOUSES * Config::NUM_ITEMS },
-							TableScheme { sizeof(Customer),     Config::NUM_WAREHOUSES * Config::DISTRICTS_PER_WAREHOUSE * Config::CUSTOMERS_PER_DISTRICT },
+							TableScheme { CustomerHotGroup::SIZE, Config::NUM_WAREHOUSES * Config::DISTRICTS_PER_WAREHOUSE * Config::CUSTOMERS_PER_DISTRICT },
 							TableScheme { sizeof(Order),        Config::NUM_WAREHOUSES * Config::DISTRICTS_PER_WAREHOUSE * Config::CUSTOMERS_PER_DISTRICT },
 							TableScheme { sizeof(OrderLine),    Config::NUM_WAREHOUSES * Config::DISTRICTS_PER_WAREHOUSE * Config::CUSTOMERS_PER_DISTRICT * Order::MAX_OL_CNT },
 							TableScheme { sizeof(NewOrder),     Config::NUM_WAREHOUSES * Config::DISTRICTS_PER_WAREHOUSE * Config::NEW_ORDER_PER_DISTRICT },
 							TableScheme { sizeof(History),      Config::NUM_WAREHOUSES * Config::DISTRICTS_PER_WAREHOUSE * Config::CUSTOMERS_PER_DISTRICT },
-							TableScheme { sizeof(NewOrderID),   Config::NUM_WAREHOUSES * Config::DISTRICTS_PER_WAREHOUSE }
+							TableScheme { sizeof(NewOrderID),   Config::NUM_WAREHOUSES * Config::DISTRICTS_PER_WAREHOUSE, TableIndexHint::Direct },
+							TableScheme { CustomerProfileGroup::SIZE, Config::NUM_WAREHOUSES * Config::DISTRICTS_PER_WAREHOUSE * Config::CUSTOMERS_PER_DISTRICT }
+			};
+
+			// Aware: The order of name should be the same Enumeration of transaction type.
+			static constexpr std::initializer_list<const char *> TransactionTypeNameDefinition = {
+							"StockLevel", "Delivery", "OrderStatus", "Payment", "NewOrder", "Initialize"
 			};
 
 			static constexpr bool COPY_STRING = ConfigManager::COPY_STRING;
@@ -91,6 +99,16 @@ namespace workload {
 				// Small vector, just return it.
 				return res_vec;
 			}
+
+			/*!
+			 * @brief Check consistency conditions of database, e.g. after recovery.
+			 * @param executor Executor from concurrent control, which is only used to read
+			 * @return Whether all conditions hold
+			 */
+			template<class Executor>
+			bool check_consistency(Executor &executor) {
+				return bench_executor_.do_check_consistency(executor);
+			}
 		};
 	}
 
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdio>
+#include <cmath>
 #include <cstdint>
 #include <algorithm>
 #include <vector>
@@ -224,7 +225,10 @@ namespace workload {
 					const Customer &c = *c_ptr;
 
 					if constexpr (FORMAL_OUTPUT) {
-						memcpy(output->c_last, c.c_last, sizeof(output->c_last));
+						const CustomerProfile *profile_ptr = find_customer_profile(warehouse_id, district_id, customer_id);
+						if (profile_ptr == nullptr) [[unlikely]] { return false; }
+
+						memcpy(output->c_last, profile_ptr->c_last, sizeof(output->c_last));
 						memcpy(output->c_credit, c.c_credit, sizeof(output->c_credit));
 						output->c_discount = c.c_discount;
 					}
@@ -414,6 +418,7 @@ namespace workload {
 						sizeof(Customer::c_balance) + offsetof(Customer, c_balance),
 						sizeof(Customer::c_ytd_payment) + std::max(offsetof(Customer, c_ytd_payment),
 					    sizeof(Customer::c_payment_cnt) + offsetof(Customer, c_payment_cnt))) - customer_update_offset;
+				static_assert(CustomerHotGroup::contain(customer_update_offset, customer_update_size));
 
 				Customer *customer_ptr = update_customer(c_warehouse_id, c_district_id, customer_id, customer_update_size, customer_update_offset);
 				if (customer_ptr == nullptr) [[unlikely]] { return false; }
@@ -423,7 +428,7 @@ namespace workload {
 						warehouse_id, district_id, c_warehouse_id, c_district_id, customer_id, h_amount,
 						now, output
 				)) [[unlikely]] { return false; }
-				internal_payment_remote(warehouse_id, district_id, customer, h_amount, output);
+				if (!internal_payment_remote(warehouse_id, district_id, customer, h_amount, output)) [[unlikely]] { return false; }
 				return true;
 			}
 
@@ -438,10 +443,11 @@ namespace workload {
 						offsetof(Customer, c_payment_cnt)
 				);
 				constexpr uint32_t customer_update_size   = util_macro::get_max_among(
-						offsetof(Customer, c_balance),
-						offsetof(Customer, c_ytd_payment),
-						offsetof(Customer, c_payment_cnt)
+						offsetof(Customer, c_balance) + sizeof(Customer::c_balance),
+						offsetof(Customer, c_ytd_payment) + sizeof(Customer::c_ytd_payment),
+						offsetof(Customer, c_payment_cnt) + sizeof(Customer::c_payment_cnt)
 				) - customer_update_offset;
+				static_assert(CustomerHotGroup::contain(customer_update_offset, customer_update_size));
 				Customer *customer_ptr = update_customer(temp_customer.c_w_id, temp_customer.c_d_id, temp_customer.c_id, customer_update_size, customer_update_offset);
 				if (customer_ptr == nullptr) [[unlikely]] { return false; }
 				Customer &customer = *customer_ptr;
@@ -450,7 +456,7 @@ namespace workload {
 						warehouse_id, district_id, c_warehouse_id, c_district_id, customer.c_id, h_amount,
 						now, output
 				)) [[unlikely]] { return false; }
-				internal_payment_remote(warehouse_id, district_id, customer, h_amount, output);
+				if (!internal_payment_remote(warehouse_id, district_id, customer, h_amount, output)) [[unlikely]] { return false; }
 
 				return true;
 			}
@@ -596,6 +602,7 @@ namespace workload {
 								offsetof(Customer, c_balance) + sizeof(Customer::c_balance),
 								offsetof(Customer, c_delivery_cnt) + sizeof(Customer::c_delivery_cnt)
 						) - customer_update_offset;
+						static_assert(CustomerHotGroup::contain(customer_update_offset, customer_update_size));
 
 						Customer *c_ptr = update_customer(warehouse_id, d_id, o.o_c_id, customer_update_size, customer_update_offset);
 						if (c_ptr == nullptr) [[unlikely]] { return false; }
@@ -609,9 +616,40 @@ namespace workload {
 				return true;
 			}
 
+			/*!
+			 * @brief Check consistency conditions of TPC-C (clause 3.3.2.1 and 3.3.2.2):
+			 * W_YTD = sum(D_YTD), and D_NEXT_O_ID - 1 is the largest order id of the district.
+			 * Year-to-date amounts are floats, so they are compared with a relative tolerance.
+			 * @return Whether all conditions hold
+			 */
+			bool check_consistency() {
+				for (int32_t w_id = 1; w_id <= static_cast<int32_t>(Config::NUM_WAREHOUSES); ++w_id) {
+					const Warehouse *w_ptr = find_warehouse(w_id);
+					if (w_ptr == nullptr) { return false; }
+
+					double d_ytd_sum = 0;
+					for (int32_t d_id = 1; d_id <= static_cast<int32_t>(Config::DISTRICTS_PER_WAREHOUSE); ++d_id) {
+						const District *d_ptr = find_district(w_id, d_id);
+						if (d_ptr == nullptr) { return false; }
+						d_ytd_sum += d_ptr->d_ytd;
+
+						if constexpr (DO_INSERT_REMOVE) {
+							if (find_order(w_id, d_id, d_ptr->d_next_o_id - 1) == nullptr) { return false; }
+							if (find_order(w_id, d_id, d_ptr->d_next_o_id) != nullptr) { return false; }
+						}
+					}
+					if (!is_ytd_consistent(w_ptr->w_ytd, d_ytd_sum)) { return false; }
+				}
+				return true;
+			}
+
 		private:
 			static const int STOCK_LEVEL_ORDERS = 20;
 
+			static bool is_ytd_consistent(double w_ytd, double d_ytd_sum) {
+				return std::abs(w_ytd - d_ytd_sum) <= std::max(1.0, std::abs(w_ytd) * 1e-5);
+			}
+
 			// Loads each item from the items table. Returns true if they are all found.
 			bool find_and_validate_items(const auto item_iter_begin, const auto item_iter_end,
 			                             auto item_tuple_iter) {
@@ -628,12 +666,16 @@ namespace workload {
 			// Implements order status transaction after the customer tuple has been located.
 			bool internal_order_status(const Customer &customer, OrderStatusOutput* output) {
 				if constexpr (FORMAL_OUTPUT) {
+					const CustomerProfile *profile_ptr = find_customer_profile(customer.c_w_id, customer.c_d_id, customer.c_id);
+					if (profile_ptr == nullptr) [[unlikely]] { return false; }
+					const CustomerProfile &profile = *profile_ptr;
+
 					output->c_id = customer.c_id;
 					// retrieve from customer: balance, first, middle, last
 					output->c_balance = customer.c_balance;
-					strcpy(output->c_first, customer.c_first);
-					strcpy(output->c_middle, customer.c_middle);
-					strcpy(output->c_last, customer.c_last);
+					strcpy(output->c_first, profile.c_first);
+					strcpy(output->c_middle, profile.c_middle);
+					strcpy(output->c_last, profile.c_last);
 				}
 
 				// Find the row in the order table with largest o_id
@@ -667,16 +709,23 @@ namespace workload {
 				return true;
 			}
 
-			// Implements payment transaction after the customer tuple has been located.
-			void internal_payment_remote(int32_t warehouse_id, int32_t district_id, Customer &c,
+			// Implements payment transaction after the hot group of customer tuple has been located.
+			bool internal_payment_remote(int32_t warehouse_id, int32_t district_id, Customer &c,
 			                             float h_amount, PaymentOutput* output) {
 				c.c_balance     -= h_amount;
 				c.c_ytd_payment += h_amount;
 				c.c_payment_cnt += 1;
 
+				const char *new_c_data = nullptr;
 				if constexpr (COPY_STRING) {
 					if (strcmp(c.c_credit, Customer::BAD_CREDIT) == 0) {
-						// Bad credit: insert history into c_data
+						// Bad credit: insert history into c_data, which lies in the profile group
+						CustomerProfile *profile_ptr = update_customer_profile(c.c_w_id, c.c_d_id, c.c_id,
+						                                                       sizeof(CustomerProfile::c_data), offsetof(CustomerProfile, c_data));
+						if (profile_ptr == nullptr) [[unlikely]] { return false; }
+						char *c_data = profile_ptr->c_data;
+						new_c_data   = c_data;
+
 						static constexpr int HISTORY_SIZE = Customer::MAX_DATA + 1;
 
 						char history[HISTORY_SIZE];
@@ -685,36 +734,42 @@ namespace workload {
 						DEBUG_ASSERT(characters < HISTORY_SIZE);
 
 						// Perform the insert with a move and copy
-						int current_keep = static_cast<int>(strlen(c.c_data));
+						int current_keep = static_cast<int>(strlen(c_data));
 						if (current_keep + characters > Customer::MAX_DATA) {
 							current_keep = Customer::MAX_DATA - characters;
 						}
 						DEBUG_ASSERT(current_keep + characters <= Customer::MAX_DATA);
-						memmove(c.c_data+characters, c.c_data, current_keep);
-						memcpy(c.c_data, history, characters);
-						c.c_data[characters + current_keep] = '\0';
-						DEBUG_ASSERT(strlen(c.c_data) == static_cast<size_t>(characters) + current_keep);
+						memmove(c_data+characters, c_data, current_keep);
+						memcpy(c_data, history, characters);
+						c_data[characters + current_keep] = '\0';
+						DEBUG_ASSERT(strlen(c_data) == static_cast<size_t>(characters) + current_keep);
 					}
 				}
 
 				if constexpr (FORMAL_OUTPUT) {
+					const CustomerProfile *profile_ptr = find_customer_profile(c.c_w_id, c.c_d_id, c.c_id);
+					if (profile_ptr == nullptr) [[unlikely]] { return false; }
+					const CustomerProfile &profile = *profile_ptr;
+					if (new_c_data == nullptr) { new_c_data = profile.c_data; }
+
 					output->c_credit_lim = c.c_credit_lim;
 					output->c_discount   = c.c_discount;
 					output->c_balance    = c.c_balance;
-					memcpy(output->c_first, c.c_first, sizeof(output->c_first));
-					memcpy(output->c_middle, c.c_middle, sizeof(output->c_middle));
-					memcpy(output->c_last, c.c_last, sizeof(output->c_last));
-					memcpy(output->c_phone, c.c_phone, sizeof(output->c_phone));
-					memcpy(output->c_since, c.c_since, sizeof(output->c_since));
+					memcpy(output->c_first, profile.c_first, sizeof(output->c_first));
+					memcpy(output->c_middle, profile.c_middle, sizeof(output->c_middle));
+					memcpy(output->c_last, profile.c_last, sizeof(output->c_last));
+					memcpy(output->c_phone, profile.c_phone, sizeof(output->c_phone));
+					memcpy(output->c_since, profile.c_since, sizeof(output->c_since));
 					memcpy(output->c_credit, c.c_credit, sizeof(output->c_credit));
-					memcpy(output->c_data, c.c_data, sizeof(output->c_data));
+					memcpy(output->c_data, new_c_data, sizeof(output->c_data));
 
 					Address::copy(
 							output->c_street_1, output->c_street_2, output->c_city,
 							output->c_state, output->c_zip,
-							c.c_street_1, c.c_street_2, c.c_city,
-							c.c_state, c.c_zip);
+							profile.c_street_1, profile.c_street_2, profile.c_city,
+							profile.c_state, profile.c_zip);
 				}
+				return true;
 			}
 
 		private:
@@ -755,6 +810,15 @@ namespace workload {
 				return find_customer(TPCCKeyMaker::make_customer_key(w_id, d_id, c_id));
 			}
 
+			const CustomerProfile *find_customer_profile(int64_t num_key) {
+				TPCCKey key(DurableTable::CustomerProfile, num_key);
+				return executor_ptr_->template read<CustomerProfile>(key);
+			}
+
+			const CustomerProfile *find_customer_profile(int32_t w_id, int32_t d_id, int32_t c_id) {
+				return find_customer_profile(TPCCKeyMaker::make_customer_key(w_id, d_id, c_id));
+			}
+
 			const Order *find_order(int64_t num_key) {
 				TPCCKey key(DurableTable::Order, num_key);
 				return executor_ptr_->template read<Order>(key);
@@ -856,9 +920,13 @@ namespace workload {
 			bool insert_customer(const Customer& customer) {
 				second_index_ptr_->insert_customer_by_name(customer);
 
+				const int64_t customer_key = TPCCKeyMaker::make_customer_key(customer.c_w_id, customer.c_d_id, customer.c_id);
 				return executor_ptr_->insert(
-						TPCCKey(DurableTable::Customer, TPCCKeyMaker::make_customer_key(customer.c_w_id, customer.c_d_id, customer.c_id)),
-						&customer, sizeof(Customer)
+						TPCCKey(DurableTable::Customer, customer_key),
+						&customer, CustomerHotGroup::SIZE
+				) && executor_ptr_->insert(
+						TPCCKey(DurableTable::CustomerProfile, customer_key),
+						reinterpret_cast<const uint8_t *>(&customer) + CustomerProfileGroup::OFFSET, CustomerProfileGroup::SIZE
 				);
 			}
 
@@ -1016,7 +1084,9 @@ namespace workload {
 				return update_district(TPCCKeyMaker::make_district_key(w_id, d_id), size, offset);
 			}
 
+			// Only columns of the hot group are valid in the returned tuple.
 			Customer *update_customer(int64_t num_key, uint32_t size, uint32_t offset) {
+				DEBUG_ASSERT(CustomerHotGroup::contain(offset, size));
 				TPCCKey key(DurableTable::Customer, num_key);
 				return executor_ptr_->template update<Customer>(key, size, offset);
 			}
@@ -1025,6 +1095,15 @@ namespace workload {
 				return update_customer(TPCCKeyMaker::make_customer_key(w_id, d_id, c_id), size, offset);
 			}
 
+			CustomerProfile *update_customer_profile(int64_t num_key, uint32_t size, uint32_t offset) {
+				TPCCKey key(DurableTable::CustomerProfile, num_key);
+				return executor_ptr_->template update<CustomerProfile>(key, size, offset);
+			}
+
+			CustomerProfile *update_customer_profile(int32_t w_id, int32_t d_id, int32_t c_id, uint32_t size, uint32_t offset) {
+				return update_customer_profile(TPCCKeyMaker::make_customer_key(w_id, d_id, c_id), size, offset);
+			}
+
 			Order *update_order(int64_t num_key, uint32_t size, uint32_t offset) {
 				TPCCKey key(DurableTable::Order, num_key);
 				return executor_ptr_->template update<Order>(key, size, offset);
@@ -1168,6 +1247,9 @@ namespace workload {
 				Customer c;
 				bool customer_exist = find_customer(warehouse_id, district_id, customer_id, c);
 				if (!customer_exist) [[unlikely]] { return false; }
+				if constexpr (FORMAL_OUTPUT) {
+					if (!find_customer_profile(warehouse_id, district_id, customer_id, c)) [[unlikely]] { return false; }
+				}
 				return internal_order_status(c, output);
 			}
 
@@ -1178,6 +1260,9 @@ namespace workload {
 				Customer c;
 				bool customer_exist = find_customer(warehouse_id, district_id, c_iden.c_id, c);
 				if (!customer_exist) [[unlikely]] { return false; }
+				if constexpr (FORMAL_OUTPUT) {
+					if (!find_customer_profile(warehouse_id, district_id, c_iden.c_id, c)) [[unlikely]] { return false; }
+				}
 
 				return internal_order_status(c, output);
 			}
@@ -1202,6 +1287,8 @@ namespace workload {
 					if (!customer_exist) [[unlikely]] { return false; }
 
 					if constexpr (FORMAL_OUTPUT) {
+						if (!find_customer_profile(warehouse_id, district_id, customer_id, c)) [[unlikely]] { return false; }
+
 						memcpy(output->c_last, c.c_last, sizeof(output->c_last));
 						memcpy(output->c_credit, c.c_credit, sizeof(output->c_credit));
 						output->c_discount = c.c_discount;
@@ -1381,6 +1468,9 @@ namespace workload {
 				Customer customer;
 				bool customer_exist = find_customer(c_warehouse_id, c_district_id, customer_id, customer);
 				if (!customer_exist) [[unlikely]] { return false; }
+				// The profile group is only touched by output and customers with bad credit
+				const bool touch_profile = FORMAL_OUTPUT || (COPY_STRING && strcmp(customer.c_credit, Customer::BAD_CREDIT) == 0);
+				if (touch_profile && !find_customer_profile(c_warehouse_id, c_district_id, customer_id, customer)) [[unlikely]] { return false; }
 
 				if (!payment_local(
 						warehouse_id, district_id, c_warehouse_id, c_district_id, customer_id, h_amount,
@@ -1390,6 +1480,9 @@ namespace workload {
 
 				bool customer_update_success = update_customer(c_warehouse_id, c_district_id, customer_id, customer);
 				if (!customer_update_success) { return false; }
+				if (COPY_STRING && strcmp(customer.c_credit, Customer::BAD_CREDIT) == 0) {
+					if (!update_customer_profile(c_warehouse_id, c_district_id, customer_id, customer)) { return false; }
+				}
 
 				return true;
 			}
@@ -1402,6 +1495,9 @@ namespace workload {
 				Customer customer;
 				bool customer_exist = find_customer(temp_customer.c_w_id, temp_customer.c_d_id, temp_customer.c_id, customer);
 				if (!customer_exist) [[unlikely]] { return false; }
+				// The profile group is only touched by output and customers with bad credit
+				const bool touch_profile = FORMAL_OUTPUT || (COPY_STRING && strcmp(customer.c_credit, Customer::BAD_CREDIT) == 0);
+				if (touch_profile && !find_customer_profile(temp_customer.c_w_id, temp_customer.c_d_id, temp_customer.c_id, customer)) [[unlikely]] { return false; }
 
 				if (!payment_local(
 						warehouse_id, district_id, c_warehouse_id, c_district_id, customer.c_id, h_amount,
@@ -1411,6 +1507,9 @@ namespace workload {
 
 				bool customer_update_success = update_customer(temp_customer.c_w_id, temp_customer.c_d_id, temp_customer.c_id, customer);
 				if (!customer_update_success) { return false; }
+				if (COPY_STRING && strcmp(customer.c_credit, Customer::BAD_CREDIT) == 0) {
+					if (!update_customer_profile(temp_customer.c_w_id, temp_customer.c_d_id, temp_customer.c_id, customer)) { return false; }
+				}
 
 				return true;
 			}
@@ -1571,9 +1670,41 @@ namespace workload {
 				return true;
 			}
 
+			/*!
+			 * @brief Check consistency conditions of TPC-C (clause 3.3.2.1 and 3.3.2.2):
+			 * W_YTD = sum(D_YTD), and D_NEXT_O_ID - 1 is the largest order id of the district.
+			 * Year-to-date amounts are floats, so they are compared with a relative tolerance.
+			 * @return Whether all conditions hold
+			 */
+			bool check_consistency() {
+				for (int32_t w_id = 1; w_id <= static_cast<int32_t>(Config::NUM_WAREHOUSES); ++w_id) {
+					Warehouse w;
+					if (!find_warehouse(w_id, w)) { return false; }
+
+					double d_ytd_sum = 0;
+					for (int32_t d_id = 1; d_id <= static_cast<int32_t>(Config::DISTRICTS_PER_WAREHOUSE); ++d_id) {
+						District d;
+						if (!find_district(w_id, d_id, d)) { return false; }
+						d_ytd_sum += d.d_ytd;
+
+						if constexpr (DO_INSERT_REMOVE) {
+							Order o;
+							if (!find_order(w_id, d_id, d.d_next_o_id - 1, o)) { return false; }
+							if (find_order(w_id, d_id, d.d_next_o_id, o)) { return false; }
+						}
+					}
+					if (!is_ytd_consistent(w.w_ytd, d_ytd_sum)) { return false; }
+				}
+				return true;
+			}
+
 		private:
 			static const int STOCK_LEVEL_ORDERS = 20;
 
+			static bool is_ytd_consistent(double w_ytd, double d_ytd_sum) {
+				return std::abs(w_ytd - d_ytd_sum) <= std::max(1.0, std::abs(w_ytd) * 1e-5);
+			}
+
 			// Loads each item from the items table. Returns true if they are all found.
 			bool find_and_validate_items(const auto item_iter_begin, const auto item_iter_end,
 			                             auto item_tuple_iter) {
@@ -1710,15 +1841,26 @@ namespace workload {
 				return find_district(TPCCKeyMaker::make_district_key(w_id, d_id), district);
 			}
 
+			// Only fill columns of the hot group.
 			bool find_customer(int64_t num_key, Customer &customer) {
 				TPCCKey key(DurableTable::Customer, num_key);
-				return executor_ptr_->read(key, &customer, sizeof(Customer), 0);
+				return executor_ptr_->read(key, &customer, CustomerHotGroup::SIZE, 0);
 			}
 
 			bool find_customer(int32_t w_id, int32_t d_id, int32_t c_id, Customer &customer) {
 				return find_customer(TPCCKeyMaker::make_customer_key(w_id, d_id, c_id), customer);
 			}
 
+			// Only fill columns of the profile group.
+			bool find_customer_profile(int64_t num_key, Customer &customer) {
+				TPCCKey key(DurableTable::CustomerProfile, num_key);
+				return executor_ptr_->read(key, reinterpret_cast<uint8_t *>(&customer) + CustomerProfileGroup::OFFSET, CustomerProfileGroup::SIZE, 0);
+			}
+
+			bool find_customer_profile(int32_t w_id, int32_t d_id, int32_t c_id, Customer &customer) {
+				return find_customer_profile(TPCCKeyMaker::make_customer_key(w_id, d_id, c_id), customer);
+			}
+
 			bool find_order(int64_t num_key, Order &order) {
 				TPCCKey key(DurableTable::Order, num_key);
 				return executor_ptr_->read(key, &order, sizeof(Order), 0);
@@ -1820,9 +1962,13 @@ namespace workload {
 			bool insert_customer(const Customer& customer) {
 				second_index_ptr_->insert_customer_by_name(customer);
 
+				const int64_t customer_key = TPCCKeyMaker::make_customer_key(customer.c_w_id, customer.c_d_id, customer.c_id);
 				return executor_ptr_->insert(
-						TPCCKey(DurableTable::Customer, TPCCKeyMaker::make_customer_key(customer.c_w_id, customer.c_d_id, customer.c_id)),
-						&customer, sizeof(Customer)
+						TPCCKey(DurableTable::Customer, customer_key),
+						&customer, CustomerHotGroup::SIZE
+				) && executor_ptr_->insert(
+						TPCCKey(DurableTable::CustomerProfile, customer_key),
+						reinterpret_cast<const uint8_t *>(&customer) + CustomerProfileGroup::OFFSET, CustomerProfileGroup::SIZE
 				);
 			}
 
@@ -1905,15 +2051,26 @@ namespace workload {
 				return update_district(TPCCKeyMaker::make_district_key(w_id, d_id), district);
 			}
 
+			// Only write columns of the hot group.
 			bool update_customer(int64_t num_key, const Customer &customer) {
 				TPCCKey key(DurableTable::Customer, num_key);
-				return executor_ptr_->update(key, &customer, sizeof(Customer), 0);
+				return executor_ptr_->update(key, &customer, CustomerHotGroup::SIZE, 0);
 			}
 
 			bool update_customer(int32_t w_id, int32_t d_id, int32_t c_id, const Customer &customer) {
 				return update_customer(TPCCKeyMaker::make_customer_key(w_id, d_id, c_id), customer);
 			}
 
+			// Only write columns of the profile group.
+			bool update_customer_profile(int64_t num_key, const Customer &customer) {
+				TPCCKey key(DurableTable::CustomerProfile, num_key);
+				return executor_ptr_->update(key, reinterpret_cast<const uint8_t *>(&customer) + CustomerProfileGroup::OFFSET, CustomerProfileGroup::SIZE, 0);
+			}
+
+			bool update_customer_profile(int32_t w_id, int32_t d_id, int32_t c_id, const Customer &customer) {
+				return update_customer_profile(TPCCKeyMaker::make_customer_key(w_id, d_id, c_id), customer);
+			}
+
 			bool update_order(int64_t num_key, const Order &order) {
 				TPCCKey key(DurableTable::Order, num_key);
 				return executor_ptr_->update(key, &order, sizeof(Order), 0);
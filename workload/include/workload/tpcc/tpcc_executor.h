@@ -125,6 +125,17 @@ namespace workload {
 				return db_.stock_level(generate_warehouse_id(), generate_district_id(), threshold);
 			}
 
+			/*!
+			 * @brief Check consistency conditions of database
+			 * @return Whether all conditions hold
+			 */
+			template<class Executor>
+			bool do_check_consistency(Executor &executor) {
+				TPCCWorkloadEngine<Config, Executor> db_(&executor, &secondary_index_);
+
+				return db_.check_consistency();
+			}
+
 			template<class Executor>
 			bool do_order_status(Executor &executor) {
 				TPCCWorkloadEngine<Config, Executor> db_(&executor, &secondary_index_);
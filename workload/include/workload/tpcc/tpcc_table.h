@@ -6,9 +6,12 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <cstring>
 #include <vector>
 
+#include <workload/abstract_workload.h>
+
 namespace workload {
 
 	struct Address {
@@ -151,6 +154,8 @@ namespace workload {
 		float c_ytd_payment;
 		int32_t c_payment_cnt;
 		int32_t c_delivery_cnt;
+		char c_credit[CREDIT+1];
+		// Columns below are stored in the profile group
 		char c_first[MAX_FIRST+1];
 		char c_middle[MIDDLE+1];
 		char c_last[MAX_LAST+1];
@@ -161,10 +166,50 @@ namespace workload {
 		char c_zip[Address::ZIP+1];
 		char c_phone[PHONE+1];
 		char c_since[DATETIME_SIZE];
-		char c_credit[CREDIT+1];
 		char c_data[MAX_DATA+1];
 	};
 
+	/*!
+	 * @brief Customer is vertically partitioned into two column groups.
+	 * Payment and delivery only touch the balance and counters at the head of tuple,
+	 * while names, addresses and c_data are read by outputs and bad-credit payments only.
+	 */
+	using CustomerHotGroup     = ColumnGroup<0, offsetof(Customer, c_first)>;
+	using CustomerProfileGroup = ColumnGroup<offsetof(Customer, c_first), sizeof(Customer) - offsetof(Customer, c_first)>;
+
+	//! @brief Tuple of the profile group, laid out as the columns from c_first on of Customer.
+	struct CustomerProfile {
+		char c_first[Customer::MAX_FIRST+1];
+		char c_middle[Customer::MIDDLE+1];
+		char c_last[Customer::MAX_LAST+1];
+		char c_street_1[Address::MAX_STREET+1];
+		char c_street_2[Address::MAX_STREET+1];
+		char c_city[Address::MAX_CITY+1];
+		char c_state[Address::STATE+1];
+		char c_zip[Address::ZIP+1];
+		char c_phone[Customer::PHONE+1];
+		char c_since[DATETIME_SIZE];
+		char c_data[Customer::MAX_DATA+1];
+	};
+
+#define CUSTOMER_PROFILE_COLUMN_MATCH(column) \
+	static_assert(offsetof(Customer, column) == CustomerProfileGroup::OFFSET + offsetof(CustomerProfile, column))
+
+	CUSTOMER_PROFILE_COLUMN_MATCH(c_first);
+	CUSTOMER_PROFILE_COLUMN_MATCH(c_middle);
+	CUSTOMER_PROFILE_COLUMN_MATCH(c_last);
+	CUSTOMER_PROFILE_COLUMN_MATCH(c_street_1);
+	CUSTOMER_PROFILE_COLUMN_MATCH(c_street_2);
+	CUSTOMER_PROFILE_COLUMN_MATCH(c_city);
+	CUSTOMER_PROFILE_COLUMN_MATCH(c_state);
+	CUSTOMER_PROFILE_COLUMN_MATCH(c_zip);
+	CUSTOMER_PROFILE_COLUMN_MATCH(c_phone);
+	CUSTOMER_PROFILE_COLUMN_MATCH(c_since);
+	CUSTOMER_PROFILE_COLUMN_MATCH(c_data);
+	static_assert(sizeof(CustomerProfile) <= CustomerProfileGroup::SIZE);
+
+#undef CUSTOMER_PROFILE_COLUMN_MATCH
+
 	struct CustomerNameIdentify {
 		static constexpr int MAX_FIRST = Customer::MAX_FIRST;
 		static constexpr int MAX_LAST  = Customer::MAX_LAST;
@@ -372,7 +417,9 @@ namespace workload {
 		NewOrder  = 7,
 		History   = 8,
 		// Not standard
-		NewOrderID = 9
+		NewOrderID = 9,
+		// Profile column group of customer
+		CustomerProfile = 10
 	};
 
 }
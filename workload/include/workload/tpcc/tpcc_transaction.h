@@ -70,6 +70,10 @@ namespace workload {
 						return false;
 				}
 			}
+
+			[[nodiscard]] uint32_t get_type_tag_impl() const {
+				return static_cast<uint32_t>(type_);
+			}
 		};
 	}
 
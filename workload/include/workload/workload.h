@@ -25,7 +25,9 @@ namespace workload {
 		ReadMostly,
 		WriteIntensive,
 		WriteMostly,
-		SmallBank
+		VariableLength,
+		SmallBank,
+		SmallBank_Transfer
 	};
 
 
@@ -140,6 +142,15 @@ namespace workload {
 		static_assert(WorkloadConcept<Workload>);
 	};
 
+	template<>
+	struct WorkloadManager<WorkloadType::VariableLength> {
+		using WorkloadConfig = YCSBConfig<YCSBConfigType::VariableLength>;
+
+		using Workload       = YCSB<WorkloadConfig>;
+
+		static_assert(WorkloadConcept<Workload>);
+	};
+
 	template<>
 	struct WorkloadManager<WorkloadType::SmallBank> {
 		using WorkloadConfig = SmallBankConfig<SmallBankConfigType::Normal>;
@@ -148,4 +159,13 @@ namespace workload {
 
 		static_assert(WorkloadConcept<Workload>);
 	};
+
+	template<>
+	struct WorkloadManager<WorkloadType::SmallBank_Transfer> {
+		using WorkloadConfig = SmallBankConfig<SmallBankConfigType::Transfer>;
+
+		using Workload       = SmallBank<WorkloadConfig>;
+
+		static_assert(WorkloadConcept<Workload>);
+	};
 }
@@ -41,6 +41,8 @@ namespace workload {
 		static constexpr uint32_t ALL_FIELD    = std::numeric_limits<uint32_t>::max();
 		static constexpr uint32_t INITIAL_SIZE = Config::INITIAL_SIZE;
 
+		static constexpr bool VARIABLE_LENGTH_TUPLE = Config::VARIABLE_LENGTH_TUPLE;
+
 		static constexpr std::initializer_list<TableScheme> TableSchemeSizeDefinition = {
 				TableScheme {  sizeof(RowType), Config::TABLE_SIZE }
 		};
@@ -146,11 +148,13 @@ namespace workload {
 			if constexpr (Config::WRITE_ALL_FIELD || Config::FIELD_COUNT == 1) {
 				// Update all fields
 				RowType new_row;
+				uint32_t payload_size = 0;
 				for (uint32_t i = 0; i < Config::FIELD_COUNT; ++i) {
 					auto field_length = field_length_generator_.get_next();
 					random_value_generator_.get_next(new_row.elements[i].get_data(), field_length);
+					payload_size = i * sizeof(ValueType) + field_length;
 				}
-				return Transaction::get_update_tx(key, ALL_FIELD, new_row);
+				return fit_payload(Transaction::get_update_tx(key, ALL_FIELD, new_row), payload_size);
 			}
 			else {
 				// Update a random field
@@ -159,7 +163,7 @@ namespace workload {
 				auto field_length = field_length_generator_.get_next();
 				random_value_generator_.get_next(new_row.elements[field].get_data(), field_length);
 
-				return Transaction::get_update_tx(key, field, new_row);
+				return fit_payload(Transaction::get_update_tx(key, field, new_row), field_length);
 			}
 		}
 
@@ -169,11 +173,13 @@ namespace workload {
 			KeyType key = step_key_generator_.get_next();
 			// Write all fields
 			RowType new_row;
+			uint32_t payload_size = 0;
 			for (uint32_t i = 0; i < Config::FIELD_COUNT; ++i) {
 				auto field_length = field_length_generator_.get_next();
 				random_value_generator_.get_next(new_row.elements[i].get_data(), field_length);
+				payload_size = i * sizeof(ValueType) + field_length;
 			}
-			return Transaction::get_insert_tx(get_hashed_key(key), key, new_row, &step_key_generator_);
+			return fit_payload(Transaction::get_insert_tx(get_hashed_key(key), key, new_row, &step_key_generator_), payload_size);
 		}
 
 		//! Generate transaction of scan
@@ -203,11 +209,13 @@ namespace workload {
 			if constexpr (Config::WRITE_ALL_FIELD || Config::FIELD_COUNT == 1) {
 				// Update all fields
 				RowType new_row;
+				uint32_t payload_size = 0;
 				for (uint32_t i = 0; i < Config::FIELD_COUNT; ++i) {
 					auto field_length = field_length_generator_.get_next();
 					random_value_generator_.get_next(new_row.elements[i].get_data(), field_length);
+					payload_size = i * sizeof(ValueType) + field_length;
 				}
-				return Transaction::get_update_tx(key, ALL_FIELD, new_row);
+				return fit_payload(Transaction::get_update_tx(key, ALL_FIELD, new_row), payload_size);
 			}
 			else {
 				// Update a random field
@@ -216,11 +224,19 @@ namespace workload {
 				auto field_length = field_length_generator_.get_next();
 				random_value_generator_.get_next(new_row.elements[field].get_data(), field_length);
 
-				return Transaction::get_update_tx(key, field, new_row);
+				return fit_payload(Transaction::get_update_tx(key, field, new_row), field_length);
 			}
 		}
 
 	private:
+		//! @brief Trim the payload of write to its generated length if tuples are variable-length.
+		static Transaction fit_payload(Transaction &&tx, uint32_t payload_size) {
+			if constexpr (VARIABLE_LENGTH_TUPLE) {
+				tx.set_payload_size(payload_size);
+			}
+			return tx;
+		}
+
 		KeyType get_hashed_key(const KeyType &key) {
 			if constexpr (Config::INSERT_ORDER == YCSBConfigOrder::Hashed) {
 				return util::hash(key);
@@ -19,7 +19,7 @@ namespace workload {
 			ReadModifyWrite = 4
 		};
 
-		enum class YCSBConfigType { A, B, C, D, E, F, ReadMostly, WriteIntensive, WriteMostly };
+		enum class YCSBConfigType { A, B, C, D, E, F, ReadMostly, WriteIntensive, WriteMostly, VariableLength };
 
 		enum class YCSBConfigGenerator { Zipfian, Uniform, Constant, HotPos, Latest };
 
@@ -74,6 +74,8 @@ namespace workload {
 			static constexpr uint32_t INSERTION_RETRY_LIMIT                = 0;
 			/// On average, how long to wait between the retries, in seconds.
 			static constexpr uint32_t INSERTION_RETRY_INTERVAL             = 3;
+			/// Whether tuples are stored by the actual length of payload instead of the maximum
+			static constexpr bool VARIABLE_LENGTH_TUPLE                    = false;
 		};
 
 
@@ -123,6 +125,8 @@ namespace workload {
 			static constexpr uint32_t INSERTION_RETRY_LIMIT                = 0;
 			/// On average, how long to wait between the retries, in seconds.
 			static constexpr uint32_t INSERTION_RETRY_INTERVAL             = 3;
+			/// Whether tuples are stored by the actual length of payload instead of the maximum
+			static constexpr bool VARIABLE_LENGTH_TUPLE                    = false;
 		};
 
 
@@ -172,6 +176,8 @@ namespace workload {
 			static constexpr uint32_t INSERTION_RETRY_LIMIT                = 0;
 			/// On average, how long to wait between the retries, in seconds.
 			static constexpr uint32_t INSERTION_RETRY_INTERVAL             = 3;
+			/// Whether tuples are stored by the actual length of payload instead of the maximum
+			static constexpr bool VARIABLE_LENGTH_TUPLE                    = false;
 		};
 
 
@@ -221,6 +227,8 @@ namespace workload {
 			static constexpr uint32_t INSERTION_RETRY_LIMIT                = 0;
 			/// On average, how long to wait between the retries, in seconds.
 			static constexpr uint32_t INSERTION_RETRY_INTERVAL             = 3;
+			/// Whether tuples are stored by the actual length of payload instead of the maximum
+			static constexpr bool VARIABLE_LENGTH_TUPLE                    = false;
 		};
 
 
@@ -270,6 +278,8 @@ namespace workload {
 			static constexpr uint32_t INSERTION_RETRY_LIMIT                = 0;
 			/// On average, how long to wait between the retries, in seconds.
 			static constexpr uint32_t INSERTION_RETRY_INTERVAL             = 3;
+			/// Whether tuples are stored by the actual length of payload instead of the maximum
+			static constexpr bool VARIABLE_LENGTH_TUPLE                    = false;
 		};
 
 		template<>
@@ -318,6 +328,8 @@ namespace workload {
 			static constexpr uint32_t INSERTION_RETRY_LIMIT                = 0;
 			/// On average, how long to wait between the retries, in seconds.
 			static constexpr uint32_t INSERTION_RETRY_INTERVAL             = 3;
+			/// Whether tuples are stored by the actual length of payload instead of the maximum
+			static constexpr bool VARIABLE_LENGTH_TUPLE                    = false;
 		};
 
 		template<>
@@ -366,6 +378,8 @@ namespace workload {
 			static constexpr uint32_t INSERTION_RETRY_LIMIT                = 0;
 			/// On average, how long to wait between the retries, in seconds.
 			static constexpr uint32_t INSERTION_RETRY_INTERVAL             = 3;
+			/// Whether tuples are stored by the actual length of payload instead of the maximum
+			static constexpr bool VARIABLE_LENGTH_TUPLE                    = false;
 		};
 
 		template<>
@@ -414,6 +428,8 @@ namespace workload {
 			static constexpr uint32_t INSERTION_RETRY_LIMIT                = 0;
 			/// On average, how long to wait between the retries, in seconds.
 			static constexpr uint32_t INSERTION_RETRY_INTERVAL             = 3;
+			/// Whether tuples are stored by the actual length of payload instead of the maximum
+			static constexpr bool VARIABLE_LENGTH_TUPLE                    = false;
 		};
 
 		template<>
@@ -462,6 +478,58 @@ namespace workload {
 			static constexpr uint32_t INSERTION_RETRY_LIMIT                = 0;
 			/// On average, how long to wait between the retries, in seconds.
 			static constexpr uint32_t INSERTION_RETRY_INTERVAL             = 3;
+			/// Whether tuples are stored by the actual length of payload instead of the maximum
+			static constexpr bool VARIABLE_LENGTH_TUPLE                    = false;
+		};
+
+		template<>
+		struct YCSBConfig<YCSBConfigType::VariableLength> {
+
+			static constexpr uint64_t TABLE_SIZE                           = 1024 * 1024;
+
+			static constexpr uint32_t INITIAL_SIZE                         = TABLE_SIZE;
+			/// Number of fields in a record
+			static constexpr uint32_t FIELD_COUNT                          = 1;
+			/// The field length distribution.
+			static constexpr YCSBConfigGenerator FIELD_LENGTH_DISTRIBUTION = YCSBConfigGenerator::Uniform;
+			/// The maximum length of a field in bytes
+			static constexpr uint32_t MAX_FIELD_LENGTH                     = 1024;
+			/// The minimum length of a field in bytes
+			static constexpr uint32_t MIN_FIELD_LENGTH                     = 1;
+			/// whether to read one field (false) or all fields (true) of a record
+			static constexpr bool READ_ALL_FIELD                           = false;
+			/// whether to write one field (false) or all fields (true) of a record
+			static constexpr bool WRITE_ALL_FIELD                          = false;
+			/// The property of read request.
+			static constexpr uint32_t READ_PERCENTAGE                      = 50;
+			/// The property of write request.
+			static constexpr uint32_t UPDATE_PERCENTAGE                    = 50;
+			/// The property of insert request.
+			static constexpr uint32_t INSERT_PERCENTAGE                    = 0;
+			/// The property of scan request.
+			static constexpr uint32_t SCAN_PERCENTAGE                      = 0;
+			/// The property of read-modify-write request.
+			static constexpr uint32_t READ_MODIFY_WRITE_PERCENTAGE         = 0;
+			/// The distribution of requests across the keyspace.
+			static constexpr YCSBConfigGenerator REQUEST_DISTRIBUTION      = YCSBConfigGenerator::Zipfian;
+			/// The minimum length of scanning in bytes
+			static constexpr uint32_t MAX_SCAN_LENGTH                      = 1000;
+			/// The maximum length of scanning in bytes
+			static constexpr uint32_t MIN_SCAN_LENGTH                      = 1;
+			/// The distribution of the scan length
+			static constexpr YCSBConfigGenerator SCAN_LENGTH_DISTRIBUTION  = YCSBConfigGenerator::Uniform;
+			/// The order of insert records
+			static constexpr YCSBConfigOrder INSERT_ORDER                  = YCSBConfigOrder::Ordered;
+			/// The size of hot set
+			static constexpr uint32_t HOTSPOT_DATA_FRACTION                = 20;
+			/// The percentage operations accessing the hot set.
+			static constexpr uint32_t HOTSPOT_OPN_FRACTION                 = 80;
+			/// How many times to retry when insertion of a single item fails.
+			static constexpr uint32_t INSERTION_RETRY_LIMIT                = 0;
+			/// On average, how long to wait between the retries, in seconds.
+			static constexpr uint32_t INSERTION_RETRY_INTERVAL             = 3;
+			/// Whether tuples are stored by the actual length of payload instead of the maximum
+			static constexpr bool VARIABLE_LENGTH_TUPLE                    = true;
 		};
 
 	}
@@ -27,10 +27,14 @@ namespace workload {
 		uint32_t            scan_length_;
 		Row                 row_;
 		Key                 origin_key_;
+		/// The actual length of payload written, 0 for the whole field
+		uint32_t            payload_size_ = 0;
 
 	public:
 		std::pair<uint32_t, uint32_t> get_offset() {
-			return row_.get_size_and_offset(field_);
+			auto [size, offset] = row_.get_size_and_offset(field_);
+			if (payload_size_ != 0) { size = payload_size_; }
+			return { size, offset };
 		}
 
 		static YCSBTransactionComponent get_read_ope(Key key, Field field) {
@@ -100,6 +104,10 @@ namespace workload {
 
 		YCSBTransaction(Component &&ope, InsertGenerator *generator_ptr): ope_(std::forward<Component>(ope)), generator_ptr_(generator_ptr) {}
 
+	public:
+		//! @brief Write only the leading bytes of payload, for variable-length tuples.
+		void set_payload_size(uint32_t payload_size) { ope_.payload_size_ = payload_size; }
+
 	public:
 		bool is_only_read_impl() const { return ope_.type_ == TransactionType::Read || ope_.type_ == TransactionType::Scan; }
 